@@ -1,900 +1,10423 @@
-/**
- * @file YAMS.c
- * @author LAMBERT Chloé
- * @brief Ce programme permet de jouer une partie de YAMS à deux
- * @version 0.1
- * @date 2021-11-28
- * 
- * @copyright Copyright (c) 2021
- *
- * Ce programme permet de jouer une partie de YAMS. Le principe est simple,
- * les joueurs disposent de 5 dés qu'ils vont lancer pour réaliser différentes combinaisons
- * qui correspondent chacune à un score.
- * A chaque tour, les joueurs lancent lancent les dés, ils ont le droit de relancer jusqu'à
- * 3 fois, un ou tous les dés et choisir une combinaisons à valider et marquer le score associé à cette combinaison
- * dans une feuille de score. Si aucune combinaison n'est disponible, le joueur a quand même l'obligation de choisir
- * une combinaison à barer, même si ça ne lui apporte aucun points
- * La fin du jeu s'arrête lorsque toutes les combinaisons de la grilles ont été validées.
- * Celui qui à le plus de points remporte la partie.
- * 
- */
-#include <stdlib.h>
-#include <stdio.h>
-#include <stdbool.h>
-#include <string.h>
-#include <time.h>
-
-/**
- * @brief Raccourci associé au nombre de dés présents dans le jeu
- * 
- */
-#define NOMBRE_DES 5
-
-/**
- * @brief Raccourci associé aux nombre de joueurs pour une partie
- * 
- */
-#define NOMBRE_JOUEURS 2
-
-/**
- * @brief Représente les dés que le joueur va lancer
- * 
- */
-typedef int t_des[NOMBRE_DES];
-
-/**
- * @brief Représente le tableau de score
- * 
- * Ce tableau va permettre le stockage des scores marqués par les joueurs, à savoir les 13 combinaisons possibles
- * 
- */
-typedef int t_score[13];
-
-/**
- * @brief Représente les 13 combinaisons possibles du jeu
- * 
- * Ce tableau permet de stocker les 13 combinaisons jouables associées à leur noms
- * 
- */
-const char NOMS_COMBINAISONS[13][13] = {
-    "Total de 1", "Total de 2", "Total de 3", 
-    "Total de 4", "Total de 5", "Total de 6", 
-    "Brelan", "Carré", "Full House", 
-    "Petite suite", "Grande suite", "Yams", 
-    "Chance"
-};
-
-/*********************************
- *    FONCTIONS ET PROcÉDURES    *
- *********************************/
-
-/**
- * @fn void compter_des(t_des des, int occurences[6])
- * 
- * @brief Cette procédure va compter les occurences des faces des dés pour déterminer les combinaisons
- * 
- * @param des Les 5 dés lancés par le joueur
- * @param occurences Les 6 faces des dés
- * 
- * Consiste à compter les occurences des faces des dés de chaques lancer pour déterminer quelles combinaisons ont été réalisées
- */
-void compter_des(t_des des, int occurences[6]) {
-    for (int i = 0; i < 6; i++) {
-        occurences[i] = 0;
-    }
-
-    for (int i = 0; i < NOMBRE_DES; i++) {
-        occurences[des[i] -1] = occurences[des[i] - 1] + 1;
-    }
-}
-
-/**
- * @fn void trier_des(t_des des, t_des resultat)
- * 
- * @brief Cette procédure trie les dés
- * 
- * @param des Les 5 dés lancés par le joueur
- * @param resultat Le résultat, les dés triés
- * 
- * 
- */
-void trier_des(t_des des, t_des resultat) {
-    int temp;
-
-    for(int i = 0; i < NOMBRE_DES; i++) {
-        resultat[i] = des[i];
-    }
-
-    for (int i = 0; i < NOMBRE_DES; i++) {
-        for (int j = 1; j < NOMBRE_DES; j++) {
-            if (resultat[j - 1] > resultat[j]) {
-                temp = resultat[j - 1];
-                resultat[j - 1] = resultat[j];
-                resultat[j] = temp;
-            }
-        }
-    }
-}
-
-/**
- * @fn bool full_house(t_des des)
- * 
- * @brief Cette fonction détermine si la combinaison effectuée par le joueur est un Full House
- * 
- * @param des Les 5 dés lancés par le joueur
- * @return true si la combinaison est un Full House
- * @return false dans les autres cas
- * 
- * Consiste à déterminer si la combinaison réalisée après le lancer du joueur est un Full House
- * C'est à dire une Paire + un Brelan
- */
-bool full_house(t_des des) {
-    bool pair;
-    bool brelan;
-    int occurences[6];
-
-    pair = false;
-    brelan = false;
-
-    compter_des(des, occurences);
-    for (int i = 0; i < 6; i++) {
-
-        if (occurences[i] == 3) {
-            brelan = true;
-        }
-        else if (occurences[i] == 2) {
-            pair = true;
-        }
-    }
-
-    return pair && brelan;
-}
-
-/**
- * @fn bool brelan(t_des des)
- * 
- * @brief Cette fonction détermine si la combinaison effectuée par le joueur est un Brelan
- * 
- * @param des Les 5 dés lancés par le joueur
- * @return true si la combinaison est un Brelan
- * @return false dans les autres cas
- * 
- * Consiste à déterminer si la combinaison réalisée après le lancer du joueur est un Brelan
- * C'est à dire 3 dés identiques
- */
-bool brelan(t_des des) {
-    bool resultat;
-    int occurences[6];
-
-    resultat = false;
-
-    compter_des(des, occurences);
-    for (int i = 0; i < 6; i++) {
-        if (occurences[i] >= 3) {
-            resultat = true;
-        }
-    }
-
-    return resultat;
-}
-
-/**
- * @fn bool carre(t_des des)
- * 
- * @brief Cette fonction détermine si la combinaison effectuée par le joueur est un Carré
- * 
- * @param des Les 5 dés lancés par le joueur
- * @return true si la combinaison est un Carré
- * @return false dans les autres cas
- * 
- * Consiste à déterminer si la combinaison réalisée après le lancer du joueur est un Carré
- * C'est à dire 4 dés identiques
- */
-bool carre(t_des des) {
-    bool resultat;
-    int occurences[6];
-
-    resultat = false;
-
-    compter_des(des, occurences);
-    for (int i = 0; i < 6; i++) {
-        if (occurences[i] >= 4) {
-            resultat = true;
-        }
-    }
-
-    return resultat;
-}
-
-/**
- * @fn bool petite_suite(t_des des)
- * 
- * @brief Cette fonction détermine si la combinaison effectuée par le joueur est une Petite Suite
- * 
- * @param des Les 5 dés lancés par le joueur
- * @return true si la combinaison est une Petite Suite
- * @return false dans les autres cas
- * 
- * Consiste à déterminer si la combinaison réalisée après le lancer du joueur est une Petite Suite
- * C'est à dire 4 dés dont la valeur se suit
- */
-bool petite_suite(t_des des) {
-    bool resultat;
-    int occurences[6];
-
-    compter_des(des, occurences);
-
-    for (int i = 0; i < 3; i++) {
-        resultat = true;
-        for (int j = i; j < i + 4; j++) {
-            if (occurences[j] == 0) {
-                resultat = false;
-            }
-        }
-
-        if (resultat) {
-            break;
-        }
-    }
-
-    return resultat;
-}
-
-/**
- * @fn bool grande_suite(t_des des)
- * 
- * @brief Cette fonction détermine si la combinaison effectuée par le joueur est une Grande Suite
- * 
- * @param des Les 5 dés lancés par le joueur
- * @return true si la combinaison est une Grande Suite
- * @return false dans les autres cas
- * 
- * Consiste à déterminer si la combinaison réalisée après le lancer du joueur est une Grande Suite
- * C'est à dire 5 dés dont la valeur se suit
- */
-bool grande_suite(t_des des) {
-    bool resultat;
-    t_des des_tries;
-
-    trier_des(des, des_tries);
-    resultat = true;
-
-    for (int j = 0; j < NOMBRE_DES -1; j++) {
-        if (des_tries[j] != des_tries[j + 1] -1) {
-            resultat = false;
-        }
-    }
-
-    return resultat;
-}
-
-/**
- * @fn bool yams(t_des des)
- * 
- * @brief Cette fonction détermine si la combinaison effectuée par le joueur est un Yams
- * 
- * @param des Les 5 dés lancés par le joueur
- * @return true si la combinaison est un Yams
- * @return false dans les autres cas
- * 
- * Consiste à déterminer si la combinaison réalisée après le lancer du joueur est un Yams
- * C'est à dire 5 dés de la même valeur
- */
-bool yams(t_des des) {
-    bool resultat;
-    int occurences[6];
-
-    resultat = false;
-
-    compter_des(des, occurences);
-    for (int i = 0; i < 6; i++) {
-        if (occurences[i] == 5) {
-            resultat = true;
-        }
-    }
-
-    return resultat;
-}
-
-/**
- * @fn int entrer_combinaison(t_score scores)
- * 
- * @brief Cette fonction permet d'entrer la combinaison que le joueur a réalisé
- * 
- * @param scores La feuille de score qui contient les 13 combinaisons possibles
- * @return int l'indice de la combinaison dans le tableau des scores
- * 
- * Consiste à entrer le nom de combinaison que le joueur à rélisé et qu'il souhaite valider
- */
-int entrer_combinaison(t_score scores) {
-    char entree[13];
-    int indice;
-
-    indice = -1;
-
-    printf("Entrez le nom de la combinaison que vous souhaitez valider / barrer : \n");
-    scanf(" %[^\n]s", entree);
-
-    while (indice == -1) {
-        for (int i = 0; i < 13; i++) {
-            if (strcmp(entree, NOMS_COMBINAISONS[i]) == 0) {
-                indice = i;
-            }
-        }
-
-        if (indice == -1) {
-            printf("Saisie invalide, recommencez\n");
-            scanf(" %[^\n]s", entree);
-        }
-        else if (scores[indice] != -1) {
-            printf("Cette combinaison est déjà validée / barrée, recommencez\n");
-            indice = -1;
-            scanf(" %[^\n]s", entree);
-        }
-    }
-
-    return indice;
-}
-
-/**
- * @fn int compter_points(int combinaison, t_des des)
- * 
- * @brief Cette fonction sert à compter les points que le joueur à fait avec son lancer
- * 
- * @param combinaison Le numéro, ou indice de la combinaison dans le tableau
- * @param des Les 5 dés lancés par le joueur
- * @return int le score obtenu
- * 
- * Consiste à compter les points marqués par le joueur avec son lance en fonction des combinaisons réalisées s'il y en a 
- * ou sinon par les points indiqués sur les dés
- */
-int compter_points(int combinaison, t_des des) {
-    int occurences[6];
-    int resultat;
-
-    compter_des(des, occurences);
-    resultat = 0;
-
-    switch (combinaison) {
-    case 0 :
-    case 1 :
-    case 2 :
-    case 3 :
-    case 4 :
-    case 5 :
-        resultat = occurences[combinaison] * (combinaison + 1);
-        break;
-
-    case 6 :
-        if (brelan(des)) {
-            for (int i = 0; i < NOMBRE_DES; i++) {
-                if(occurences[des[i] - 1] >= 3) {
-                    resultat = resultat + des[i];
-                }
-            }
-        }
-        break;
-
-    case 7 :
-        if (carre(des)) {
-            for (int i = 0; i < NOMBRE_DES; i++) {
-                if(occurences[des[i] - 1] >= 4) {
-                    resultat = resultat + des[i];
-                }
-            }
-        }
-        
-        break;
-
-    case 8 :
-        if (full_house(des)) {
-            resultat = 25;
-        }
-        break;
-    
-    case 9 :
-        if (petite_suite(des)) {
-            resultat = 30;
-        }
-        break;
-
-    case 10 :
-        if (grande_suite(des)) {
-            resultat = 40;
-        }
-        break;
-
-    case 11 :
-        if (yams(des)) {
-            resultat = 50;
-        }
-        break;
-
-    case 12 :
-        for (int i = 0; i < NOMBRE_DES; i++) {
-            resultat = resultat + des[i];
-        }
-        break;
-
-    default:
-        break;
-    }
-
-    printf("points: %d\n", resultat);
-    return resultat;
-}
-
-/**
- * @fn int trouver_vainqueurs(t_score scores[NOMBRE_JOUEURS])
- * 
- * @brief Cette fonction détermine quel joueur a remporté la partie
- * 
- * @param scores La feuille de score
- * @return int l'indice du vainqueur, si c'est le joueur 1 ou 2
- * 
- * Consiste à dire lequel des deux joueurs à gagner la partie, celui qui à le score le plus élevé
- */
-int trouver_vainqueurs(t_score scores[NOMBRE_JOUEURS]) {
-    int indice_vainqueurs;
-    int total_max;
-    int total_temp;
-
-    indice_vainqueurs = -1;
-
-    for(int i = 0; i < NOMBRE_JOUEURS; i++) {
-        total_temp = 0;
-        for (int j = 0; j < 13; j++) {
-            total_temp = total_temp + scores[i][j];
-        }
-        if (total_temp > total_max || indice_vainqueurs == -1) {
-            indice_vainqueurs = i;
-            total_max = total_temp;
-        }
-    }
-
-    return indice_vainqueurs;
-}
-
-/**
- * @fn void entrer_points(t_score scores, int combinaison, int points)
- * 
- * @brief Cette procédure sert à entrer les points marqués dans la feuille de score
- * 
- * @param scores La feuille de score
- * @param combinaison L'indice de la combinaison dans le tableau
- * @param points Points marqués par le joueur
- * 
- * Consiste à entrer le score marqué par le joueur dans le tableau/feuille de score
- */
-void entrer_points(t_score scores, int combinaison, int points) {
-    scores[combinaison] = points;
-}
-
-/**
- * @fn void combinaisons_possibles(t_des des, int combinaisons[13], int *nombre_combinaisons)
- * 
- * @brief Cette procédure détermine quelles combinaisons sont possibles à marquer par le joueur en fonction de son lancer
- * 
- * @param des Les 5 dés lancés par le joueur
- * @param combinaisons Les 13 combinaisons possibles
- * @param nombre_combinaisons Le nombre de combinaisons possibles
- * 
- * Consiste à déterminer quelles combinaisons sont possibles à valider par le joueur, 
- * en effet le résultat d'un lancer peut correspondre à plusieurs combinaisons, ce sont ces 
- * combinaisons qui seront indiquées
- */
-void combinaisons_possibles(t_des des, int combinaisons[13], int *nombre_combinaisons) {
-    int occurences[6];
-
-    *nombre_combinaisons = 0;
-    combinaisons[*nombre_combinaisons] = 12;
-    *nombre_combinaisons = 1;
-
-    if(brelan(des)) {
-        combinaisons[*nombre_combinaisons] = 6;
-        *nombre_combinaisons = *nombre_combinaisons +1;
-    }
-
-    if (carre(des)) {
-        combinaisons[*nombre_combinaisons] = 7;
-        *nombre_combinaisons = *nombre_combinaisons + 1;
-    }
-
-    if (full_house(des)) {
-        combinaisons[*nombre_combinaisons] = 8;
-        *nombre_combinaisons = *nombre_combinaisons + 1;
-    }
-
-    if (petite_suite(des)) {
-        combinaisons[*nombre_combinaisons] = 9;
-        *nombre_combinaisons = *nombre_combinaisons + 1;
-    }
-
-    if (grande_suite(des)) {
-        combinaisons[*nombre_combinaisons] = 10;
-        *nombre_combinaisons = *nombre_combinaisons + 1;
-    }
-
-    if (yams(des)) {
-        combinaisons[*nombre_combinaisons] = 11;
-        *nombre_combinaisons = *nombre_combinaisons + 1;
-    }
-
-    compter_des(des, occurences);
-
-    for(int i = 0; i < 6; i++) {
-        if(occurences[i] >= 1) {
-            combinaisons[*nombre_combinaisons] = i;
-            *nombre_combinaisons = *nombre_combinaisons + 1;
-        }
-    }
-}
-
-/**
- * @fn void combinaisons_disponibles(t_des des, t_score scores)
- * 
- * @brief Cette procédure permet de déterminer quelles sont les combinaisons disponibles dans la grille
- * 
- * @param des Les dés lancés par le joueur
- * @param scores La feuille de score
- * 
- * Consiste à vérifier quelles sont les combinaisons disponibles dans la grille, celles que le joueur n'a pas encore validées
- * Par exemple, si le joueur réalise un score de 3 mais qu'il a déjà validé la case, alors celle-ci n'apparaîtra pas
- */
-void combinaisons_disponibles(t_des des, t_score scores) {
-    int combinaisons_effectuees[13];
-    int nombre_combinaisons_effectuees;
-    int combinaisons_dispos[13]; 
-    int nombre_combinaisons_dispos;
-
-    nombre_combinaisons_dispos = 0;
-
-    combinaisons_possibles(des, combinaisons_effectuees, &nombre_combinaisons_effectuees);
-
-    for(int i = 0; i < nombre_combinaisons_effectuees; i++) {
-        for(int j = 0; j < 13; j++) {
-            if (combinaisons_effectuees[i] == j) {
-                if (scores[j] == -1) {
-                    combinaisons_dispos[nombre_combinaisons_dispos] = j;
-                    nombre_combinaisons_dispos = nombre_combinaisons_dispos +1;
-                }
-            }
-        }
-    }
-
-    printf("Les combinaisons disponibles sont les suivantes :\n");
-    for(int i = 0; i < nombre_combinaisons_dispos; i++ ) {
-        printf(" - %s\n", NOMS_COMBINAISONS[combinaisons_dispos[i]]);
-    }
-    printf("Les combinaisons qui ne sont pas encore validées sont les suivantes :\n");
-    for (int i = 0; i < 13; i++) {
-        if (scores[i] == -1) {
-            printf(" - %s\n", NOMS_COMBINAISONS[i]);
-        }
-    }
-}
-
-/**
- * @fn void entrer_chaine(char message[50], char reponse[20])
- * 
- * @brief Cette procédure sert à écrire un message à l'écran auquel le joueur pourra répondre, ici elle servira à saisir
- * le nom du joueur
- * 
- * @param message Correspond au message qui sera affiché à l'écran, un message qui demandera le nom du joueur
- * @param reponse Sera la réponse saisie au clavier, elle correspond au nom du joueur
- * 
- * Connsiste à saisir les noms des deux joueurs au début de la partie
- */
-void entrer_chaine(char *message, char *reponse) {
-    printf("%s", message);
-    scanf(" %[^\n]", reponse);
-}
-
-/**
- * @fn void entrer_booleen(char message[50], bool *reponse)
- * 
- * @brief Cette procédure servira à demander au joueur s'il veut relancer les dés, il devra répondre soit "oui" soit "non"
- * 
- * @param message Correspond au message affiché à l'écran, si le joueur veut relancer ou non
- * @param reponse Correspond à la réponse saisie par le joueur, elle devra soit être "oui" soit "non"
- * 
- * Consiste à saisir une réponse qui sera vraie (oui) ou fausse (non) pour savoir si le joueur souhaite relancer un ou 
- * plusieurs dés
- */
-void entrer_booleen(char *message, bool *reponse) {
-    char entree[20];
-
-    do {
-        printf("%s", message);
-        scanf(" %s", entree);
-    }
-    while (strcmp (entree, "oui") != 0 && strcmp(entree, "non") != 0);
-    
-    if (strcmp(entree, "oui") == 0) {
-        *reponse = true;
-    }
-    else {
-        *reponse = false;
-    }
-}
-
-/**
- * @fn void entrer_suite(char message[50], t_des reponse)
- * 
- * @brief Cette procédure sert à demander au joueur quels dés sont à relancer dans le cas ou il aurait répondu "oui"
- * 
- * @param message Le message affiché avant la saisie, qui demandera quels dés sont à relancer
- * @param reponse La réponse, qui correspond au numéro, ou indice, du ou des dés que le joueur souhaite relancer
- * 
- * Consiste à saisir au clavier le ou les dés que le joueur souhaite relancer s'il veut relancer
- */
-void entrer_suite(char *message, t_des reponse) {
-    int entree;
-    int compteur;
-
-    compteur = 0;
-
-    do {
-        printf("%s", message);
-        scanf("%d", &entree);
-
-        if (entree > 0 && entree <= NOMBRE_DES) {
-            reponse[compteur] = entree - 1;
-            compteur = compteur +1;
-        }
-        else if (entree < 0 || entree > NOMBRE_DES) {
-            printf("Entrée invalide, recommencez\n");
-        }
-    }
-    while (entree != 0 && compteur < NOMBRE_DES);
-
-    for (int i = compteur; i < NOMBRE_DES; i++) {
-        reponse[i] = -1;
-    }
-}
-
-/**
- * @fn void afficher_scores(t_score scores, char nom_joueur[20])
- * 
- * @brief Cette procédure sert à afficher les scores dans le tableau
- * 
- * @param scores La feuille de score
- * @param nom_joueur Correspond au nom du joueur dont c'est au tour de jouer, chaque joueur ayant sa feuille de score
- * 
- * Consiste à afficher les scores du joueur dans les cases correspondantes du tableau de la feuille de score
- */
-void afficher_scores(t_score scores, char nom_joueur[20]) {
-    int total_sup;
-    int bonus;
-    int total_inf;
-    t_score affiche;
-
-    total_sup = 0;
-    bonus = 0;
-    total_inf = 0;
-
-    for (int i = 0; i < 6; i++) {
-        if (scores[i] != -1) {
-            total_sup = total_sup + scores[i];
-            affiche[i] = scores[i];
-        }
-        else {
-            affiche[i] = 0;
-        }
-    }
-
-    if (total_sup > 62) {
-        bonus = 35;
-    }
-
-    for (int i = 6; i < 13; i++) {
-        if (scores[i] != -1) {
-            total_inf = total_inf+ scores[i];
-            affiche[i] = scores[i];
-        }
-        else {
-            affiche[i] = 0;
-        }
-    }
-
-    printf("           ┏━━━━┓            ┏━━━━┓\n"
-           "           ┃%c%c%c%c┃            ┃%c%c%c%c┃\n"
-           "┏━━━━━━━━━━╋━━━━┫ ┏━━━━━━━━━━╋━━━━┫\n"
-           "┃Total de 1┃%3d ┃ ┃Brelan    ┃%3d ┃\n"
-           "┣━━━━━━━━━━╋━━━━┫ ┣━━━━━━━━━━╋━━━━┫\n"
-           "┃Total de 2┃%3d ┃ ┃Carré     ┃%3d ┃\n"
-           "┣━━━━━━━━━━╋━━━━┫ ┣━━━━━━━━━━╋━━━━┫\n"
-           "┃Total de 3┃%3d ┃ ┃Full House┃%3d ┃\n"
-           "┣━━━━━━━━━━╋━━━━┫ ┣━━━━━━━━━━╋━━━━┫\n"
-           "┃Total de 4┃%3d ┃ ┃Pte suite ┃%3d ┃\n"
-           "┣━━━━━━━━━━╋━━━━┫ ┣━━━━━━━━━━╋━━━━┫\n"
-           "┃Total de 5┃%3d ┃ ┃Gde suite ┃%3d ┃\n"
-           "┣━━━━━━━━━━╋━━━━┫ ┣━━━━━━━━━━╋━━━━┫\n"
-           "┃Total de 6┃%3d ┃ ┃Yams      ┃%3d ┃\n"
-           "┣━━━━━━━━━━╋━━━━┫ ┣━━━━━━━━━━╋━━━━┫\n"
-           "┃Bonus > 62┃%3d ┃ ┃Chance    ┃%3d ┃\n" 
-           "┣━━━━━━━━━━╋━━━━┫ ┣━━━━━━━━━━╋━━━━┫\n"
-           "┃Total sup ┃%3d ┃ ┃Total inf ┃%3d ┃\n"
-           "┗━━━━━━━━━━┻━━━━┛ ┗━━━━━━━━━━┻━━━━┛\n" 
-           "┏━━━━━━━━━━┳━━━━┓\n"
-           "┃Total     ┃%3d ┃\n"
-           "┗━━━━━━━━━━┻━━━━┛\n", 
-           nom_joueur[0], nom_joueur[1], nom_joueur[2], nom_joueur[3], nom_joueur[0], nom_joueur[1], nom_joueur[2], nom_joueur[3],
-           affiche[0], affiche[6],
-           affiche[1], affiche[7],
-           affiche[2], affiche[8],
-           affiche[3], affiche[9],
-           affiche[4], affiche[10],
-           affiche[5], affiche[11],
-           bonus, affiche[12],
-           total_sup, total_inf, 
-           total_sup + bonus + total_inf
-        );
-}
-
-/**
- * @fn void lancer_des(int nombre, t_des des)
- * 
- * @brief Cette procédure sert à lancer les dés
- * 
- * @param nombre Le nombre de dés qui est à lancer, il peut être de 5 ou moins si le joueur décide de relancer certains dés
- * @param des Les 5 dés à lancer
- * 
- * Consiste à lancer les dés d'un joueur
- */
-void lancer_des(int nombre, t_des des) {
-    for (int i = 0; i < NOMBRE_DES; i++) {
-        des[i] = -1;
-    }
-    for (int i = 0; i < nombre; i++) {
-        des[i] = rand() % 6 + 1;
-    }
-}
-
-/**
- * @fn void afficher_des(t_des des)
- * 
- * @brief Cette procédure sert à afficher les dés lancés
- * 
- * @param des Les 5 dés lancés
- * 
- * Consiste à afficher la valeur des dés du joueur après un lancer
- */
-void afficher_des(t_des des) {
-    for (int i = 0; i < NOMBRE_DES; i++) {
-        switch (des[i]) {
-        case 1 :
-            printf("┏━━━━━━━┓\n"
-                   "┃       ┃\n"
-                   "┃   ●   ┃\n"
-                   "┃       ┃\n"
-                   "┗━━━━━━━┛\n");
-            break;
-        
-        case 2 :
-            printf("┏━━━━━━━┓\n"
-                   "┃     ● ┃\n"
-                   "┃       ┃\n"
-                   "┃ ●     ┃\n"
-                   "┗━━━━━━━┛\n");
-            break;
-
-        case 3 :
-            printf("┏━━━━━━━┓\n"
-                   "┃     ● ┃\n"
-                   "┃   ●   ┃\n"
-                   "┃ ●     ┃\n"
-                   "┗━━━━━━━┛\n");
-            break;
-
-        case 4 :
-            printf("┏━━━━━━━┓\n"
-                   "┃ ●   ● ┃\n"
-                   "┃       ┃\n"
-                   "┃ ●   ● ┃\n"
-                   "┗━━━━━━━┛\n");
-            break;
-
-        case 5 :
-            printf("┏━━━━━━━┓\n"
-                   "┃ ●   ● ┃\n"
-                   "┃   ●   ┃\n"
-                   "┃ ●   ● ┃\n"
-                   "┗━━━━━━━┛\n");
-            break;
-
-        case 6 :
-            printf("┏━━━━━━━┓\n"
-                   "┃ ●   ● ┃\n"
-                   "┃ ●   ● ┃\n"
-                   "┃ ●   ● ┃\n"
-                   "┗━━━━━━━┛\n");
-            break;
-        
-        default:
-            printf("? ");
-            break;
-        }
-        //printf("[%d] ",des[i]);
-    }
-    printf("\n");
-    
-}
-
-/*********************************
- *      PROGRAMME PRINCIPAL      *
- *********************************/
-
-int main() {
-    t_score scores[NOMBRE_JOUEURS];
-    t_des des;
-    char joueurs[NOMBRE_JOUEURS][50];
-    int compteur_essais;
-    int combinaison;
-    bool validation_lancer;
-
-    srand(time(NULL));
-
-    for (int i = 0; i < NOMBRE_JOUEURS; i++) {
-        for (int j = 0; j < 13; j++) {
-            scores[i][j] = -1;
-        }
-    }
-
-    entrer_chaine("Entrez le nom du premier joueur\n", joueurs[0]);
-    entrer_chaine("Entrez le nom du deuxième joueur\n", joueurs[1]);
-
-    for(int tour = 0; tour < 13; tour++) {
-        for (int i = 0; i < NOMBRE_JOUEURS; i++) {
-            afficher_scores(scores[i], joueurs[i]);
-            lancer_des(NOMBRE_DES,des);
-            afficher_des(des);
-
-            compteur_essais = 3;
-
-            do {
-                entrer_booleen("Voulez vous relancer les dés ?\n", &validation_lancer);
-
-                if (validation_lancer) {
-                    t_des des_a_relancer;
-                    t_des des_relances;
-                    int compteur;
-
-                    compteur = 0;
-
-                    entrer_suite("Entrez le numéro du dé à relancer (de 1 à 5, bornes incluses, ou 0 pour arrêter)\n", des_a_relancer);
-
-                    for (int j = 0; j < 5; j++){
-                        if (des_a_relancer[j] != -1) {
-                            compteur = compteur + 1;
-                        }
-                    }
-
-                    lancer_des(compteur, des_relances);
-
-                    for (int j = 0; j < 5; j++){
-                        if (des_relances[j] != -1) {
-                            des[des_a_relancer[j]] = des_relances[j];
-                        }
-                    }
-
-                    compteur_essais = compteur_essais -1;
-                    printf("Voici les résultats du lancer de dés :\n");
-                    afficher_des(des);
-                }
-                
-            }
-            while ((compteur_essais > 0) && (validation_lancer == true));
-
-            combinaisons_disponibles(des, scores[i]);
-            combinaison = entrer_combinaison(scores[i]);
-            entrer_points(scores[i], combinaison, compter_points(combinaison, des));
-
-            afficher_scores(scores[i], joueurs[i]);
-        }
-    }
-
-    printf("\nLe gagnant est : %s ! Félicitations\n", joueurs[trouver_vainqueurs(scores)]);
-
-    return EXIT_SUCCESS;
-}
\ No newline at end of file
+/**
+ * @file YAMS.c
+ * @author LAMBERT Chloé
+ * @brief Ce programme permet de jouer une partie de YAMS à deux
+ * @version 0.1
+ * @date 2021-11-28
+ * 
+ * @copyright Copyright (c) 2021
+ *
+ * Ce programme permet de jouer une partie de YAMS. Le principe est simple,
+ * les joueurs disposent de 5 dés qu'ils vont lancer pour réaliser différentes combinaisons
+ * qui correspondent chacune à un score.
+ * A chaque tour, les joueurs lancent lancent les dés, ils ont le droit de relancer jusqu'à
+ * 3 fois, un ou tous les dés et choisir une combinaisons à valider et marquer le score associé à cette combinaison
+ * dans une feuille de score. Si aucune combinaison n'est disponible, le joueur a quand même l'obligation de choisir
+ * une combinaison à barer, même si ça ne lui apporte aucun points
+ * La fin du jeu s'arrête lorsque toutes les combinaisons de la grilles ont été validées.
+ * Celui qui à le plus de points remporte la partie.
+ * 
+ * Les règles du jeu sont dans la bibliothèque yams_regles, ce fichier contient l'interface au terminal,
+ * les outils de simulation et d'analyse et le programme principal.
+ * 
+ * Compilation : gcc -O2 -pthread YAMS.c yams_regles.c -o YAMS -lm -ldl
+ * 
+ */
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <dlfcn.h>
+#include <errno.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/prctl.h>
+#include <sys/wait.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/epoll.h>
+#include <math.h>
+
+#include "yams_regles.h"
+#include "yams_strategie.h"
+
+/**
+ * @brief Représente une stratégie de jeu automatique
+ * 
+ * Une stratégie regroupe les fonctions de décision appelées par le moteur de simulation à la place des saisies
+ * au clavier : le choix des dés à relancer (un masque dont le bit i désigne le dé i, 0 pour garder tous les dés)
+ * et le choix de la combinaison à valider / barrer. Le contexte est transmis tel quel à chaque appel.
+ * 
+ * Une stratégie dont le contexte est modifié par ses décisions fournit creer_contexte, qui crée à partir du
+ * contexte partagé un contexte propre à chaque thread, et detruire_contexte qui le libère (voir instancier_strategie).
+ * creer_contexte renvoie NULL quand la mémoire manque. Sans creer_contexte, le contexte est partagé tel quel et ne
+ * doit pas être modifié.
+ * 
+ * Une stratégie peut aussi fournir des décisions par lots, qui prennent les décisions de plusieurs parties
+ * indépendantes en un appel (voir t_module_strategie) ; simuler_parties joue alors ses parties en parallèle pas à
+ * pas pour les lui présenter ensemble. Elles valent NULL sinon.
+ * 
+ */
+typedef struct {
+    const char *nom;
+    int (*choisir_relance)(t_des des, t_score scores, int relances_restantes, void *contexte);
+    int (*choisir_combinaison)(t_des des, t_score scores, void *contexte);
+    void *contexte;
+    void *(*creer_contexte)(void *contexte);
+    void (*detruire_contexte)(void *contexte);
+    void (*choisir_relances)(const t_vue_partie *vues, int32_t *masques, size_t nombre, void *contexte);
+    void (*choisir_combinaisons)(const t_vue_partie *vues, int32_t *combinaisons, size_t nombre, void *contexte);
+} t_strategie;
+
+/**
+ * @brief Raccourci associé au nombre maximal de stratégies enregistrées
+ * 
+ */
+#define NOMBRE_STRATEGIES_MAX 16
+
+/**
+ * @brief Raccourci associé au plus grand total d'une partie, 375 au jeu classique : 105 points et 35 de bonus en
+ * haut, 235 en bas
+ * 
+ */
+#define SCORE_MAXIMAL (21 * NOMBRE_DES + 35 + 3 * NOMBRE_DES * NOMBRE_FACES + POINTS_FULL + POINTS_PETITE_SUITE \
+                       + POINTS_GRANDE_SUITE + POINTS_YAMS)
+
+/**
+ * @brief Raccourcis associés aux dés désignés un par un et à leur nombre dans les messages d'utilisation, pour
+ * que ceux-ci suivent NOMBRE_DES
+ * 
+ */
+#if NOMBRE_DES == 5
+#define TEXTE_DES "d1 d2 d3 d4 d5"
+#define TEXTE_NOMBRE_DES "5"
+#elif NOMBRE_DES == 6
+#define TEXTE_DES "d1 d2 d3 d4 d5 d6"
+#define TEXTE_NOMBRE_DES "6"
+#else
+#define TEXTE_DES "d1 d2 d3 d4 d5 d6 d7"
+#define TEXTE_NOMBRE_DES "7"
+#endif
+
+/**
+ * @brief Représente les résultats agrégés d'une série de parties simulées
+ * 
+ * En plus des totaux, la série garde l'histogramme des totaux, d'où se déduisent les centiles, ainsi que les
+ * points marqués dans chaque combinaison et le nombre de parties où elle n'a pas été barrée.
+ * 
+ */
+typedef struct {
+    long nombre_parties;
+    long long somme_scores;
+    long long somme_carres;
+    int score_min;
+    int score_max;
+    long nombre_bonus;
+    long nombre_yams;
+    long long points[13];
+    long reussites[13];
+    long histogramme[SCORE_MAXIMAL + 1];
+} t_resultats;
+
+/**
+ * @brief Raccourci associé au nombre d'états d'une feuille de score pour le solveur
+ * 
+ * Un état est formé du masque des 13 combinaisons remplies et du total de la partie supérieure plafonné à 63,
+ * seuil au-delà duquel le bonus est acquis
+ * 
+ */
+#define NOMBRE_ETATS (8192 * 64)
+
+/**
+ * @brief Donne l'indice d'un état de la feuille de score dans la table des espérances
+ * 
+ */
+#define INDICE_ETAT(masque, total_sup) (((masque) << 6) | (total_sup))
+
+/**
+ * @brief Représente les valeurs d'un tour de jeu, pour un état de la feuille de score
+ * 
+ * mains[r][m] est l'espérance des points restant à marquer dans la partie quand le joueur tient la main m et qu'il
+ * lui reste r relances. gardes[r][g] est l'espérance quand le joueur garde la garde g et relance les autres dés,
+ * avec r relances restantes avant ce lancer (gardes[0] n'est pas utilisé).
+ * 
+ */
+typedef struct {
+    double mains[NOMBRE_RELANCES + 1][NOMBRE_MAINS];
+    double gardes[NOMBRE_RELANCES + 1][NOMBRE_GARDES];
+} t_valeurs_tour;
+
+/**
+ * @brief Représente le contexte de la stratégie optimale
+ * 
+ * Les valeurs du tour sont calculées à la première décision d'un tour et réutilisées tant que l'état de la feuille
+ * ne change pas
+ * 
+ */
+typedef struct {
+    const double *esperances;
+    int etat;
+    t_valeurs_tour valeurs;
+} t_contexte_optimal;
+
+/**
+ * @brief Raccourci associé à la version du format des tables enregistrées
+ * 
+ */
+#define VERSION_TABLES 1
+
+/**
+ * @brief Raccourci associé à la variante des règles pour laquelle le programme est compilé, écrite dans les tables
+ * 
+ * Elle vaut 0 au jeu classique, ce qui garde lisibles les tables écrites avant les variantes. Sinon chaque octet
+ * reprend un paramètre des règles : une table ne se relit qu'avec les règles qui l'ont calculée.
+ * 
+ */
+#define VARIANTE_REGLES (VARIANTE_CLASSIQUE ? 0 : (uint64_t) NOMBRE_DES | (uint64_t) NOMBRE_FACES << 8            \
+                                                 | (uint64_t) POINTS_FULL << 16 | (uint64_t) POINTS_PETITE_SUITE << 24 \
+                                                 | (uint64_t) POINTS_GRANDE_SUITE << 32 | (uint64_t) POINTS_YAMS << 40)
+
+/**
+ * @brief Raccourci associé au type de table qui contient les espérances des états du solveur
+ * 
+ */
+#define TABLE_ESPERANCES 1
+
+/**
+ * @brief Raccourci associé au type de table qui contient, pour chaque état, la plus grande probabilité de marquer
+ * encore au moins chaque nombre de points
+ * 
+ */
+#define TABLE_SEUILS 2
+
+/**
+ * @brief Raccourci associé au type de table qui contient les probabilités de gain des finales à deux joueurs
+ * 
+ */
+#define TABLE_FINALES 3
+
+/**
+ * @brief Représente l'entête de 64 octets d'une table enregistrée, suivie directement des valeurs
+ * 
+ * Les champs sont écrits dans l'ordre des octets de la machine, le marqueur d'ordre permet de refuser une table
+ * écrite sur une machine d'un autre boutisme. La somme de contrôle de l'entête est vérifiée à chaque ouverture,
+ * celle des valeurs seulement à la demande pour que l'ouverture reste indépendante de la taille de la table.
+ * 
+ */
+typedef struct {
+    char magie[8];
+    uint32_t version;
+    uint32_t marqueur_ordre;
+    uint32_t type;
+    uint32_t taille_valeur;
+    uint64_t nombre_valeurs;
+    uint64_t somme_valeurs;
+    uint64_t variante;
+    uint8_t reserve[8];
+    uint64_t somme_entete;
+} t_entete_table;
+
+/**
+ * @brief Représente une table enregistrée projetée en mémoire en lecture seule
+ * 
+ */
+typedef struct {
+    const t_entete_table *entete;
+    const void *valeurs;
+    size_t taille;
+} t_table_projetee;
+
+/**
+ * @brief Représente un conseil de relance : les dés à relancer et le score final espéré en les relançant
+ * 
+ */
+typedef struct {
+    int masque_relance;
+    double esperance;
+} t_conseil;
+
+/**
+ * @brief Raccourci associé au nombre de parties simulées avec chaque flux du générateur
+ * 
+ * Les parties d'une simulation sont découpées en blocs consécutifs, le bloc b utilisant le flux obtenu après
+ * b sauts du générateur initial. Le résultat ne dépend donc que de la graine, quel que soit l'ordre dans lequel
+ * les blocs sont joués.
+ * 
+ */
+#define PARTIES_PAR_FLUX 4096
+
+/**
+ * @brief Raccourci associé au nombre de parties d'une tâche du tournoi
+ * 
+ */
+#define PARTIES_PAR_TACHE 256
+
+/**
+ * @brief Représente une tâche du tournoi : un paquet de parties d'une rencontre, avec son propre flux de dés
+ * 
+ */
+typedef struct {
+    int rencontre;
+    long nombre_parties;
+    t_generateur generateur;
+} t_tache;
+
+/**
+ * @brief Représente la file de tâches d'un thread du tournoi
+ * 
+ * Le thread propriétaire prend ses tâches à la fin de la file, les autres threads volent au début quand leur
+ * propre file est vide. Le verrou ne protège que cette file, il n'est presque jamais disputé.
+ * 
+ */
+typedef struct {
+    pthread_mutex_t verrou;
+    int *taches;
+    int debut;
+    int fin;
+} t_file_taches;
+
+/**
+ * @brief Représente le bilan d'une rencontre entre deux stratégies, du point de vue de la première
+ * 
+ */
+typedef struct {
+    int strategie_a;
+    int strategie_b;
+    long victoires;
+    long nuls;
+    long defaites;
+} t_rencontre;
+
+/**
+ * @brief Représente l'écran du terminal en mode plein écran
+ * 
+ * L'écran est une grille de cellules, chacune contenant les octets UTF-8 d'un caractère (jusqu'à 4, le premier
+ * dans l'octet de poids faible). L'image est composée dans cellules, puis rafraichir_ecran compare avec
+ * affichees, l'image présente sur le terminal, et n'envoie que les cellules modifiées, précédées d'un
+ * déplacement du curseur. Toute la sortie est assemblée dans tampon, alloué une fois pour le pire cas, et
+ * envoyée en un seul appel à write.
+ * 
+ */
+typedef struct {
+    int lignes;
+    int colonnes;
+    uint32_t *cellules;
+    uint32_t *affichees;
+    char *tampon;
+    size_t capacite;
+    bool complet;
+} t_ecran;
+
+/**
+ * @brief Représente le déroulement d'un tour, tel qu'il est écrit dans un journal de parties
+ * 
+ * lancers[0] est le code (code_lancer) du premier lancer, lancers[r] celui des dés après la relance r, qui a
+ * relancé les dés du masque masques[r - 1]
+ * 
+ */
+typedef struct {
+    int relances;
+    int combinaison;
+    int lancers[NOMBRE_RELANCES + 1];
+    int masques[NOMBRE_RELANCES];
+} t_tour_journal;
+
+/**
+ * @brief Raccourci associé à la version du format des journaux de parties
+ * 
+ * Une variante des règles a sa propre version, qui porte le nombre de dés et de faces : ses journaux ne sont relus
+ * que par un programme compilé pour les mêmes dés
+ * 
+ */
+#if NOMBRE_DES == 5 && NOMBRE_FACES == 6
+#define VERSION_JOURNAL 2
+#else
+#define VERSION_JOURNAL (2 | NOMBRE_DES << 16 | NOMBRE_FACES << 24)
+#endif
+
+/**
+ * @brief Calcule à la compilation le nombre de bits nécessaires pour écrire les entiers de 0 à n - 1, n allant
+ * jusqu'à 2 puissance 22
+ * 
+ */
+#define BITS_NECESSAIRES(n) \
+    (((n) > 1 << 0) + ((n) > 1 << 1) + ((n) > 1 << 2) + ((n) > 1 << 3) + ((n) > 1 << 4) + ((n) > 1 << 5)      \
+     + ((n) > 1 << 6) + ((n) > 1 << 7) + ((n) > 1 << 8) + ((n) > 1 << 9) + ((n) > 1 << 10) + ((n) > 1 << 11)  \
+     + ((n) > 1 << 12) + ((n) > 1 << 13) + ((n) > 1 << 14) + ((n) > 1 << 15) + ((n) > 1 << 16)              \
+     + ((n) > 1 << 17) + ((n) > 1 << 18) + ((n) > 1 << 19) + ((n) > 1 << 20) + ((n) > 1 << 21))
+
+/**
+ * @brief Raccourcis associés aux nombres de bits d'un lancer, d'un tour sans relance et d'une relance dans le
+ * journal, 13, 19 et 18 au jeu classique
+ * 
+ */
+#define BITS_LANCER_JOURNAL BITS_NECESSAIRES(NOMBRE_LANCERS)
+#define BITS_TOUR_JOURNAL (6 + BITS_LANCER_JOURNAL)
+#define BITS_RELANCE_JOURNAL (NOMBRE_DES + BITS_LANCER_JOURNAL)
+
+/**
+ * @brief Raccourci associé à la taille à partir de laquelle un bloc du journal est écrit
+ * 
+ */
+#define TAILLE_BLOC_JOURNAL 65536
+
+/**
+ * @brief Représente l'entête de 16 octets d'un journal de parties
+ * 
+ * Un journal est une suite de blocs qui suit cet entête. Chaque bloc commence par un t_entete_bloc, suivi de
+ * parties entières. Une partie est le nombre de joueurs en entier de taille variable (7 bits par octet), puis
+ * ses 13 tours par joueur dans l'ordre de jeu, écrits bit à bit et complétés jusqu'à l'octet :
+ * 2 bits pour le nombre de relances, 4 bits pour la combinaison, BITS_LANCER_JOURNAL bits pour le premier lancer,
+ * puis NOMBRE_DES bits pour le masque et BITS_LANCER_JOURNAL bits pour le lancer de chaque relance. Au jeu
+ * classique, un lancer tient en 13 bits et un tour sans relance en 19 bits.
+ * Les tours sont suivis du résultat annoncé de la partie, en entiers de taille variable : pour chaque joueur son
+ * total multiplié par 2 plus 1 s'il a eu le bonus, puis l'indice du vainqueur.
+ * 
+ */
+typedef struct {
+    char magie[8];
+    uint32_t version;
+    uint32_t marqueur_ordre;
+} t_entete_journal;
+
+/**
+ * @brief Représente l'entête d'un bloc du journal
+ * 
+ * La taille et la somme de contrôle couvrent les parties du bloc, ce qui permet de sauter un bloc ou de le
+ * vérifier sans décoder ses parties
+ * 
+ */
+typedef struct {
+    uint32_t taille;
+    uint32_t nombre_parties;
+    uint64_t somme;
+} t_entete_bloc;
+
+/**
+ * @brief Représente un journal de parties ouvert en écriture
+ * 
+ * Les parties sont écrites bit à bit dans le bloc en cours, qui est envoyé au fichier quand il dépasse
+ * TAILLE_BLOC_JOURNAL
+ * 
+ */
+typedef struct {
+    FILE *fichier;
+    uint8_t *tampon;
+    size_t longueur;
+    size_t capacite;
+    uint32_t nombre_parties;
+    uint64_t bits;
+    int nombre_bits;
+    uint64_t octets_ecrits;
+    bool erreur;
+} t_journal;
+
+/**
+ * @brief Représente le bilan de la relecture d'un journal, les points étant recalculés à partir des dés
+ * 
+ * Les écarts comptent les désaccords entre le journal et les règles : points d'un tour différents de ceux de
+ * compter_points, totaux, bonus ou vainqueur différents de ceux annoncés à la fin de la partie. etats, cases et
+ * totaux sont l'espace de travail de la relecture, prévu pour capacite joueurs.
+ * 
+ */
+typedef struct {
+    long nombre_parties;
+    long nombre_tours;
+    long nombre_relances;
+    long somme_totaux;
+    long nombre_totaux;
+    long nombre_erreurs;
+    long ecarts_points;
+    long ecarts_totaux;
+    long ecarts_bonus;
+    long ecarts_vainqueurs;
+    t_etat_joueur *etats;
+    int *cases;
+    int *totaux;
+    int capacite;
+} t_bilan_journal;
+
+/**
+ * @brief Représente une partie décodée d'un journal, avec le résultat annoncé par celui qui l'a écrite
+ * 
+ * Les tableaux sont agrandis au besoin par decoder_partie et réutilisés d'une partie à l'autre. incoherences
+ * compte les relances qui ont changé un dé gardé, remplacées dans tours par le lancer précédent.
+ * 
+ */
+typedef struct {
+    int nombre_joueurs;
+    int capacite;
+    t_tour_journal *tours;
+    int *totaux;
+    bool *bonus;
+    int vainqueur;
+    int incoherences;
+} t_partie_journal;
+
+/*********************************
+ *    FONCTIONS ET PROcÉDURES    *
+ *********************************/
+
+/**
+ * @brief Raccourci associé à la taille des lignes lues au clavier ou dans un script
+ * 
+ */
+#define TAILLE_LIGNE 256
+
+/**
+ * @brief La table de hachage parfait des noms des combinaisons
+ * 
+ * La case (premier octet + 3 * dernier octet + longueur) & 31 du nom d'une combinaison contient son indice, les
+ * autres cases valent -1. Les 13 noms de NOMS_COMBINAISONS tombent dans 13 cases différentes.
+ * 
+ */
+const int8_t HACHAGE_COMBINAISONS[32] = {
+     5, -1, 10, -1,  7, -1, -1, -1, -1, -1, -1,  9, -1, -1, -1, -1,
+    -1,  0,  6, -1,  1, -1, 11,  2, 12, -1,  3, -1, -1,  4, -1,  8
+};
+
+/**
+ * @fn int chercher_combinaison(const char *nom)
+ * 
+ * @brief Cette fonction trouve une combinaison à partir de son nom ou de son numéro
+ * 
+ * @param nom Le nom exact de la combinaison, ou son numéro de 1 à 13 dans l'ordre de la feuille
+ * @return int l'indice de la combinaison, -1 si le nom ne correspond à aucune combinaison
+ * 
+ * Le nom est cherché avec la table de hachage parfait : une seule comparaison de chaînes au lieu de 13
+ */
+int chercher_combinaison(const char *nom) {
+    const unsigned char *octets;
+    size_t longueur;
+    char *fin;
+    long numero;
+    int indice;
+
+    numero = strtol(nom, &fin, 10);
+    if (fin != nom && *fin == '\0') {
+        return numero >= 1 && numero <= 13 ? (int) numero - 1 : -1;
+    }
+
+    longueur = strlen(nom);
+    if (longueur == 0) {
+        return -1;
+    }
+    octets = (const unsigned char *) nom;
+    indice = HACHAGE_COMBINAISONS[(octets[0] + 3 * octets[longueur - 1] + longueur) & 31];
+    if (indice == -1 || strcmp(nom, NOMS_COMBINAISONS[indice]) != 0) {
+        return -1;
+    }
+
+    return indice;
+}
+
+/**
+ * @fn bool lire_ligne(FILE *flux, char *ligne, size_t taille)
+ * 
+ * @brief Cette fonction lit une ligne d'un flux, sans le retour à la ligne
+ * 
+ * @param flux Le flux
+ * @param ligne La ligne lue
+ * @param taille La taille de ligne, la fin d'une ligne plus longue est ignorée
+ * @return true si une ligne a été lue
+ * @return false à la fin du flux
+ */
+bool lire_ligne(FILE *flux, char *ligne, size_t taille) {
+    size_t longueur;
+
+    if (fgets(ligne, taille, flux) == NULL) {
+        return false;
+    }
+
+    longueur = strlen(ligne);
+    if (longueur > 0 && ligne[longueur - 1] == '\n') {
+        ligne[longueur - 1] = '\0';
+        longueur = longueur - 1;
+    }
+    else if (longueur == taille - 1) {
+        int caractere;
+
+        do {
+            caractere = fgetc(flux);
+        }
+        while (caractere != '\n' && caractere != EOF);
+    }
+    if (longueur > 0 && ligne[longueur - 1] == '\r') {
+        ligne[longueur - 1] = '\0';
+    }
+
+    return true;
+}
+
+/**
+ * @fn void lire_saisie(char *ligne, size_t taille)
+ * 
+ * @brief Cette procédure lit la prochaine ligne non vide saisie au clavier
+ * 
+ * @param ligne La ligne lue
+ * @param taille La taille de ligne
+ * 
+ * La partie interactive ne peut pas continuer sans saisie : à la fin de l'entrée, le programme s'arrête
+ */
+void lire_saisie(char *ligne, size_t taille) {
+    do {
+        if (!lire_ligne(stdin, ligne, taille)) {
+            printf("\nFin de la saisie, la partie est abandonnée\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    while (ligne[strspn(ligne, " \t")] == '\0');
+}
+
+/**
+ * @fn int entrer_combinaison(t_score scores)
+ * 
+ * @brief Cette fonction permet d'entrer la combinaison que le joueur a réalisé
+ * 
+ * @param scores La feuille de score qui contient les 13 combinaisons possibles
+ * @return int l'indice de la combinaison dans le tableau des scores
+ * 
+ * Consiste à entrer le nom de combinaison que le joueur à rélisé et qu'il souhaite valider, ou son numéro de 1 à 13
+ */
+int entrer_combinaison(t_score scores) {
+    char entree[TAILLE_LIGNE];
+    int indice;
+
+    indice = -1;
+
+    printf("Entrez le nom de la combinaison que vous souhaitez valider / barrer : \n");
+
+    while (indice == -1) {
+        lire_saisie(entree, sizeof(entree));
+        indice = chercher_combinaison(entree + strspn(entree, " \t"));
+
+        if (indice == -1) {
+            printf("Saisie invalide, recommencez\n");
+        }
+        else if (scores[indice] != -1) {
+            printf("Cette combinaison est déjà validée / barrée, recommencez\n");
+            indice = -1;
+        }
+    }
+
+    return indice;
+}
+
+/**
+ * @fn void combinaisons_disponibles(t_des des, t_score scores)
+ * 
+ * @brief Cette procédure permet de déterminer quelles sont les combinaisons disponibles dans la grille
+ * 
+ * @param des Les dés lancés par le joueur
+ * @param scores La feuille de score
+ * 
+ * Consiste à vérifier quelles sont les combinaisons disponibles dans la grille, celles que le joueur n'a pas encore validées
+ * Par exemple, si le joueur réalise un score de 3 mais qu'il a déjà validé la case, alors celle-ci n'apparaîtra pas
+ */
+void combinaisons_disponibles(t_des des, t_score scores) {
+    int combinaisons_effectuees[13];
+    int nombre_combinaisons_effectuees;
+    int combinaisons_dispos[13]; 
+    int nombre_combinaisons_dispos;
+
+    nombre_combinaisons_dispos = 0;
+
+    combinaisons_possibles(des, combinaisons_effectuees, &nombre_combinaisons_effectuees);
+
+    for(int i = 0; i < nombre_combinaisons_effectuees; i++) {
+        for(int j = 0; j < 13; j++) {
+            if (combinaisons_effectuees[i] == j) {
+                if (scores[j] == -1) {
+                    combinaisons_dispos[nombre_combinaisons_dispos] = j;
+                    nombre_combinaisons_dispos = nombre_combinaisons_dispos +1;
+                }
+            }
+        }
+    }
+
+    printf("Les combinaisons disponibles sont les suivantes :\n");
+    for(int i = 0; i < nombre_combinaisons_dispos; i++ ) {
+        printf(" - %s\n", NOMS_COMBINAISONS[combinaisons_dispos[i]]);
+    }
+    printf("Les combinaisons qui ne sont pas encore validées sont les suivantes :\n");
+    for (int i = 0; i < 13; i++) {
+        if (scores[i] == -1) {
+            printf(" - %s\n", NOMS_COMBINAISONS[i]);
+        }
+    }
+}
+
+/**
+ * @fn void entrer_chaine(char *message, char *reponse, size_t taille)
+ * 
+ * @brief Cette procédure sert à écrire un message à l'écran auquel le joueur pourra répondre, ici elle servira à saisir
+ * le nom du joueur
+ * 
+ * @param message Correspond au message qui sera affiché à l'écran, un message qui demandera le nom du joueur
+ * @param reponse Sera la réponse saisie au clavier, elle correspond au nom du joueur
+ * @param taille La taille de reponse, une saisie plus longue est tronquée
+ * 
+ * Connsiste à saisir les noms des deux joueurs au début de la partie
+ */
+void entrer_chaine(char *message, char *reponse, size_t taille) {
+    char entree[TAILLE_LIGNE];
+
+    printf("%s", message);
+    lire_saisie(entree, sizeof(entree));
+    snprintf(reponse, taille, "%s", entree + strspn(entree, " \t"));
+}
+
+/**
+ * @fn void entrer_booleen(char message[50], bool *reponse)
+ * 
+ * @brief Cette procédure servira à demander au joueur s'il veut relancer les dés, il devra répondre soit "oui" soit "non"
+ * 
+ * @param message Correspond au message affiché à l'écran, si le joueur veut relancer ou non
+ * @param reponse Correspond à la réponse saisie par le joueur, elle devra soit être "oui" soit "non"
+ * 
+ * Consiste à saisir une réponse qui sera vraie (oui) ou fausse (non) pour savoir si le joueur souhaite relancer un ou 
+ * plusieurs dés
+ */
+void entrer_booleen(char *message, bool *reponse) {
+    char ligne[TAILLE_LIGNE];
+    char entree[TAILLE_LIGNE];
+
+    do {
+        printf("%s", message);
+        lire_saisie(ligne, sizeof(ligne));
+        sscanf(ligne, "%255s", entree);
+    }
+    while (strcmp (entree, "oui") != 0 && strcmp(entree, "non") != 0);
+    
+    if (strcmp(entree, "oui") == 0) {
+        *reponse = true;
+    }
+    else {
+        *reponse = false;
+    }
+}
+
+/**
+ * @fn void entrer_suite(char message[50], t_des reponse)
+ * 
+ * @brief Cette procédure sert à demander au joueur quels dés sont à relancer dans le cas ou il aurait répondu "oui"
+ * 
+ * @param message Le message affiché avant la saisie, qui demandera quels dés sont à relancer
+ * @param reponse La réponse, qui correspond au numéro, ou indice, du ou des dés que le joueur souhaite relancer
+ * 
+ * Consiste à saisir au clavier le ou les dés que le joueur souhaite relancer s'il veut relancer
+ */
+void entrer_suite(char *message, t_des reponse) {
+    char ligne[TAILLE_LIGNE];
+    char *position;
+    char *fin;
+    long entree;
+    int compteur;
+
+    compteur = 0;
+    entree = -1;
+
+    printf("%s", message);
+    do {
+        lire_saisie(ligne, sizeof(ligne));
+        position = ligne;
+
+        entree = strtol(position, &fin, 10);
+        while (fin != position && entree != 0 && compteur < NOMBRE_DES) {
+            if (entree > 0 && entree <= NOMBRE_DES) {
+                reponse[compteur] = entree - 1;
+                compteur = compteur +1;
+            }
+            else {
+                printf("Entrée invalide, recommencez\n");
+            }
+            position = fin;
+            entree = strtol(position, &fin, 10);
+        }
+        if (fin == position && position[strspn(position, " \t")] != '\0') {
+            printf("Entrée invalide, recommencez\n");
+        }
+        if (entree != 0 && compteur < NOMBRE_DES) {
+            printf("%s", message);
+        }
+    }
+    while (entree != 0 && compteur < NOMBRE_DES);
+
+    for (int i = compteur; i < NOMBRE_DES; i++) {
+        reponse[i] = -1;
+    }
+}
+
+/**
+ * @fn void afficher_scores(t_score scores, t_etat_joueur etat, char nom_joueur[20])
+ * 
+ * @brief Cette procédure sert à afficher les scores dans le tableau
+ * 
+ * @param scores La feuille de score
+ * @param etat L'état résumé de la feuille, qui donne les totaux sans relire la feuille
+ * @param nom_joueur Correspond au nom du joueur dont c'est au tour de jouer, chaque joueur ayant sa feuille de score
+ * 
+ * Consiste à afficher les scores du joueur dans les cases correspondantes du tableau de la feuille de score
+ */
+void afficher_scores(t_score scores, t_etat_joueur etat, char nom_joueur[20]) {
+    t_score affiche;
+
+    for (int i = 0; i < 13; i++) {
+        affiche[i] = scores[i] != -1 ? scores[i] : 0;
+    }
+
+    printf("           ┏━━━━┓            ┏━━━━┓\n"
+           "           ┃%c%c%c%c┃            ┃%c%c%c%c┃\n"
+           "┏━━━━━━━━━━╋━━━━┫ ┏━━━━━━━━━━╋━━━━┫\n"
+           "┃Total de 1┃%3d ┃ ┃Brelan    ┃%3d ┃\n"
+           "┣━━━━━━━━━━╋━━━━┫ ┣━━━━━━━━━━╋━━━━┫\n"
+           "┃Total de 2┃%3d ┃ ┃Carré     ┃%3d ┃\n"
+           "┣━━━━━━━━━━╋━━━━┫ ┣━━━━━━━━━━╋━━━━┫\n"
+           "┃Total de 3┃%3d ┃ ┃Full House┃%3d ┃\n"
+           "┣━━━━━━━━━━╋━━━━┫ ┣━━━━━━━━━━╋━━━━┫\n"
+           "┃Total de 4┃%3d ┃ ┃Pte suite ┃%3d ┃\n"
+           "┣━━━━━━━━━━╋━━━━┫ ┣━━━━━━━━━━╋━━━━┫\n"
+           "┃Total de 5┃%3d ┃ ┃Gde suite ┃%3d ┃\n"
+           "┣━━━━━━━━━━╋━━━━┫ ┣━━━━━━━━━━╋━━━━┫\n"
+           "┃Total de 6┃%3d ┃ ┃Yams      ┃%3d ┃\n"
+           "┣━━━━━━━━━━╋━━━━┫ ┣━━━━━━━━━━╋━━━━┫\n"
+           "┃Bonus > 62┃%3d ┃ ┃Chance    ┃%3d ┃\n" 
+           "┣━━━━━━━━━━╋━━━━┫ ┣━━━━━━━━━━╋━━━━┫\n"
+           "┃Total sup ┃%3d ┃ ┃Total inf ┃%3d ┃\n"
+           "┗━━━━━━━━━━┻━━━━┛ ┗━━━━━━━━━━┻━━━━┛\n" 
+           "┏━━━━━━━━━━┳━━━━┓\n"
+           "┃Total     ┃%3d ┃\n"
+           "┗━━━━━━━━━━┻━━━━┛\n", 
+           nom_joueur[0], nom_joueur[1], nom_joueur[2], nom_joueur[3], nom_joueur[0], nom_joueur[1], nom_joueur[2], nom_joueur[3],
+           affiche[0], affiche[6],
+           affiche[1], affiche[7],
+           affiche[2], affiche[8],
+           affiche[3], affiche[9],
+           affiche[4], affiche[10],
+           affiche[5], affiche[11],
+           ETAT_BONUS(etat), affiche[12],
+           ETAT_TOTAL_SUP(etat), ETAT_TOTAL_INF(etat), 
+           ETAT_TOTAL(etat)
+        );
+}
+
+/**
+ * @fn void afficher_des(t_des des)
+ * 
+ * @brief Cette procédure sert à afficher les dés lancés
+ * 
+ * @param des Les 5 dés lancés
+ * 
+ * Consiste à afficher la valeur des dés du joueur après un lancer
+ */
+void afficher_des(t_des des) {
+    for (int i = 0; i < NOMBRE_DES; i++) {
+        switch (des[i]) {
+        case 1 :
+            printf("┏━━━━━━━┓\n"
+                   "┃       ┃\n"
+                   "┃   ●   ┃\n"
+                   "┃       ┃\n"
+                   "┗━━━━━━━┛\n");
+            break;
+        
+        case 2 :
+            printf("┏━━━━━━━┓\n"
+                   "┃     ● ┃\n"
+                   "┃       ┃\n"
+                   "┃ ●     ┃\n"
+                   "┗━━━━━━━┛\n");
+            break;
+
+        case 3 :
+            printf("┏━━━━━━━┓\n"
+                   "┃     ● ┃\n"
+                   "┃   ●   ┃\n"
+                   "┃ ●     ┃\n"
+                   "┗━━━━━━━┛\n");
+            break;
+
+        case 4 :
+            printf("┏━━━━━━━┓\n"
+                   "┃ ●   ● ┃\n"
+                   "┃       ┃\n"
+                   "┃ ●   ● ┃\n"
+                   "┗━━━━━━━┛\n");
+            break;
+
+        case 5 :
+            printf("┏━━━━━━━┓\n"
+                   "┃ ●   ● ┃\n"
+                   "┃   ●   ┃\n"
+                   "┃ ●   ● ┃\n"
+                   "┗━━━━━━━┛\n");
+            break;
+
+        case 6 :
+            printf("┏━━━━━━━┓\n"
+                   "┃ ●   ● ┃\n"
+                   "┃ ●   ● ┃\n"
+                   "┃ ●   ● ┃\n"
+                   "┗━━━━━━━┛\n");
+            break;
+
+        case 7 :
+            printf("┏━━━━━━━┓\n"
+                   "┃ ●   ● ┃\n"
+                   "┃ ● ● ● ┃\n"
+                   "┃ ●   ● ┃\n"
+                   "┗━━━━━━━┛\n");
+            break;
+
+        case 8 :
+            printf("┏━━━━━━━┓\n"
+                   "┃ ● ● ● ┃\n"
+                   "┃ ●   ● ┃\n"
+                   "┃ ● ● ● ┃\n"
+                   "┗━━━━━━━┛\n");
+            break;
+        
+        default:
+            printf("? ");
+            break;
+        }
+        //printf("[%d] ",des[i]);
+    }
+    printf("\n");
+    
+}
+
+/**
+ * @fn int formater_des(char *texte, size_t taille, t_des des)
+ * 
+ * @brief Cette fonction écrit les faces des dés séparées par des espaces, par exemple « 1 3 3 5 6 »
+ * 
+ * @param texte Reçoit le texte, 4 * NOMBRE_DES octets suffisent
+ * @param taille La taille de texte
+ * @param des Les dés
+ * @return int la longueur du texte
+ */
+int formater_des(char *texte, size_t taille, t_des des) {
+    int longueur;
+
+    longueur = 0;
+    for (int i = 0; i < NOMBRE_DES && (size_t) longueur < taille; i++) {
+        longueur = longueur + snprintf(texte + longueur, taille - longueur, i == 0 ? "%d" : " %d", des[i]);
+    }
+
+    return longueur;
+}
+
+/*********************************
+ *    AFFICHAGE PLEIN ÉCRAN      *
+ *********************************/
+
+/**
+ * @brief Les libellés des combinaisons sur la feuille de score, 10 colonnes comme dans maquette.txt
+ * 
+ */
+const char LIBELLES_FEUILLE[13][16] = {
+    "Total de 1", "Total de 2", "Total de 3",
+    "Total de 4", "Total de 5", "Total de 6",
+    "Brelan", "Carré", "Full House",
+    "Pte suite", "Gde suite", "Yams",
+    "Chance"
+};
+
+/**
+ * @brief Les 3 lignes intérieures de la face de chaque dé, 7 colonnes, la face 0 étant un dé pas encore lancé
+ * 
+ * Les faces 7 et 8 ne servent qu'aux variantes à 8 faces
+ * 
+ */
+const char *FACES_DES[9][3] = {
+    {"       ", "   ?   ", "       "},
+    {"       ", "   ●   ", "       "},
+    {"     ● ", "       ", " ●     "},
+    {"     ● ", "   ●   ", " ●     "},
+    {" ●   ● ", "       ", " ●   ● "},
+    {" ●   ● ", "   ●   ", " ●   ● "},
+    {" ●   ● ", " ●   ● ", " ●   ● "},
+    {" ●   ● ", " ● ● ● ", " ●   ● "},
+    {" ● ● ● ", " ●   ● ", " ● ● ● "}
+};
+
+/**
+ * @fn void creer_ecran(t_ecran *ecran, int lignes, int colonnes)
+ * 
+ * @brief Cette procédure alloue l'écran et son tampon de sortie
+ * 
+ * @param ecran L'écran
+ * @param lignes Le nombre de lignes de l'image
+ * @param colonnes Le nombre de colonnes de l'image
+ * 
+ * Le tampon peut contenir une image où toutes les cellules changent : 4 octets par cellule et un déplacement
+ * du curseur par cellule, au plus 12 octets, plus l'effacement de l'écran
+ */
+void creer_ecran(t_ecran *ecran, int lignes, int colonnes) {
+    ecran->lignes = lignes;
+    ecran->colonnes = colonnes;
+    ecran->cellules = malloc((size_t) lignes * colonnes * sizeof(uint32_t));
+    ecran->affichees = malloc((size_t) lignes * colonnes * sizeof(uint32_t));
+    ecran->capacite = (size_t) lignes * colonnes * 16 + 64;
+    ecran->tampon = malloc(ecran->capacite);
+    ecran->complet = true;
+}
+
+/**
+ * @fn void liberer_ecran(t_ecran *ecran)
+ * 
+ * @brief Cette procédure libère l'écran
+ * 
+ * @param ecran L'écran
+ */
+void liberer_ecran(t_ecran *ecran) {
+    free(ecran->cellules);
+    free(ecran->affichees);
+    free(ecran->tampon);
+}
+
+/**
+ * @fn void effacer_image(t_ecran *ecran)
+ * 
+ * @brief Cette procédure remplit l'image en cours de composition avec des espaces
+ * 
+ * @param ecran L'écran
+ */
+void effacer_image(t_ecran *ecran) {
+    for (int i = 0; i < ecran->lignes * ecran->colonnes; i++) {
+        ecran->cellules[i] = ' ';
+    }
+}
+
+/**
+ * @fn int ecrire_texte(t_ecran *ecran, int ligne, int colonne, const char *texte)
+ * 
+ * @brief Cette fonction écrit un texte UTF-8 dans l'image, un caractère par cellule
+ * 
+ * @param ecran L'écran
+ * @param ligne La ligne du premier caractère
+ * @param colonne La colonne du premier caractère
+ * @param texte Le texte, tronqué au bord droit de l'image
+ * @return int la colonne qui suit le dernier caractère écrit
+ */
+int ecrire_texte(t_ecran *ecran, int ligne, int colonne, const char *texte) {
+    const unsigned char *octet;
+
+    octet = (const unsigned char *) texte;
+    while (*octet != '\0' && colonne < ecran->colonnes) {
+        uint32_t cellule;
+        int longueur;
+
+        longueur = *octet >= 0xF0 ? 4 : *octet >= 0xE0 ? 3 : *octet >= 0xC0 ? 2 : 1;
+        cellule = 0;
+        for (int i = 0; i < longueur && octet[i] != '\0'; i++) {
+            cellule = cellule | ((uint32_t) octet[i] << (8 * i));
+        }
+        ecran->cellules[ligne * ecran->colonnes + colonne] = cellule;
+
+        for (int i = 0; i < longueur && *octet != '\0'; i++) {
+            octet = octet + 1;
+        }
+        colonne = colonne + 1;
+    }
+
+    return colonne;
+}
+
+/**
+ * @fn int largeur_champ(const char *texte, int colonnes)
+ * 
+ * @brief Cette fonction donne la largeur en octets d'un champ printf où un texte UTF-8 occupe un nombre de colonnes
+ * 
+ * @param texte Le texte
+ * @param colonnes Le nombre de colonnes du champ
+ * @return int la largeur à passer à %-*s, qui compte les octets et non les caractères
+ * 
+ * Comme pour ecrire_texte, chaque caractère occupe une colonne : seuls les octets de continuation (10xxxxxx) sont
+ * ajoutés à la largeur du champ
+ */
+int largeur_champ(const char *texte, int colonnes) {
+    for (const unsigned char *octet = (const unsigned char *) texte; *octet != '\0'; octet++) {
+        if ((*octet & 0xC0) == 0x80) {
+            colonnes = colonnes + 1;
+        }
+    }
+
+    return colonnes;
+}
+
+/**
+ * @fn void ecrire_bordure(t_ecran *ecran, int ligne, int nombre_joueurs, const char *gauche, const char *milieu,
+ *                         const char *droite)
+ * 
+ * @brief Cette procédure écrit une ligne de bordure de la feuille de score
+ * 
+ * @param ecran L'écran
+ * @param ligne La ligne de la bordure
+ * @param nombre_joueurs Le nombre de colonnes de joueurs
+ * @param gauche Le coin ou la jonction de gauche
+ * @param milieu La jonction entre deux colonnes
+ * @param droite Le coin ou la jonction de droite
+ */
+void ecrire_bordure(t_ecran *ecran, int ligne, int nombre_joueurs, const char *gauche, const char *milieu,
+                    const char *droite) {
+    int colonne;
+
+    colonne = ecrire_texte(ecran, ligne, 0, gauche);
+    colonne = ecrire_texte(ecran, ligne, colonne, "━━━━━━━━━━");
+    for (int j = 0; j < nombre_joueurs; j++) {
+        colonne = ecrire_texte(ecran, ligne, colonne, milieu);
+        colonne = ecrire_texte(ecran, ligne, colonne, "━━━━");
+    }
+    ecrire_texte(ecran, ligne, colonne, droite);
+}
+
+/**
+ * @fn void ecrire_ligne_feuille(t_ecran *ecran, int ligne, const char *libelle, const int *valeurs, int nombre_joueurs)
+ * 
+ * @brief Cette procédure écrit une ligne de la feuille de score, avec la valeur de chaque joueur
+ * 
+ * @param ecran L'écran
+ * @param ligne La ligne de l'image
+ * @param libelle Le libellé de la ligne
+ * @param valeurs La valeur de chaque joueur, -1 pour une case vide
+ * @param nombre_joueurs Le nombre de joueurs
+ */
+void ecrire_ligne_feuille(t_ecran *ecran, int ligne, const char *libelle, const int *valeurs, int nombre_joueurs) {
+    char texte[8];
+    int colonne;
+
+    ecrire_texte(ecran, ligne, 0, "┃");
+    ecrire_texte(ecran, ligne, 1, libelle);
+    colonne = 11;
+    for (int j = 0; j < nombre_joueurs; j++) {
+        colonne = ecrire_texte(ecran, ligne, colonne, "┃");
+        if (valeurs[j] != -1) {
+            snprintf(texte, sizeof(texte), "%3d ", valeurs[j]);
+            ecrire_texte(ecran, ligne, colonne, texte);
+        }
+        colonne = colonne + 4;
+    }
+    ecrire_texte(ecran, ligne, colonne, "┃");
+}
+
+/**
+ * @brief Raccourci associé au nombre de lignes de l'image d'une partie
+ * 
+ */
+#define LIGNES_PARTIE 33
+
+/**
+ * @fn int colonnes_partie(int nombre_joueurs)
+ * 
+ * @brief Cette fonction donne le nombre de colonnes de l'image d'une partie
+ * 
+ * @param nombre_joueurs Le nombre de joueurs
+ * @return int la largeur de la feuille de score, au moins celle des 5 dés côte à côte
+ */
+int colonnes_partie(int nombre_joueurs) {
+    int colonnes;
+
+    colonnes = 12 + 5 * nombre_joueurs;
+    return colonnes > 11 * NOMBRE_DES + 5 ? colonnes : 11 * NOMBRE_DES + 5;
+}
+
+/**
+ * @fn void dessiner_partie(t_ecran *ecran, t_partie *partie, char joueurs[][50])
+ * 
+ * @brief Cette procédure compose l'image d'une partie : les dés côte à côte et les feuilles de tous les joueurs
+ * 
+ * @param ecran L'écran, de LIGNES_PARTIE lignes et colonnes_partie(nombre de joueurs) colonnes
+ * @param partie Le contexte de la partie
+ * @param joueurs Les noms des joueurs, dont les 4 premiers caractères sont affichés en tête de colonne
+ */
+void dessiner_partie(t_ecran *ecran, t_partie *partie, char joueurs[][50]) {
+    int valeurs[partie->nombre_joueurs];
+    char texte[128];
+    int nombre;
+    int ligne;
+
+    nombre = partie->nombre_joueurs;
+    effacer_image(ecran);
+
+    if (partie_terminee(partie)) {
+        snprintf(texte, sizeof(texte), "Partie terminée");
+    }
+    else {
+        snprintf(texte, sizeof(texte), "Tour %d/13 - %s - %d relance(s) restante(s)", partie->tour + 1,
+                 joueurs[partie->joueur], partie->relances_restantes);
+    }
+    ecrire_texte(ecran, 0, 0, texte);
+
+    for (int i = 0; i < NOMBRE_DES; i++) {
+        int face;
+
+        face = partie->des[i] >= 1 && partie->des[i] <= NOMBRE_FACES ? partie->des[i] : 0;
+        ecrire_texte(ecran, 2, 11 * i, "┏━━━━━━━┓");
+        for (int k = 0; k < 3; k++) {
+            ecrire_texte(ecran, 3 + k, 11 * i, "┃");
+            ecrire_texte(ecran, 3 + k, 11 * i + 1, FACES_DES[face][k]);
+            ecrire_texte(ecran, 3 + k, 11 * i + 8, "┃");
+        }
+        ecrire_texte(ecran, 6, 11 * i, "┗━━━━━━━┛");
+        snprintf(texte, sizeof(texte), "%d", i + 1);
+        ecrire_texte(ecran, 7, 11 * i + 4, texte);
+    }
+
+    ecrire_bordure(ecran, 9, nombre, "┏", "┳", "┓");
+    ecrire_texte(ecran, 10, 0, "┃");
+    for (int j = 0; j < nombre; j++) {
+        char nom[5];
+
+        snprintf(nom, sizeof(nom), "%-4.4s", joueurs[j]);
+        ecrire_texte(ecran, 10, 11 + 5 * j, j == partie->joueur && !partie_terminee(partie) ? "▶" : "┃");
+        ecrire_texte(ecran, 10, 12 + 5 * j, nom);
+    }
+    ecrire_texte(ecran, 10, 11 + 5 * nombre, "┃");
+    ecrire_bordure(ecran, 11, nombre, "┣", "╋", "┫");
+
+    ligne = 12;
+    for (int c = 0; c < 13; c++) {
+        for (int j = 0; j < nombre; j++) {
+            valeurs[j] = partie->feuilles.cases[c][j];
+        }
+        ecrire_ligne_feuille(ecran, ligne, LIBELLES_FEUILLE[c], valeurs, nombre);
+        ligne = ligne + 1;
+
+        if (c == 5) {
+            ecrire_bordure(ecran, ligne, nombre, "┣", "╋", "┫");
+            for (int j = 0; j < nombre; j++) {
+                valeurs[j] = ETAT_BONUS(partie->feuilles.etats[j]);
+            }
+            ecrire_ligne_feuille(ecran, ligne + 1, "Bonus > 62", valeurs, nombre);
+            for (int j = 0; j < nombre; j++) {
+                valeurs[j] = ETAT_TOTAL_SUP(partie->feuilles.etats[j]);
+            }
+            ecrire_ligne_feuille(ecran, ligne + 2, "Total sup", valeurs, nombre);
+            ecrire_bordure(ecran, ligne + 3, nombre, "┣", "╋", "┫");
+            ligne = ligne + 4;
+        }
+    }
+
+    ecrire_bordure(ecran, ligne, nombre, "┣", "╋", "┫");
+    for (int j = 0; j < nombre; j++) {
+        valeurs[j] = ETAT_TOTAL_INF(partie->feuilles.etats[j]);
+    }
+    ecrire_ligne_feuille(ecran, ligne + 1, "Total inf", valeurs, nombre);
+    for (int j = 0; j < nombre; j++) {
+        valeurs[j] = ETAT_TOTAL(partie->feuilles.etats[j]);
+    }
+    ecrire_ligne_feuille(ecran, ligne + 2, "Total", valeurs, nombre);
+    ecrire_bordure(ecran, ligne + 3, nombre, "┗", "┻", "┛");
+}
+
+/**
+ * @fn void rafraichir_ecran(t_ecran *ecran)
+ * 
+ * @brief Cette procédure met le terminal à jour avec l'image composée, en un seul appel à write
+ * 
+ * @param ecran L'écran
+ * 
+ * Consiste à parcourir l'image ligne par ligne et, pour chaque suite de cellules modifiées, à placer le curseur
+ * (séquence ANSI ESC [ ligne ; colonne H) puis à écrire les cellules de la suite. Le premier rafraîchissement
+ * efface l'écran et envoie toute l'image. Le curseur est ensuite placé sous l'image, dont la suite est effacée,
+ * pour que les questions posées au joueur s'affichent dessous. La sortie de stdio est vidée avant l'envoi
+ * pour que les deux sorties restent dans l'ordre
+ */
+void rafraichir_ecran(t_ecran *ecran) {
+    size_t longueur;
+    size_t ecrits;
+
+    longueur = 0;
+    if (ecran->complet) {
+        memcpy(ecran->tampon, "\033[H\033[2J", 7);
+        longueur = 7;
+    }
+
+    for (int ligne = 0; ligne < ecran->lignes; ligne++) {
+        int colonne;
+
+        colonne = 0;
+        while (colonne < ecran->colonnes) {
+            int indice;
+
+            indice = ligne * ecran->colonnes + colonne;
+            if (!ecran->complet && ecran->cellules[indice] == ecran->affichees[indice]) {
+                colonne = colonne + 1;
+                continue;
+            }
+
+            longueur = longueur + sprintf(ecran->tampon + longueur, "\033[%d;%dH", ligne + 1, colonne + 1);
+            while (colonne < ecran->colonnes
+                   && (ecran->complet || ecran->cellules[indice] != ecran->affichees[indice])) {
+                uint32_t cellule;
+
+                cellule = ecran->cellules[indice];
+                ecran->affichees[indice] = cellule;
+                do {
+                    ecran->tampon[longueur] = (char) (cellule & 0xFF);
+                    longueur = longueur + 1;
+                    cellule = cellule >> 8;
+                }
+                while (cellule != 0);
+
+                colonne = colonne + 1;
+                indice = indice + 1;
+            }
+        }
+    }
+
+    longueur = longueur + sprintf(ecran->tampon + longueur, "\033[%d;1H\033[J", ecran->lignes + 2);
+    ecran->complet = false;
+
+    fflush(stdout);
+    ecrits = 0;
+    while (ecrits < longueur) {
+        ssize_t resultat;
+
+        resultat = write(STDOUT_FILENO, ecran->tampon + ecrits, longueur - ecrits);
+        if (resultat <= 0) {
+            break;
+        }
+        ecrits = ecrits + resultat;
+    }
+}
+
+/*********************************
+ *   SIMULATION SANS AFFICHAGE   *
+ *********************************/
+
+/**
+ * @fn bool instancier_strategie(t_strategie *modele, t_strategie *instance)
+ * 
+ * @brief Cette fonction crée une instance d'une stratégie, utilisable par un seul thread
+ * 
+ * @param modele La stratégie enregistrée
+ * @param instance Reçoit la stratégie avec son propre contexte si elle en crée un, sinon le modèle tel quel
+ * @return true si l'instance a été créée
+ * @return false si la mémoire manque pour son contexte, l'instance n'ayant alors rien à libérer
+ */
+bool instancier_strategie(t_strategie *modele, t_strategie *instance) {
+    *instance = *modele;
+    if (modele->creer_contexte != NULL) {
+        instance->contexte = modele->creer_contexte(modele->contexte);
+        if (instance->contexte == NULL) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @fn void liberer_instance(t_strategie *instance)
+ * 
+ * @brief Cette procédure libère le contexte d'une instance créée par instancier_strategie
+ * 
+ * @param instance L'instance de la stratégie
+ */
+void liberer_instance(t_strategie *instance) {
+    if (instance->creer_contexte != NULL && instance->detruire_contexte != NULL) {
+        instance->detruire_contexte(instance->contexte);
+    }
+}
+
+/**
+ * @fn void jouer_tour(t_strategie *strategie, t_partie *partie, t_tour_journal *tour)
+ * 
+ * @brief Cette procédure joue le tour du joueur courant d'une partie, sans aucune saisie ni affichage
+ * 
+ * @param strategie La stratégie qui prend les décisions du joueur courant
+ * @param partie Le contexte de la partie
+ * @param tour Reçoit le déroulement du tour pour un journal, NULL s'il n'est pas utile
+ * 
+ * Reprend le déroulement d'un tour du programme principal : un lancer des 5 dés, jusqu'à 3 relances tant que la
+ * stratégie demande à relancer, puis la validation d'une combinaison. Une combinaison déjà remplie ou invalide
+ * renvoyée par la stratégie est remplacée par la première case libre de la feuille
+ */
+void jouer_tour(t_strategie *strategie, t_partie *partie, t_tour_journal *tour) {
+    t_score scores;
+    int masque;
+    int combinaison;
+    int relances;
+
+    lire_feuille(&partie->feuilles, partie->joueur, scores);
+    commencer_tour(partie);
+    relances = 0;
+    if (tour != NULL) {
+        tour->lancers[0] = code_lancer(partie->des);
+    }
+
+    while (partie->relances_restantes > 0) {
+        masque = strategie->choisir_relance(partie->des, scores, partie->relances_restantes, strategie->contexte)
+                 & MASQUE_DES;
+        if (masque == 0) {
+            break;
+        }
+        relancer_tour(partie, masque);
+        if (tour != NULL) {
+            tour->masques[relances] = masque;
+            tour->lancers[relances + 1] = code_lancer(partie->des);
+        }
+        relances = relances + 1;
+    }
+
+    combinaison = strategie->choisir_combinaison(partie->des, scores, strategie->contexte);
+    if (valider_combinaison(partie, combinaison) == -1) {
+        combinaison = 0;
+        while (scores[combinaison] != -1) {
+            combinaison = combinaison + 1;
+        }
+        valider_combinaison(partie, combinaison);
+    }
+
+    if (tour != NULL) {
+        tour->relances = relances;
+        tour->combinaison = combinaison;
+    }
+}
+
+/**
+ * @fn int jouer_partie(t_strategie *strategie, t_partie *partie, t_score scores)
+ * 
+ * @brief Cette fonction joue une partie complète de 13 tours pour un joueur, sans aucune saisie ni affichage
+ * 
+ * @param strategie La stratégie qui prend les décisions du joueur
+ * @param partie Le contexte de la partie, dont le générateur de dés est déjà initialisé
+ * @param scores La feuille de score du joueur, qui sert de mémoire aux feuilles de la partie
+ * @return int le total de la partie, bonus compris
+ * 
+ * Avec un seul joueur, les feuilles rangées par colonnes ont exactement la disposition d'une feuille t_score
+ */
+int jouer_partie(t_strategie *strategie, t_partie *partie, t_score scores) {
+    t_etat_joueur etat;
+
+    initialiser_partie(partie, 1, scores, &etat);
+
+    while (!partie_terminee(partie)) {
+        jouer_tour(strategie, partie, NULL);
+    }
+
+    return ETAT_TOTAL(etat);
+}
+
+/**
+ * @brief Raccourci associé au nombre maximal de parties présentées ensemble aux décisions par lots
+ * 
+ */
+#define TAILLE_LOT_DECISIONS 256
+
+/**
+ * @fn void compter_resultat(t_resultats *resultats, t_score scores, int total)
+ * 
+ * @brief Cette procédure ajoute une partie terminée aux résultats agrégés d'une série
+ * 
+ * @param resultats Les résultats de la série
+ * @param scores La feuille de score de la partie
+ * @param total Le total de la partie, bonus compris
+ */
+void compter_resultat(t_resultats *resultats, t_score scores, int total) {
+    if (resultats->nombre_parties == 0 || total < resultats->score_min) {
+        resultats->score_min = total;
+    }
+    if (resultats->nombre_parties == 0 || total > resultats->score_max) {
+        resultats->score_max = total;
+    }
+    if (scores[0] + scores[1] + scores[2] + scores[3] + scores[4] + scores[5] > 62) {
+        resultats->nombre_bonus = resultats->nombre_bonus + 1;
+    }
+    if (scores[11] == POINTS_YAMS) {
+        resultats->nombre_yams = resultats->nombre_yams + 1;
+    }
+
+    for (int c = 0; c < 13; c++) {
+        resultats->points[c] = resultats->points[c] + scores[c];
+        if (scores[c] > 0) {
+            resultats->reussites[c] = resultats->reussites[c] + 1;
+        }
+    }
+    resultats->histogramme[total] = resultats->histogramme[total] + 1;
+
+    resultats->somme_scores = resultats->somme_scores + total;
+    resultats->somme_carres = resultats->somme_carres + (long long) total * total;
+    resultats->nombre_parties = resultats->nombre_parties + 1;
+}
+
+/**
+ * @fn void fusionner_resultats(t_resultats *resultats, const t_resultats *autres)
+ * 
+ * @brief Cette procédure ajoute les résultats d'une autre série aux résultats d'une série
+ * 
+ * @param resultats Les résultats complétés
+ * @param autres Les résultats ajoutés
+ */
+void fusionner_resultats(t_resultats *resultats, const t_resultats *autres) {
+    if (autres->nombre_parties == 0) {
+        return;
+    }
+    if (resultats->nombre_parties == 0 || autres->score_min < resultats->score_min) {
+        resultats->score_min = autres->score_min;
+    }
+    if (resultats->nombre_parties == 0 || autres->score_max > resultats->score_max) {
+        resultats->score_max = autres->score_max;
+    }
+
+    resultats->nombre_parties = resultats->nombre_parties + autres->nombre_parties;
+    resultats->somme_scores = resultats->somme_scores + autres->somme_scores;
+    resultats->somme_carres = resultats->somme_carres + autres->somme_carres;
+    resultats->nombre_bonus = resultats->nombre_bonus + autres->nombre_bonus;
+    resultats->nombre_yams = resultats->nombre_yams + autres->nombre_yams;
+    for (int c = 0; c < 13; c++) {
+        resultats->points[c] = resultats->points[c] + autres->points[c];
+        resultats->reussites[c] = resultats->reussites[c] + autres->reussites[c];
+    }
+    for (int score = 0; score <= SCORE_MAXIMAL; score++) {
+        resultats->histogramme[score] = resultats->histogramme[score] + autres->histogramme[score];
+    }
+}
+
+/**
+ * @fn void remplir_vue(t_vue_partie *vue, t_des des, t_score scores, t_etat_joueur etat, int relances_restantes)
+ * 
+ * @brief Cette procédure prépare la vue d'une partie présentée à une décision par lots
+ * 
+ * @param vue La vue
+ * @param des Les 5 dés du joueur
+ * @param scores La feuille de score du joueur
+ * @param etat L'état résumé de la feuille
+ * @param relances_restantes Le nombre de relances encore possibles, 0 pour le choix de la combinaison
+ */
+void remplir_vue(t_vue_partie *vue, t_des des, t_score scores, t_etat_joueur etat, int relances_restantes) {
+    for (int i = 0; i < (int) (sizeof(vue->des) / sizeof(vue->des[0])); i++) {
+        vue->des[i] = i < NOMBRE_DES ? des[i] : 0;
+    }
+    for (int c = 0; c < 13; c++) {
+        vue->scores[c] = scores[c];
+    }
+    vue->relances_restantes = relances_restantes;
+    vue->reserve = 0;
+    vue->etat = etat;
+}
+
+/**
+ * @fn bool simuler_parties_lots(long nombre, t_strategie *instance, t_generateur *flux, t_resultats *resultats)
+ * 
+ * @brief Cette fonction simule une série de parties en présentant les décisions par lots à la stratégie
+ * 
+ * @param nombre Le nombre de parties à jouer
+ * @param instance L'instance de la stratégie, qui fournit les décisions par lots
+ * @param flux Le générateur de la série, avancé d'un saut par bloc de PARTIES_PAR_FLUX parties
+ * @param resultats Les résultats agrégés de la série, complétés
+ * @return true si la série a été jouée
+ * @return false si la mémoire manque pour les lots, aucune partie n'étant alors jouée
+ * 
+ * Chaque voie d'un lot joue à la suite les parties d'un bloc de PARTIES_PAR_FLUX parties avec le flux de ce bloc,
+ * et toutes les voies avancent ensemble, tour par tour et relance par relance : une décision par lots couvre
+ * une partie par voie encore en jeu. Les dés de chaque partie sont donc ceux qu'elle aurait eus en étant jouée
+ * seule par simuler_parties, et les résultats sont les mêmes
+ */
+bool simuler_parties_lots(long nombre, t_strategie *instance, t_generateur *flux, t_resultats *resultats) {
+    t_partie *parties;
+    t_score *feuilles;
+    t_etat_joueur *etats;
+    t_vue_partie *vues;
+    int32_t *decisions;
+    long *restantes;
+    int *actives;
+    int *en_cours;
+    long nombre_flux;
+
+    parties = malloc(TAILLE_LOT_DECISIONS * sizeof(t_partie));
+    feuilles = malloc(TAILLE_LOT_DECISIONS * sizeof(t_score));
+    etats = malloc(TAILLE_LOT_DECISIONS * sizeof(t_etat_joueur));
+    vues = malloc(TAILLE_LOT_DECISIONS * sizeof(t_vue_partie));
+    decisions = malloc(TAILLE_LOT_DECISIONS * sizeof(int32_t));
+    restantes = malloc(TAILLE_LOT_DECISIONS * sizeof(long));
+    actives = malloc(TAILLE_LOT_DECISIONS * sizeof(int));
+    en_cours = malloc(TAILLE_LOT_DECISIONS * sizeof(int));
+    if (parties == NULL || feuilles == NULL || etats == NULL || vues == NULL || decisions == NULL
+        || restantes == NULL || actives == NULL || en_cours == NULL) {
+        free(en_cours);
+        free(actives);
+        free(restantes);
+        free(decisions);
+        free(vues);
+        free(etats);
+        free(feuilles);
+        free(parties);
+        return false;
+    }
+
+    nombre_flux = (nombre + PARTIES_PAR_FLUX - 1) / PARTIES_PAR_FLUX;
+    for (long premier = 0; premier < nombre_flux; premier = premier + TAILLE_LOT_DECISIONS) {
+        int nombre_actives;
+
+        nombre_actives = 0;
+        for (long f = premier; f < nombre_flux && f < premier + TAILLE_LOT_DECISIONS; f++) {
+            parties[nombre_actives].generateur = *flux;
+            sauter_generateur(flux);
+            restantes[nombre_actives] = nombre - f * PARTIES_PAR_FLUX;
+            if (restantes[nombre_actives] > PARTIES_PAR_FLUX) {
+                restantes[nombre_actives] = PARTIES_PAR_FLUX;
+            }
+            actives[nombre_actives] = nombre_actives;
+            nombre_actives = nombre_actives + 1;
+        }
+
+        while (nombre_actives > 0) {
+            int suivantes;
+
+            for (int k = 0; k < nombre_actives; k++) {
+                initialiser_partie(&parties[actives[k]], 1, feuilles[actives[k]], &etats[actives[k]]);
+            }
+
+            for (int tour = 0; tour < 13; tour++) {
+                int nombre_en_cours;
+
+                for (int k = 0; k < nombre_actives; k++) {
+                    commencer_tour(&parties[actives[k]]);
+                    en_cours[k] = actives[k];
+                }
+                nombre_en_cours = nombre_actives;
+
+                while (nombre_en_cours > 0 && parties[en_cours[0]].relances_restantes > 0) {
+                    int restants;
+
+                    for (int k = 0; k < nombre_en_cours; k++) {
+                        t_partie *partie;
+
+                        partie = &parties[en_cours[k]];
+                        remplir_vue(&vues[k], partie->des, feuilles[en_cours[k]], etats[en_cours[k]],
+                                    partie->relances_restantes);
+                    }
+                    instance->choisir_relances(vues, decisions, nombre_en_cours, instance->contexte);
+
+                    restants = 0;
+                    for (int k = 0; k < nombre_en_cours; k++) {
+                        if ((decisions[k] & MASQUE_DES) != 0) {
+                            relancer_tour(&parties[en_cours[k]], decisions[k] & MASQUE_DES);
+                            en_cours[restants] = en_cours[k];
+                            restants = restants + 1;
+                        }
+                    }
+                    nombre_en_cours = restants;
+                }
+
+                for (int k = 0; k < nombre_actives; k++) {
+                    remplir_vue(&vues[k], parties[actives[k]].des, feuilles[actives[k]], etats[actives[k]], 0);
+                }
+                instance->choisir_combinaisons(vues, decisions, nombre_actives, instance->contexte);
+
+                for (int k = 0; k < nombre_actives; k++) {
+                    if (valider_combinaison(&parties[actives[k]], decisions[k]) == -1) {
+                        int combinaison;
+
+                        combinaison = 0;
+                        while (feuilles[actives[k]][combinaison] != -1) {
+                            combinaison = combinaison + 1;
+                        }
+                        valider_combinaison(&parties[actives[k]], combinaison);
+                    }
+                }
+            }
+
+            suivantes = 0;
+            for (int k = 0; k < nombre_actives; k++) {
+                compter_resultat(resultats, feuilles[actives[k]], ETAT_TOTAL(etats[actives[k]]));
+                restantes[actives[k]] = restantes[actives[k]] - 1;
+                if (restantes[actives[k]] > 0) {
+                    actives[suivantes] = actives[k];
+                    suivantes = suivantes + 1;
+                }
+            }
+            nombre_actives = suivantes;
+        }
+    }
+
+    free(en_cours);
+    free(actives);
+    free(restantes);
+    free(decisions);
+    free(vues);
+    free(etats);
+    free(feuilles);
+    free(parties);
+    return true;
+}
+
+/**
+ * @fn bool simuler_serie(long nombre, t_strategie *instance, t_generateur *flux, t_resultats *resultats)
+ * 
+ * @brief Cette fonction joue une série de parties à partir d'un flux du générateur
+ * 
+ * @param nombre Le nombre de parties à jouer
+ * @param instance L'instance de la stratégie qui prend les décisions
+ * @param flux Le générateur de la série, avancé d'un saut par bloc de PARTIES_PAR_FLUX parties
+ * @param resultats Les résultats agrégés, complétés avec les parties de la série
+ * @return true si la série a été jouée
+ * @return false si la mémoire manque pour les lots de simuler_parties_lots
+ * 
+ * Chaque bloc de PARTIES_PAR_FLUX parties utilise son propre flux du générateur. Une stratégie qui décide par lots
+ * joue ses parties avec simuler_parties_lots.
+ */
+bool simuler_serie(long nombre, t_strategie *instance, t_generateur *flux, t_resultats *resultats) {
+    t_partie contexte;
+    t_score scores;
+    int total;
+
+    if (instance->choisir_relances != NULL && instance->choisir_combinaisons != NULL) {
+        return simuler_parties_lots(nombre, instance, flux, resultats);
+    }
+
+    for (long partie = 0; partie < nombre; partie++) {
+        if (partie % PARTIES_PAR_FLUX == 0) {
+            contexte.generateur = *flux;
+            sauter_generateur(flux);
+        }
+
+        total = jouer_partie(instance, &contexte, scores);
+        compter_resultat(resultats, scores, total);
+    }
+
+    return true;
+}
+
+/**
+ * @fn bool simuler_parties(long nombre, t_strategie *strategie, uint64_t graine, t_resultats *resultats)
+ * 
+ * @brief Cette fonction simule une série de parties complètes jouées par une stratégie
+ * 
+ * @param nombre Le nombre de parties à jouer
+ * @param strategie La stratégie qui prend les décisions
+ * @param graine La graine du générateur, deux appels avec la même graine jouent les mêmes parties
+ * @param resultats Les résultats agrégés de la série
+ * @return true si la série a été jouée
+ * @return false si la mémoire manque pour instancier la stratégie ou pour ses lots de décisions
+ * 
+ * Consiste à enchaîner les parties sans aucune entrée / sortie au terminal, pour évaluer une stratégie ou
+ * l'équilibre des règles sur un grand nombre de parties. La table des points doit avoir été initialisée.
+ */
+bool simuler_parties(long nombre, t_strategie *strategie, uint64_t graine, t_resultats *resultats) {
+    t_strategie instance;
+    t_generateur flux;
+    bool reussite;
+
+    memset(resultats, 0, sizeof(*resultats));
+    if (!instancier_strategie(strategie, &instance)) {
+        return false;
+    }
+    initialiser_generateur(&flux, graine);
+
+    reussite = simuler_serie(nombre, &instance, &flux, resultats);
+
+    liberer_instance(&instance);
+    return reussite;
+}
+
+/**
+ * @fn int glouton_choisir_relance(t_des des, t_score scores, int relances_restantes, void *contexte)
+ * 
+ * @brief Cette fonction est la décision de relance de la stratégie gloutonne
+ * 
+ * @param des Les 5 dés du joueur
+ * @param scores La feuille de score
+ * @param relances_restantes Le nombre de relances encore possibles
+ * @param contexte Inutilisé
+ * @return int le masque des dés à relancer
+ * 
+ * Garde une Grande suite ou un Yams encore libres, sinon garde les dés de la face la plus fréquente
+ * (la plus haute en cas d'égalité) et relance les autres
+ */
+int glouton_choisir_relance(t_des des, t_score scores, int relances_restantes, void *contexte) {
+    int occurences[NOMBRE_FACES];
+    int face;
+    int masque;
+    int combinaisons;
+
+    (void) relances_restantes;
+    (void) contexte;
+
+    combinaisons = TABLE_POINTS[indice_main(des)].combinaisons;
+    if ((scores[10] == -1 && (combinaisons & (1 << 10))) || (scores[11] == -1 && (combinaisons & (1 << 11)))) {
+        return 0;
+    }
+
+    compter_des(des, occurences);
+    face = NOMBRE_FACES - 1;
+    for (int i = NOMBRE_FACES - 2; i >= 0; i--) {
+        if (occurences[i] > occurences[face]) {
+            face = i;
+        }
+    }
+
+    masque = 0;
+    for (int i = 0; i < NOMBRE_DES; i++) {
+        if (des[i] != face + 1) {
+            masque = masque | (1 << i);
+        }
+    }
+
+    return masque;
+}
+
+/**
+ * @fn int glouton_choisir_combinaison(t_des des, t_score scores, void *contexte)
+ * 
+ * @brief Cette fonction est le choix de combinaison de la stratégie gloutonne
+ * 
+ * @param des Les 5 dés du joueur
+ * @param scores La feuille de score
+ * @param contexte Inutilisé
+ * @return int l'indice de la case libre qui rapporte le plus de points (la première en cas d'égalité)
+ */
+int glouton_choisir_combinaison(t_des des, t_score scores, void *contexte) {
+    t_ligne_points *ligne;
+    int meilleure;
+    int meilleurs_points;
+    int points;
+
+    (void) contexte;
+
+    ligne = &TABLE_POINTS[indice_main(des)];
+    meilleure = -1;
+    meilleurs_points = -1;
+
+    for (int i = 0; i < 13; i++) {
+        if (scores[i] == -1) {
+            points = ligne->points[i];
+            if (points > meilleurs_points) {
+                meilleure = i;
+                meilleurs_points = points;
+            }
+        }
+    }
+
+    return meilleure;
+}
+
+/**
+ * @brief La stratégie gloutonne fournie avec le moteur de simulation
+ * 
+ */
+t_strategie STRATEGIE_GLOUTONNE = {
+    "glouton", glouton_choisir_relance, glouton_choisir_combinaison, NULL, NULL, NULL, NULL, NULL
+};
+
+/**
+ * @fn int sans_relance_choisir_relance(t_des des, t_score scores, int relances_restantes, void *contexte)
+ * 
+ * @brief Cette fonction est la décision de relance de la stratégie sans relance, qui garde toujours ses dés
+ * 
+ * @param des Les 5 dés du joueur
+ * @param scores La feuille de score
+ * @param relances_restantes Le nombre de relances encore possibles
+ * @param contexte Inutilisé
+ * @return int 0, aucun dé n'est relancé
+ */
+int sans_relance_choisir_relance(t_des des, t_score scores, int relances_restantes, void *contexte) {
+    (void) des;
+    (void) scores;
+    (void) relances_restantes;
+    (void) contexte;
+
+    return 0;
+}
+
+/**
+ * @brief La stratégie de référence qui ne relance jamais et valide la case qui rapporte le plus
+ * 
+ */
+t_strategie STRATEGIE_SANS_RELANCE = {
+    "sans-relance", sans_relance_choisir_relance, glouton_choisir_combinaison, NULL, NULL, NULL, NULL, NULL
+};
+
+/**
+ * @fn double secondes_ecoulees(void)
+ * 
+ * @brief Cette fonction renvoie le temps d'une horloge monotone, en secondes
+ * 
+ * @return double le nombre de secondes depuis une origine arbitraire
+ */
+double secondes_ecoulees(void) {
+    struct timespec instant;
+
+    clock_gettime(CLOCK_MONOTONIC, &instant);
+    return instant.tv_sec + instant.tv_nsec / 1e9;
+}
+
+/*********************************
+ *    STATISTIQUES PARALLÈLES    *
+ *********************************/
+
+/**
+ * @brief Raccourci associé au nombre de flux consécutifs d'une tranche de parties
+ * 
+ */
+#define FLUX_PAR_TRANCHE 16
+
+/**
+ * @brief Représente le travail partagé entre les threads d'une simulation parallèle
+ * 
+ * Les parties sont découpées en tranches de FLUX_PAR_TRANCHE flux de PARTIES_PAR_FLUX parties ; le thread t joue
+ * les tranches t, t + nombre_threads, t + 2 * nombre_threads... depart est le flux de la première tranche.
+ * Un thread qui manque de mémoire le signale dans manque_memoire et s'arrête, sans jouer ses tranches.
+ * 
+ */
+typedef struct {
+    t_strategie *strategie;
+    long nombre;
+    t_generateur depart;
+    int nombre_threads;
+    atomic_int threads_termines;
+    atomic_bool manque_memoire;
+} t_travail_statistiques;
+
+/**
+ * @brief Représente un thread d'une simulation parallèle, avec ses résultats privés
+ * 
+ * Seul le thread écrit dans ses résultats, sans verrou ni opération atomique ; il publie à la fin de chaque
+ * tranche son nombre de parties et la somme de ses totaux dans deux compteurs atomiques, lus pour afficher la
+ * progression. Chaque thread est alloué sur ses propres lignes de cache.
+ * 
+ */
+typedef struct {
+    t_travail_statistiques *travail;
+    int numero;
+    atomic_long parties;
+    atomic_llong somme_scores;
+    t_resultats resultats;
+} t_thread_statistiques;
+
+/**
+ * @fn void *executer_statistiques(void *argument)
+ * 
+ * @brief Cette fonction est exécutée par chaque thread d'une simulation parallèle
+ * 
+ * @param argument Le t_thread_statistiques du thread
+ * @return void* NULL
+ * 
+ * Le flux de chaque tranche est atteint par des sauts du générateur, sans dépendre des autres threads : les
+ * parties jouées sont celles de simuler_parties avec la même graine, quel que soit le nombre de threads
+ */
+void *executer_statistiques(void *argument) {
+    t_thread_statistiques *thread;
+    t_travail_statistiques *travail;
+    t_strategie instance;
+    t_generateur flux;
+    long taille_tranche;
+    bool manque;
+
+    thread = argument;
+    travail = thread->travail;
+    taille_tranche = (long) FLUX_PAR_TRANCHE * PARTIES_PAR_FLUX;
+
+    if (!instancier_strategie(travail->strategie, &instance)) {
+        atomic_store_explicit(&travail->manque_memoire, true, memory_order_relaxed);
+        atomic_fetch_add_explicit(&travail->threads_termines, 1, memory_order_release);
+        return NULL;
+    }
+    flux = travail->depart;
+    for (int s = 0; s < thread->numero * FLUX_PAR_TRANCHE; s++) {
+        sauter_generateur(&flux);
+    }
+
+    manque = false;
+    for (long debut = thread->numero * taille_tranche; debut < travail->nombre && !manque;
+         debut = debut + travail->nombre_threads * taille_tranche) {
+        manque = !simuler_serie(travail->nombre - debut < taille_tranche ? travail->nombre - debut : taille_tranche,
+                                &instance, &flux, &thread->resultats);
+        atomic_store_explicit(&thread->parties, thread->resultats.nombre_parties, memory_order_relaxed);
+        atomic_store_explicit(&thread->somme_scores, thread->resultats.somme_scores, memory_order_relaxed);
+
+        for (int s = 0; s < (travail->nombre_threads - 1) * FLUX_PAR_TRANCHE; s++) {
+            sauter_generateur(&flux);
+        }
+    }
+    if (manque) {
+        atomic_store_explicit(&travail->manque_memoire, true, memory_order_relaxed);
+    }
+
+    liberer_instance(&instance);
+    atomic_fetch_add_explicit(&travail->threads_termines, 1, memory_order_release);
+    return NULL;
+}
+
+/**
+ * @fn void afficher_progression(long parties, long long somme, long nombre, long parties_initiales, double duree)
+ * 
+ * @brief Cette procédure affiche sur la sortie d'erreur la progression d'une longue simulation, sur une seule ligne
+ * 
+ * @param parties Le nombre de parties déjà jouées
+ * @param somme La somme de leurs totaux
+ * @param nombre Le nombre de parties à jouer
+ * @param parties_initiales Le nombre de parties déjà jouées au début de la mesure, reprises d'une autre exécution
+ * @param duree Le temps écoulé depuis le début de la mesure, en secondes
+ */
+void afficher_progression(long parties, long long somme, long nombre, long parties_initiales, double duree) {
+    double vitesse;
+
+    vitesse = (parties - parties_initiales) / duree;
+    fprintf(stderr, "\r%5.1f %% : %ld parties, moyenne %.2f, %.0f parties/s, reste %.0f s   ",
+            100.0 * parties / nombre, parties, parties > 0 ? (double) somme / parties : 0.0, vitesse,
+            vitesse > 0 ? (nombre - parties) / vitesse : 0.0);
+}
+
+/**
+ * @fn bool simuler_flux_paralleles(long nombre, t_strategie *strategie, const t_generateur *depart,
+ *                                  int nombre_threads, bool progression, t_resultats *resultats)
+ * 
+ * @brief Cette fonction simule une série de parties réparties entre plusieurs threads, à partir d'un flux
+ * 
+ * @param nombre Le nombre de parties à jouer
+ * @param strategie La stratégie qui prend les décisions, instanciée par chaque thread
+ * @param depart Le flux du premier bloc de la série, le bloc b utilisant le flux obtenu après b sauts
+ * @param nombre_threads Le nombre de threads
+ * @param progression Vrai pour afficher chaque seconde la progression sur la sortie d'erreur
+ * @param resultats Les résultats agrégés de la série, les mêmes que ceux de simuler_serie avec ce flux
+ * @return true si toute la série a été jouée
+ * @return false si un thread a manqué de mémoire, les résultats étant alors incomplets
+ * 
+ * Les résultats privés des threads ne sont additionnés qu'après la fin des threads ; pendant la simulation, seuls
+ * leurs compteurs de progression sont lus
+ */
+bool simuler_flux_paralleles(long nombre, t_strategie *strategie, const t_generateur *depart, int nombre_threads,
+                             bool progression, t_resultats *resultats) {
+    t_travail_statistiques travail;
+    t_thread_statistiques **threads;
+    pthread_t *identifiants;
+    struct timespec attente;
+    double debut;
+    double affichage;
+
+    travail.strategie = strategie;
+    travail.nombre = nombre;
+    travail.depart = *depart;
+    travail.nombre_threads = nombre_threads;
+    atomic_init(&travail.threads_termines, 0);
+    atomic_init(&travail.manque_memoire, false);
+
+    threads = malloc(nombre_threads * sizeof(t_thread_statistiques *));
+    identifiants = malloc(nombre_threads * sizeof(pthread_t));
+    for (int t = 0; t < nombre_threads; t++) {
+        threads[t] = aligned_alloc(64, (sizeof(t_thread_statistiques) + 63) / 64 * 64);
+        memset(threads[t], 0, sizeof(t_thread_statistiques));
+        threads[t]->travail = &travail;
+        threads[t]->numero = t;
+        atomic_init(&threads[t]->parties, 0);
+        atomic_init(&threads[t]->somme_scores, 0);
+        pthread_create(&identifiants[t], NULL, executer_statistiques, threads[t]);
+    }
+
+    debut = secondes_ecoulees();
+    affichage = debut;
+    attente.tv_sec = 0;
+    attente.tv_nsec = 100000000;
+    while (progression && atomic_load_explicit(&travail.threads_termines, memory_order_acquire) < nombre_threads) {
+        nanosleep(&attente, NULL);
+        if (secondes_ecoulees() - affichage >= 1.0) {
+            long parties;
+            long long somme;
+
+            parties = 0;
+            somme = 0;
+            for (int t = 0; t < nombre_threads; t++) {
+                parties = parties + atomic_load_explicit(&threads[t]->parties, memory_order_relaxed);
+                somme = somme + atomic_load_explicit(&threads[t]->somme_scores, memory_order_relaxed);
+            }
+            affichage = secondes_ecoulees();
+            afficher_progression(parties, somme, nombre, 0, affichage - debut);
+        }
+    }
+    if (progression) {
+        fprintf(stderr, "\n");
+    }
+
+    memset(resultats, 0, sizeof(*resultats));
+    for (int t = 0; t < nombre_threads; t++) {
+        pthread_join(identifiants[t], NULL);
+        fusionner_resultats(resultats, &threads[t]->resultats);
+        free(threads[t]);
+    }
+
+    free(identifiants);
+    free(threads);
+    return !atomic_load_explicit(&travail.manque_memoire, memory_order_relaxed);
+}
+
+/**
+ * @fn bool simuler_parties_paralleles(long nombre, t_strategie *strategie, uint64_t graine, int nombre_threads,
+ *                                     bool progression, t_resultats *resultats)
+ * 
+ * @brief Cette fonction simule une série de parties réparties entre plusieurs threads
+ * 
+ * @param nombre Le nombre de parties à jouer
+ * @param strategie La stratégie qui prend les décisions, instanciée par chaque thread
+ * @param graine La graine du générateur
+ * @param nombre_threads Le nombre de threads
+ * @param progression Vrai pour afficher chaque seconde la progression sur la sortie d'erreur
+ * @param resultats Les résultats agrégés de la série, les mêmes que ceux de simuler_parties
+ * @return true si toute la série a été jouée
+ * @return false si un thread a manqué de mémoire
+ */
+bool simuler_parties_paralleles(long nombre, t_strategie *strategie, uint64_t graine, int nombre_threads,
+                                bool progression, t_resultats *resultats) {
+    t_generateur depart;
+
+    initialiser_generateur(&depart, graine);
+    return simuler_flux_paralleles(nombre, strategie, &depart, nombre_threads, progression, resultats);
+}
+
+/**
+ * @fn int centile_resultats(const t_resultats *resultats, double proportion)
+ * 
+ * @brief Cette fonction donne un centile des totaux d'une série
+ * 
+ * @param resultats Les résultats de la série, au moins une partie
+ * @param proportion La proportion de parties, entre 0 et 1
+ * @return int le plus petit total atteint ou dépassé par au plus 1 - proportion des parties
+ */
+int centile_resultats(const t_resultats *resultats, double proportion) {
+    long cumul;
+    int score;
+
+    cumul = 0;
+    score = 0;
+    while (score < SCORE_MAXIMAL && cumul + resultats->histogramme[score] < proportion * resultats->nombre_parties) {
+        cumul = cumul + resultats->histogramme[score];
+        score = score + 1;
+    }
+
+    return score;
+}
+
+/**
+ * @brief Les centiles donnés dans les rapports de statistiques
+ * 
+ */
+const int CENTILES_RAPPORT[9] = {1, 5, 10, 25, 50, 75, 90, 95, 99};
+
+/**
+ * @fn void ecrire_chaine_json(FILE *fichier, const char *chaine)
+ * 
+ * @brief Cette procédure écrit une chaîne entre guillemets, en échappant les caractères réservés du JSON
+ * 
+ * @param fichier Le fichier
+ * @param chaine La chaîne
+ */
+void ecrire_chaine_json(FILE *fichier, const char *chaine) {
+    fputc('"', fichier);
+    for (const unsigned char *c = (const unsigned char *) chaine; *c != '\0'; c++) {
+        if (*c == '"' || *c == '\\') {
+            fprintf(fichier, "\\%c", *c);
+        }
+        else if (*c < 0x20) {
+            fprintf(fichier, "\\u%04x", *c);
+        }
+        else {
+            fputc(*c, fichier);
+        }
+    }
+    fputc('"', fichier);
+}
+
+/**
+ * @fn void ecrire_rapport_json(FILE *fichier, const char *strategie, uint64_t graine, double duree,
+ *                              const t_resultats *resultats)
+ * 
+ * @brief Cette procédure écrit le rapport d'une série de parties au format JSON
+ * 
+ * @param fichier Le fichier
+ * @param strategie Le nom de la stratégie
+ * @param graine La graine de la série
+ * @param duree La durée de la série, en secondes
+ * @param resultats Les résultats de la série, au moins une partie
+ * 
+ * L'histogramme ne contient que les totaux atteints, chacun sous la forme [total, parties]
+ */
+void ecrire_rapport_json(FILE *fichier, const char *strategie, uint64_t graine, double duree,
+                         const t_resultats *resultats) {
+    double n;
+    double moyenne;
+    bool premier;
+
+    n = resultats->nombre_parties;
+    moyenne = resultats->somme_scores / n;
+
+    fprintf(fichier, "{\n  \"strategie\": ");
+    ecrire_chaine_json(fichier, strategie);
+    fprintf(fichier, ",\n  \"graine\": %llu,\n  \"parties\": %ld,\n  \"duree\": %.3f,\n", (unsigned long long) graine,
+            resultats->nombre_parties, duree);
+    fprintf(fichier, "  \"moyenne\": %.4f,\n  \"ecart_type\": %.4f,\n  \"minimum\": %d,\n  \"maximum\": %d,\n",
+            moyenne, sqrt(resultats->somme_carres / n - moyenne * moyenne), resultats->score_min,
+            resultats->score_max);
+    fprintf(fichier, "  \"taux_bonus\": %.6f,\n  \"taux_yams\": %.6f,\n", resultats->nombre_bonus / n,
+            resultats->nombre_yams / n);
+
+    fprintf(fichier, "  \"centiles\": {");
+    for (int k = 0; k < 9; k++) {
+        fprintf(fichier, "%s\"%d\": %d", k > 0 ? ", " : "", CENTILES_RAPPORT[k],
+                centile_resultats(resultats, CENTILES_RAPPORT[k] / 100.0));
+    }
+    fprintf(fichier, "},\n");
+
+    fprintf(fichier, "  \"combinaisons\": [\n");
+    for (int c = 0; c < 13; c++) {
+        fprintf(fichier, "    {\"nom\": ");
+        ecrire_chaine_json(fichier, NOMS_COMBINAISONS[c]);
+        fprintf(fichier, ", \"points_moyens\": %.4f, \"taux_reussite\": %.6f}%s\n", resultats->points[c] / n,
+                resultats->reussites[c] / n, c < 12 ? "," : "");
+    }
+    fprintf(fichier, "  ],\n");
+
+    fprintf(fichier, "  \"histogramme\": [");
+    premier = true;
+    for (int score = 0; score <= SCORE_MAXIMAL; score++) {
+        if (resultats->histogramme[score] > 0) {
+            fprintf(fichier, "%s[%d, %ld]", premier ? "" : ", ", score, resultats->histogramme[score]);
+            premier = false;
+        }
+    }
+    fprintf(fichier, "]\n}\n");
+}
+
+/**
+ * @fn void ecrire_rapport_csv(FILE *fichier, const char *strategie, uint64_t graine, double duree,
+ *                             const t_resultats *resultats)
+ * 
+ * @brief Cette procédure écrit le rapport d'une série de parties au format CSV
+ * 
+ * @param fichier Le fichier
+ * @param strategie Le nom de la stratégie
+ * @param graine La graine de la série
+ * @param duree La durée de la série, en secondes
+ * @param resultats Les résultats de la série, au moins une partie
+ * 
+ * Le rapport est une table à deux colonnes mesure,valeur : les mesures globales, les centiles centile_k, les
+ * points moyens et taux de réussite de chaque combinaison, puis l'histogramme sous la forme total_k
+ */
+void ecrire_rapport_csv(FILE *fichier, const char *strategie, uint64_t graine, double duree,
+                        const t_resultats *resultats) {
+    double n;
+    double moyenne;
+
+    n = resultats->nombre_parties;
+    moyenne = resultats->somme_scores / n;
+
+    fprintf(fichier, "mesure,valeur\n");
+    fprintf(fichier, "strategie,\"");
+    for (const char *c = strategie; *c != '\0'; c++) {
+        fprintf(fichier, *c == '"' ? "\"\"" : "%c", *c);
+    }
+    fprintf(fichier, "\"\n");
+    fprintf(fichier, "graine,%llu\nparties,%ld\nduree,%.3f\n", (unsigned long long) graine, resultats->nombre_parties,
+            duree);
+    fprintf(fichier, "moyenne,%.4f\necart_type,%.4f\nminimum,%d\nmaximum,%d\n", moyenne,
+            sqrt(resultats->somme_carres / n - moyenne * moyenne), resultats->score_min, resultats->score_max);
+    fprintf(fichier, "taux_bonus,%.6f\ntaux_yams,%.6f\n", resultats->nombre_bonus / n, resultats->nombre_yams / n);
+
+    for (int k = 0; k < 9; k++) {
+        fprintf(fichier, "centile_%d,%d\n", CENTILES_RAPPORT[k], centile_resultats(resultats, CENTILES_RAPPORT[k] / 100.0));
+    }
+    for (int c = 0; c < 13; c++) {
+        fprintf(fichier, "\"points_moyens %s\",%.4f\n", NOMS_COMBINAISONS[c], resultats->points[c] / n);
+        fprintf(fichier, "\"taux_reussite %s\",%.6f\n", NOMS_COMBINAISONS[c], resultats->reussites[c] / n);
+    }
+    for (int score = 0; score <= SCORE_MAXIMAL; score++) {
+        if (resultats->histogramme[score] > 0) {
+            fprintf(fichier, "total_%d,%ld\n", score, resultats->histogramme[score]);
+        }
+    }
+}
+
+/*********************************
+ *      STRATÉGIE OPTIMALE       *
+ *********************************/
+
+/**
+ * @brief Indique pour chaque masque des 6 combinaisons supérieures remplies quels totaux plafonnés sont atteignables
+ * 
+ */
+bool TOTAUX_ATTEIGNABLES[64][64];
+
+/**
+ * @fn double valeur_combinaison(const double *esperances, int masque, int total_sup, int combinaison, int points)
+ * 
+ * @brief Cette fonction donne la valeur de la validation d'une combinaison
+ * 
+ * @param esperances La table des espérances des états
+ * @param masque Le masque des combinaisons remplies avant la validation
+ * @param total_sup Le total plafonné de la partie supérieure avant la validation
+ * @param combinaison L'indice de la combinaison validée
+ * @param points Les points marqués dans la combinaison
+ * @return double les points marqués, plus le bonus s'il est atteint par ce coup, plus l'espérance de l'état suivant
+ */
+double valeur_combinaison(const double *esperances, int masque, int total_sup, int combinaison, int points) {
+    int total_suivant;
+    double valeur;
+
+    valeur = points;
+    total_suivant = total_sup;
+
+    if (combinaison < 6) {
+        total_suivant = total_sup + points;
+        if (total_suivant > 63) {
+            total_suivant = 63;
+        }
+        if (total_sup < 63 && total_suivant == 63) {
+            valeur = valeur + 35;
+        }
+    }
+
+    return valeur + esperances[INDICE_ETAT(masque | (1 << combinaison), total_suivant)];
+}
+
+/**
+ * @fn void propager_valeurs_tour(t_valeurs_tour *valeurs)
+ * 
+ * @brief Cette procédure calcule les valeurs des gardes et des mains avec relances à partir des mains sans relance
+ * 
+ * @param valeurs Les valeurs du tour, dont mains[0] est rempli
+ * 
+ * Ne dépend pas de ce que mesurent les valeurs : une garde vaut toujours la moyenne de ses suites et une main la
+ * meilleure de ses gardes.
+ */
+void propager_valeurs_tour(t_valeurs_tour *valeurs) {
+    for (int r = 1; r <= NOMBRE_RELANCES; r++) {
+        double *gardes;
+
+        gardes = valeurs->gardes[r];
+
+        for (int g = NOMBRE_GARDES - 1; g >= 0; g--) {
+            if (TAILLE_GARDE[g] == NOMBRE_DES) {
+                gardes[g] = valeurs->mains[r - 1][MAIN_PAR_GARDE[g]];
+            }
+            else {
+                double somme;
+
+                somme = 0.0;
+                DEROULER
+                for (int f = 0; f < NOMBRE_FACES; f++) {
+                    somme = somme + gardes[GARDE_PLUS_FACE[g][f]];
+                }
+                gardes[g] = somme / NOMBRE_FACES;
+            }
+        }
+
+        for (int m = 0; m < NOMBRE_MAINS; m++) {
+            double meilleure;
+
+            meilleure = gardes[GARDES_PAR_MAIN[m][0]];
+            for (int k = 1; k < NOMBRE_GARDES_PAR_MAIN[m]; k++) {
+                if (gardes[GARDES_PAR_MAIN[m][k]] > meilleure) {
+                    meilleure = gardes[GARDES_PAR_MAIN[m][k]];
+                }
+            }
+            valeurs->mains[r][m] = meilleure;
+        }
+    }
+}
+
+/**
+ * @fn void calculer_valeurs_tour(const double *esperances, int masque, int total_sup, t_valeurs_tour *valeurs)
+ * 
+ * @brief Cette procédure calcule les valeurs de toutes les mains et de toutes les gardes pour un tour
+ * 
+ * @param esperances La table des espérances, remplie pour tous les états qui ont une combinaison de plus
+ * @param masque Le masque des combinaisons remplies au début du tour
+ * @param total_sup Le total plafonné de la partie supérieure au début du tour
+ * @param valeurs Les valeurs du tour
+ * 
+ * Sans relance, une main vaut la meilleure validation possible. Une garde vaut la moyenne des gardes qui ont un dé
+ * de plus (une garde de 5 dés vaut la main qu'elle forme au niveau de relance inférieur), et une main vaut la
+ * meilleure des gardes qu'elle permet, y compris la garde de tous les dés qui revient à ne pas relancer.
+ */
+void calculer_valeurs_tour(const double *esperances, int masque, int total_sup, t_valeurs_tour *valeurs) {
+    double suite[13][NOMBRE_DES + 1];
+
+    for (int c = 0; c < 13; c++) {
+        if (!(masque & (1 << c))) {
+            for (int n = 0; n <= NOMBRE_DES; n++) {
+                suite[c][n] = valeur_combinaison(esperances, masque, total_sup, c, c < 6 ? n * (c + 1) : 0);
+            }
+        }
+    }
+
+    for (int m = 0; m < NOMBRE_MAINS; m++) {
+        double meilleure;
+        double valeur;
+
+        meilleure = -1.0;
+        for (int c = 0; c < 13; c++) {
+            if (!(masque & (1 << c))) {
+                if (c < 6) {
+                    valeur = suite[c][TABLE_POINTS[m].points[c] / (c + 1)];
+                }
+                else {
+                    valeur = TABLE_POINTS[m].points[c] + suite[c][0];
+                }
+                if (valeur > meilleure) {
+                    meilleure = valeur;
+                }
+            }
+        }
+        valeurs->mains[0][m] = meilleure;
+    }
+
+    propager_valeurs_tour(valeurs);
+}
+
+/**
+ * @fn double esperance_tour(t_valeurs_tour *valeurs)
+ * 
+ * @brief Cette fonction donne l'espérance d'un état au début d'un tour, avant le premier lancer
+ * 
+ * @param valeurs Les valeurs du tour, calculées par calculer_valeurs_tour
+ * @return double la moyenne des valeurs des mains avec toutes les relances, pondérée par leur probabilité
+ */
+double esperance_tour(t_valeurs_tour *valeurs) {
+    double somme;
+
+    somme = 0.0;
+    for (int m = 0; m < NOMBRE_MAINS; m++) {
+        somme = somme + LANCERS_PAR_MAIN[m] * valeurs->mains[NOMBRE_RELANCES][m];
+    }
+
+    return somme / NOMBRE_LANCERS;
+}
+
+/**
+ * @fn void initialiser_totaux_atteignables(void)
+ * 
+ * @brief Cette procédure détermine quels totaux de la partie supérieure sont atteignables
+ * 
+ * Un total est atteignable pour un ensemble de combinaisons supérieures remplies s'il est la somme, plafonnée à 63,
+ * de 0 à 5 dés de chacune des faces correspondantes. Le solveur ignore les autres états.
+ */
+void initialiser_totaux_atteignables(void) {
+    for (int masque_sup = 0; masque_sup < 64; masque_sup++) {
+        for (int total = 0; total < 64; total++) {
+            TOTAUX_ATTEIGNABLES[masque_sup][total] = false;
+        }
+        TOTAUX_ATTEIGNABLES[masque_sup][0] = true;
+
+        for (int c = 0; c < 6; c++) {
+            if (masque_sup & (1 << c)) {
+                bool suivants[64];
+
+                for (int total = 0; total < 64; total++) {
+                    suivants[total] = false;
+                }
+                for (int total = 0; total < 64; total++) {
+                    if (TOTAUX_ATTEIGNABLES[masque_sup][total]) {
+                        for (int n = 0; n <= NOMBRE_DES; n++) {
+                            int suivant;
+
+                            suivant = total + n * (c + 1);
+                            suivants[suivant > 63 ? 63 : suivant] = true;
+                        }
+                    }
+                }
+                for (int total = 0; total < 64; total++) {
+                    TOTAUX_ATTEIGNABLES[masque_sup][total] = suivants[total];
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Représente le travail partagé entre les threads du solveur pour un niveau de remplissage
+ * 
+ */
+typedef struct {
+    double *esperances;
+    int niveau;
+    atomic_int prochain_masque;
+    atomic_long nombre_etats;
+} t_travail_solveur;
+
+/**
+ * @fn void *resoudre_niveau(void *argument)
+ * 
+ * @brief Cette fonction est exécutée par chaque thread du solveur
+ * 
+ * @param argument Le travail partagé, de type t_travail_solveur
+ * @return void* NULL
+ * 
+ * Consiste à prendre un à un les masques qui comptent niveau combinaisons remplies, jusqu'à épuisement, et à
+ * calculer l'espérance de chacun de leurs états atteignables. Ces états ne dépendent que du niveau supérieur,
+ * déjà résolu, donc les threads n'écrivent jamais dans les mêmes cases et ne lisent que des cases terminées.
+ */
+void *resoudre_niveau(void *argument) {
+    t_travail_solveur *travail;
+    t_valeurs_tour *valeurs;
+    int masque;
+    long nombre_etats;
+
+    travail = argument;
+    valeurs = malloc(sizeof(t_valeurs_tour));
+    nombre_etats = 0;
+
+    masque = atomic_fetch_add(&travail->prochain_masque, 1);
+    while (masque < 8192) {
+        if (__builtin_popcount(masque) == travail->niveau) {
+            for (int total_sup = 0; total_sup < 64; total_sup++) {
+                double esperance;
+
+                esperance = 0.0;
+                if (TOTAUX_ATTEIGNABLES[masque & 63][total_sup]) {
+                    calculer_valeurs_tour(travail->esperances, masque, total_sup, valeurs);
+                    esperance = esperance_tour(valeurs);
+                    nombre_etats = nombre_etats + 1;
+                }
+                travail->esperances[INDICE_ETAT(masque, total_sup)] = esperance;
+            }
+        }
+        masque = atomic_fetch_add(&travail->prochain_masque, 1);
+    }
+
+    atomic_fetch_add(&travail->nombre_etats, nombre_etats);
+    free(valeurs);
+    return NULL;
+}
+
+/**
+ * @fn long resoudre_strategie(double *esperances, int nombre_threads)
+ * 
+ * @brief Cette fonction calcule l'espérance de points restants de chaque état, en jouant de façon optimale
+ * 
+ * @param esperances La table des NOMBRE_ETATS espérances à remplir, indicée par INDICE_ETAT
+ * @param nombre_threads Le nombre de threads de calcul
+ * @return long le nombre d'états atteignables résolus
+ * 
+ * Consiste à remonter les niveaux de remplissage de la feuille, de la feuille pleine (espérance nulle) jusqu'à la
+ * feuille vide, chaque niveau étant réparti entre les threads. L'espérance d'une partie complète est celle de
+ * l'état INDICE_ETAT(0, 0). Les tables des points et des gardes doivent avoir été initialisées.
+ */
+long resoudre_strategie(double *esperances, int nombre_threads) {
+    t_travail_solveur travail;
+    pthread_t threads[nombre_threads];
+
+    initialiser_totaux_atteignables();
+
+    for (int total_sup = 0; total_sup < 64; total_sup++) {
+        esperances[INDICE_ETAT(8191, total_sup)] = 0.0;
+    }
+
+    travail.esperances = esperances;
+    atomic_init(&travail.nombre_etats, 0);
+
+    for (int niveau = 12; niveau >= 0; niveau--) {
+        travail.niveau = niveau;
+        atomic_init(&travail.prochain_masque, 0);
+
+        for (int t = 0; t < nombre_threads; t++) {
+            pthread_create(&threads[t], NULL, resoudre_niveau, &travail);
+        }
+        for (int t = 0; t < nombre_threads; t++) {
+            pthread_join(threads[t], NULL);
+        }
+    }
+
+    return atomic_load(&travail.nombre_etats);
+}
+
+/**
+ * @fn int meilleure_garde(t_valeurs_tour *valeurs, t_des des, int relances_restantes)
+ * 
+ * @brief Cette fonction choisit les dés à garder pour maximiser l'espérance
+ * 
+ * @param valeurs Les valeurs du tour
+ * @param des Les 5 dés du joueur
+ * @param relances_restantes Le nombre de relances encore possibles, au moins 1
+ * @return int le masque des dés à garder, MASQUE_DES pour ne pas relancer
+ */
+int meilleure_garde(t_valeurs_tour *valeurs, t_des des, int relances_restantes) {
+    int meilleure;
+    double meilleure_valeur;
+    double valeur;
+
+    meilleure = MASQUE_DES;
+    meilleure_valeur = valeurs->gardes[relances_restantes][INDICE_PAR_HISTOGRAMME[code_histogramme(des, MASQUE_DES)]];
+
+    for (int masque = 0; masque < MASQUE_DES; masque++) {
+        valeur = valeurs->gardes[relances_restantes][INDICE_PAR_HISTOGRAMME[code_histogramme(des, masque)]];
+        if (valeur > meilleure_valeur) {
+            meilleure = masque;
+            meilleure_valeur = valeur;
+        }
+    }
+
+    return meilleure;
+}
+
+/**
+ * @fn int meilleure_combinaison(const double *esperances, t_des des, t_score scores)
+ * 
+ * @brief Cette fonction choisit la combinaison à valider pour maximiser l'espérance
+ * 
+ * @param esperances La table des espérances des états
+ * @param des Les 5 dés du joueur
+ * @param scores La feuille de score
+ * @return int l'indice de la meilleure combinaison libre
+ */
+int meilleure_combinaison(const double *esperances, t_des des, t_score scores) {
+    t_ligne_points *ligne;
+    t_etat_joueur etat;
+    int masque;
+    int total_sup;
+    int meilleure;
+    double meilleure_valeur;
+    double valeur;
+
+    etat = resumer_feuille(scores);
+    masque = ETAT_MASQUE(etat);
+    total_sup = ETAT_SUP_PLAFONNE(etat);
+    ligne = &TABLE_POINTS[indice_main(des)];
+    meilleure = -1;
+    meilleure_valeur = -1.0;
+
+    for (int c = 0; c < 13; c++) {
+        if (!(masque & (1 << c))) {
+            valeur = valeur_combinaison(esperances, masque, total_sup, c, ligne->points[c]);
+            if (valeur > meilleure_valeur) {
+                meilleure = c;
+                meilleure_valeur = valeur;
+            }
+        }
+    }
+
+    return meilleure;
+}
+
+/**
+ * @fn int optimal_choisir_relance(t_des des, t_score scores, int relances_restantes, void *contexte)
+ * 
+ * @brief Cette fonction est la décision de relance de la stratégie optimale
+ * 
+ * @param des Les 5 dés du joueur
+ * @param scores La feuille de score
+ * @param relances_restantes Le nombre de relances encore possibles
+ * @param contexte Le contexte de la stratégie, de type t_contexte_optimal
+ * @return int le masque des dés à relancer
+ */
+int optimal_choisir_relance(t_des des, t_score scores, int relances_restantes, void *contexte) {
+    t_contexte_optimal *optimal;
+    t_etat_joueur etat;
+
+    optimal = contexte;
+    etat = resumer_feuille(scores);
+
+    if (optimal->etat != ETAT_CLE_SOLVEUR(etat)) {
+        calculer_valeurs_tour(optimal->esperances, ETAT_MASQUE(etat), ETAT_SUP_PLAFONNE(etat), &optimal->valeurs);
+        optimal->etat = ETAT_CLE_SOLVEUR(etat);
+    }
+
+    return ~meilleure_garde(&optimal->valeurs, des, relances_restantes) & MASQUE_DES;
+}
+
+/**
+ * @fn void *creer_contexte_optimal(void *esperances)
+ * 
+ * @brief Cette fonction crée le contexte d'une instance de la stratégie optimale
+ * 
+ * @param esperances La table des espérances, partagée en lecture seule par toutes les instances
+ * @return void* le contexte, de type t_contexte_optimal, à libérer avec free, NULL si la mémoire manque
+ */
+void *creer_contexte_optimal(void *esperances) {
+    t_contexte_optimal *optimal;
+
+    optimal = malloc(sizeof(t_contexte_optimal));
+    if (optimal == NULL) {
+        return NULL;
+    }
+    optimal->esperances = esperances;
+    optimal->etat = -1;
+
+    return optimal;
+}
+
+/**
+ * @fn int optimal_choisir_combinaison(t_des des, t_score scores, void *contexte)
+ * 
+ * @brief Cette fonction est le choix de combinaison de la stratégie optimale
+ * 
+ * @param des Les 5 dés du joueur
+ * @param scores La feuille de score
+ * @param contexte Le contexte de la stratégie, de type t_contexte_optimal
+ * @return int l'indice de la combinaison qui maximise l'espérance
+ */
+int optimal_choisir_combinaison(t_des des, t_score scores, void *contexte) {
+    t_contexte_optimal *optimal;
+
+    optimal = contexte;
+    return meilleure_combinaison(optimal->esperances, des, scores);
+}
+
+/**
+ * @fn int enregistrer_strategies(t_strategie strategies[NOMBRE_STRATEGIES_MAX], const double *esperances)
+ * 
+ * @brief Cette fonction donne la liste des stratégies disponibles pour les simulations et les tournois
+ * 
+ * @param strategies Les stratégies enregistrées
+ * @param esperances La table des espérances, NULL si elle n'est pas disponible
+ * @return int le nombre de stratégies, la stratégie optimale n'étant enregistrée qu'avec une table
+ */
+int enregistrer_strategies(t_strategie strategies[NOMBRE_STRATEGIES_MAX], const double *esperances) {
+    int nombre;
+
+    nombre = 0;
+    strategies[nombre] = STRATEGIE_GLOUTONNE;
+    nombre = nombre + 1;
+    strategies[nombre] = STRATEGIE_SANS_RELANCE;
+    nombre = nombre + 1;
+
+    if (esperances != NULL) {
+        strategies[nombre].nom = "optimal";
+        strategies[nombre].choisir_relance = optimal_choisir_relance;
+        strategies[nombre].choisir_combinaison = optimal_choisir_combinaison;
+        strategies[nombre].contexte = (void *) esperances;
+        strategies[nombre].creer_contexte = creer_contexte_optimal;
+        strategies[nombre].detruire_contexte = free;
+        strategies[nombre].choisir_relances = NULL;
+        strategies[nombre].choisir_combinaisons = NULL;
+        nombre = nombre + 1;
+    }
+
+    return nombre;
+}
+
+/*********************************
+ *    DISTRIBUTIONS DES SCORES   *
+ *********************************/
+
+/**
+ * @brief Raccourci associé au nombre de probabilités traitées ensemble par un vecteur
+ * 
+ */
+#define PROBABILITES_PAR_VECTEUR 4
+
+/**
+ * @brief Représente 4 probabilités traitées ensemble, dans un registre SSE2
+ * 
+ */
+typedef float t_probabilites __attribute__((vector_size(16)));
+
+/**
+ * @brief Représente le résultat d'une comparaison de deux t_probabilites, -1 pour vrai et 0 pour faux
+ * 
+ */
+typedef int32_t t_comparaison_probabilites __attribute__((vector_size(16)));
+
+/**
+ * @brief Indique pour chaque état où commence son vecteur de probabilités, en nombre de t_probabilites
+ * 
+ * Le vecteur de l'état INDICE_ETAT(masque, total_sup) s'arrête où commence celui de l'état suivant. Il couvre les
+ * points restants de 0 au maximum que l'état peut encore marquer, complétés par des zéros jusqu'à la fin du
+ * dernier t_probabilites. Les états inatteignables n'ont pas de vecteur.
+ * 
+ */
+uint32_t DEBUT_VECTEURS[NOMBRE_ETATS + 1];
+
+/**
+ * @brief Indique pour chaque main la garde qui conserve ses 5 dés
+ * 
+ */
+int16_t GARDE_COMPLETE[NOMBRE_MAINS];
+
+/**
+ * @brief Indique pour chaque main et chaque masque des dés gardés la garde obtenue
+ * 
+ */
+int16_t GARDE_PAR_MASQUE[NOMBRE_MAINS][NOMBRE_MASQUES];
+
+/**
+ * @brief Raccourci associé au nombre de décalages possibles d'un vecteur, un par nombre de points d'une validation
+ * 
+ */
+#define NOMBRE_DECALAGES (POINTS_COMBINAISON_MAX + 1)
+
+/**
+ * @brief Représente les vecteurs de probabilités d'un tour de jeu, pour un état de la feuille de score
+ * 
+ * Les vecteurs sont rangés les uns après les autres, blocs t_probabilites chacun. mains contient les mains au
+ * niveau de relance précédent puis au niveau courant, decales les vecteurs des états suivants décalés des points
+ * de chaque validation, calculés à la première validation qui les utilise.
+ * 
+ */
+typedef struct {
+    int blocs;
+    t_probabilites *mains[2];
+    t_probabilites *gardes;
+    t_probabilites *decales;
+    bool decale_calcule[13][NOMBRE_DECALAGES];
+} t_vecteurs_tour;
+
+/**
+ * @fn int points_restants_maximaux(int masque, int total_sup)
+ * 
+ * @brief Cette fonction donne le plus grand nombre de points qu'un état peut encore marquer, bonus compris
+ * 
+ * @param masque Le masque des combinaisons remplies
+ * @param total_sup Le total plafonné de la partie supérieure
+ * @return int le maximum des points restants
+ */
+int points_restants_maximaux(int masque, int total_sup) {
+    int points;
+    int points_sup;
+
+    points = 0;
+    points_sup = 0;
+    for (int c = 0; c < 13; c++) {
+        if (!(masque & (1 << c))) {
+            int maximum;
+
+            maximum = 0;
+            for (int m = 0; m < NOMBRE_MAINS; m++) {
+                if (TABLE_POINTS[m].points[c] > maximum) {
+                    maximum = TABLE_POINTS[m].points[c];
+                }
+            }
+            points = points + maximum;
+            if (c < 6) {
+                points_sup = points_sup + maximum;
+            }
+        }
+    }
+
+    if (total_sup < 63 && total_sup + points_sup >= 63) {
+        points = points + 35;
+    }
+
+    return points;
+}
+
+/**
+ * @fn uint32_t initialiser_vecteurs(void)
+ * 
+ * @brief Cette fonction place les vecteurs de probabilités de tous les états atteignables
+ * 
+ * @return uint32_t le nombre total de t_probabilites de la table
+ * 
+ * Remplit DEBUT_VECTEURS, GARDE_COMPLETE, GARDE_PAR_MASQUE et TOTAUX_ATTEIGNABLES. Le placement ne dépend que des règles, une table
+ * enregistrée se relit donc avec le placement recalculé.
+ */
+uint32_t initialiser_vecteurs(void) {
+    uint32_t debut;
+
+    initialiser_totaux_atteignables();
+
+    for (int g = 0; g < NOMBRE_GARDES; g++) {
+        if (TAILLE_GARDE[g] == NOMBRE_DES) {
+            GARDE_COMPLETE[MAIN_PAR_GARDE[g]] = g;
+        }
+    }
+    for (int m = 0; m < NOMBRE_MAINS; m++) {
+        for (int masque = 0; masque < NOMBRE_MASQUES; masque++) {
+            GARDE_PAR_MASQUE[m][masque] = INDICE_PAR_HISTOGRAMME[code_histogramme(MAINS[m], masque)];
+        }
+    }
+
+    debut = 0;
+    for (int masque = 0; masque < 8192; masque++) {
+        for (int total_sup = 0; total_sup < 64; total_sup++) {
+            DEBUT_VECTEURS[INDICE_ETAT(masque, total_sup)] = debut;
+            if (TOTAUX_ATTEIGNABLES[masque & 63][total_sup]) {
+                debut = debut + points_restants_maximaux(masque, total_sup) / PROBABILITES_PAR_VECTEUR + 1;
+            }
+        }
+    }
+    DEBUT_VECTEURS[NOMBRE_ETATS] = debut;
+
+    return debut;
+}
+
+/**
+ * @fn void garder_maximum(t_probabilites *cible, const t_probabilites *source, int blocs)
+ * 
+ * @brief Cette procédure remplace chaque probabilité d'un vecteur par son maximum avec celle d'un autre vecteur
+ * 
+ * @param cible Le vecteur modifié
+ * @param source L'autre vecteur
+ * @param blocs La longueur des vecteurs, en t_probabilites
+ * 
+ * Le maximum est choisi par masque, sans branchement
+ */
+void garder_maximum(t_probabilites *cible, const t_probabilites *source, int blocs) {
+    for (int b = 0; b < blocs; b++) {
+        t_comparaison_probabilites plus_grand;
+
+        plus_grand = source[b] > cible[b];
+        cible[b] = (t_probabilites) (((t_comparaison_probabilites) source[b] & plus_grand)
+                                     | ((t_comparaison_probabilites) cible[b] & ~plus_grand));
+    }
+}
+
+/**
+ * @fn const t_probabilites *vecteur_decale(const t_probabilites *vecteurs, bool seuils, int masque, int total_sup,
+ *                                          int combinaison, int points, t_vecteurs_tour *tour)
+ * 
+ * @brief Cette fonction donne le vecteur de l'état atteint en validant une combinaison, décalé des points marqués
+ * 
+ * @param vecteurs La table des vecteurs, remplie pour tous les états qui ont une combinaison de plus
+ * @param seuils Vrai si les vecteurs donnent la probabilité d'atteindre chaque nombre de points, faux s'ils donnent
+ * la probabilité de marquer exactement chaque nombre de points
+ * @param masque Le masque des combinaisons remplies avant la validation
+ * @param total_sup Le total plafonné de la partie supérieure avant la validation
+ * @param combinaison L'indice de la combinaison validée
+ * @param points Les points marqués dans la combinaison
+ * @param tour Les vecteurs du tour, qui gardent le vecteur décalé pour les validations suivantes
+ * @return const t_probabilites* le vecteur des points restants avant la validation, tour->blocs t_probabilites
+ * 
+ * Les points marqués, plus le bonus s'il est atteint par ce coup, sont acquis : en dessous, une probabilité
+ * d'atteindre vaut 1 et une probabilité exacte 0
+ */
+const t_probabilites *vecteur_decale(const t_probabilites *vecteurs, bool seuils, int masque, int total_sup,
+                                     int combinaison, int points, t_vecteurs_tour *tour) {
+    t_probabilites *decale;
+    const float *source;
+    float *cible;
+    int total_suivant;
+    int decalage;
+    int longueur;
+
+    decale = tour->decales + (combinaison * NOMBRE_DECALAGES + points) * tour->blocs;
+    if (tour->decale_calcule[combinaison][points]) {
+        return decale;
+    }
+
+    decalage = points;
+    total_suivant = total_sup;
+    if (combinaison < 6) {
+        total_suivant = total_sup + points > 63 ? 63 : total_sup + points;
+        if (total_sup < 63 && total_suivant == 63) {
+            decalage = decalage + 35;
+        }
+    }
+
+    source = (const float *) (vecteurs + DEBUT_VECTEURS[INDICE_ETAT(masque | (1 << combinaison), total_suivant)]);
+    longueur = (DEBUT_VECTEURS[INDICE_ETAT(masque | (1 << combinaison), total_suivant) + 1]
+              - DEBUT_VECTEURS[INDICE_ETAT(masque | (1 << combinaison), total_suivant)]) * PROBABILITES_PAR_VECTEUR;
+    cible = (float *) decale;
+
+    for (int x = 0; x < tour->blocs * PROBABILITES_PAR_VECTEUR; x++) {
+        if (x < decalage) {
+            cible[x] = seuils ? 1.0f : 0.0f;
+        }
+        else if (x - decalage < longueur) {
+            cible[x] = source[x - decalage];
+        }
+        else {
+            cible[x] = 0.0f;
+        }
+    }
+
+    tour->decale_calcule[combinaison][points] = true;
+    return decale;
+}
+
+/**
+ * @fn void propager_vecteurs_tour(t_vecteurs_tour *tour, t_valeurs_tour *valeurs, t_probabilites *resultat)
+ * 
+ * @brief Cette procédure calcule les vecteurs des gardes et des mains avec relances à partir des mains sans relance,
+ * puis le vecteur du début du tour
+ * 
+ * @param tour Les vecteurs du tour, dont les mains sans relance sont dans mains[0]
+ * @param valeurs Les valeurs du tour dont chaque main suit la meilleure garde, NULL pour prendre pour chaque
+ * élément le maximum sur les gardes
+ * @param resultat Le vecteur du début du tour, moyenne des mains avec toutes les relances
+ * 
+ * Le pendant de propager_valeurs_tour pour les vecteurs. Le maximum sur les gardes d'une main est obtenu en
+ * propageant chaque garde vers les gardes d'un dé de plus, de la plus petite à la plus grande, ce qui coûte 6
+ * maximums par garde au lieu d'un par sous-garde.
+ */
+void propager_vecteurs_tour(t_vecteurs_tour *tour, t_valeurs_tour *valeurs, t_probabilites *resultat) {
+    t_probabilites *precedentes;
+    t_probabilites *courantes;
+    t_probabilites *gardes;
+    int blocs;
+
+    blocs = tour->blocs;
+    gardes = tour->gardes;
+    courantes = tour->mains[0];
+
+    for (int r = 1; r <= NOMBRE_RELANCES; r++) {
+        precedentes = tour->mains[(r - 1) % 2];
+        courantes = tour->mains[r % 2];
+
+        for (int g = NOMBRE_GARDES - 1; g >= 0; g--) {
+            if (TAILLE_GARDE[g] == NOMBRE_DES) {
+                memcpy(gardes + g * blocs, precedentes + MAIN_PAR_GARDE[g] * blocs, blocs * sizeof(t_probabilites));
+            }
+            else {
+                for (int b = 0; b < blocs; b++) {
+                    t_probabilites somme;
+
+                    somme = gardes[GARDE_PLUS_FACE[g][0] * blocs + b];
+                    DEROULER
+                    for (int f = 1; f < NOMBRE_FACES; f++) {
+                        somme = somme + gardes[GARDE_PLUS_FACE[g][f] * blocs + b];
+                    }
+                    gardes[g * blocs + b] = somme / (float) NOMBRE_FACES;
+                }
+            }
+        }
+
+        if (valeurs != NULL) {
+            for (int m = 0; m < NOMBRE_MAINS; m++) {
+                int garde;
+
+                garde = GARDE_PAR_MASQUE[m][MASQUE_DES];
+                for (int masque_garde = 0; masque_garde < MASQUE_DES; masque_garde++) {
+                    if (valeurs->gardes[r][GARDE_PAR_MASQUE[m][masque_garde]] > valeurs->gardes[r][garde]) {
+                        garde = GARDE_PAR_MASQUE[m][masque_garde];
+                    }
+                }
+                memcpy(courantes + m * blocs, gardes + garde * blocs, blocs * sizeof(t_probabilites));
+            }
+        }
+        else {
+            for (int g = 0; g < NOMBRE_GARDES; g++) {
+                if (TAILLE_GARDE[g] < NOMBRE_DES) {
+                    for (int f = 0; f < NOMBRE_FACES; f++) {
+                        garder_maximum(gardes + GARDE_PLUS_FACE[g][f] * blocs, gardes + g * blocs, blocs);
+                    }
+                }
+            }
+            for (int m = 0; m < NOMBRE_MAINS; m++) {
+                memcpy(courantes + m * blocs, gardes + GARDE_COMPLETE[m] * blocs, blocs * sizeof(t_probabilites));
+            }
+        }
+    }
+
+    for (int b = 0; b < blocs; b++) {
+        resultat[b] = resultat[b] - resultat[b];
+    }
+    for (int m = 0; m < NOMBRE_MAINS; m++) {
+        for (int b = 0; b < blocs; b++) {
+            resultat[b] = resultat[b] + courantes[m * blocs + b] * ((float) LANCERS_PAR_MAIN[m] / NOMBRE_LANCERS);
+        }
+    }
+}
+
+/**
+ * @fn void calculer_vecteurs_tour(const t_probabilites *vecteurs, const double *esperances, int masque, int total_sup,
+ *                                 t_vecteurs_tour *tour, t_valeurs_tour *valeurs, t_probabilites *resultat)
+ * 
+ * @brief Cette procédure calcule le vecteur des points restants d'un état au début d'un tour
+ * 
+ * @param vecteurs La table des vecteurs, remplie pour tous les états qui ont une combinaison de plus
+ * @param esperances La table des espérances pour suivre la stratégie optimale, NULL pour maximiser séparément la
+ * probabilité d'atteindre chaque nombre de points
+ * @param masque Le masque des combinaisons remplies au début du tour
+ * @param total_sup Le total plafonné de la partie supérieure au début du tour
+ * @param tour Les vecteurs du tour, alloués pour le plus grand état
+ * @param valeurs Les valeurs du tour, utilisées pour suivre les décisions de la stratégie optimale
+ * @param resultat Le vecteur de l'état
+ * 
+ * Reprend calculer_valeurs_tour avec un vecteur par main et par garde au lieu d'une espérance. Une garde vaut
+ * toujours la moyenne de ses suites. Avec les espérances, chaque main prend le vecteur de la décision de la
+ * stratégie optimale, choisie comme le font meilleure_garde et meilleure_combinaison, et le résultat est la
+ * distribution exacte des points restants. Sans espérances, chaque élément du vecteur d'une main est le maximum
+ * sur ses décisions.
+ */
+void calculer_vecteurs_tour(const t_probabilites *vecteurs, const double *esperances, int masque, int total_sup,
+                            t_vecteurs_tour *tour, t_valeurs_tour *valeurs, t_probabilites *resultat) {
+    t_probabilites *courantes;
+    int blocs;
+
+    blocs = DEBUT_VECTEURS[INDICE_ETAT(masque, total_sup) + 1] - DEBUT_VECTEURS[INDICE_ETAT(masque, total_sup)];
+    tour->blocs = blocs;
+    memset(tour->decale_calcule, 0, sizeof(tour->decale_calcule));
+
+    if (esperances != NULL) {
+        calculer_valeurs_tour(esperances, masque, total_sup, valeurs);
+    }
+
+    courantes = tour->mains[0];
+    for (int m = 0; m < NOMBRE_MAINS; m++) {
+        t_probabilites *main;
+        double meilleure_valeur;
+        int meilleure;
+        bool premiere;
+
+        main = courantes + m * blocs;
+        meilleure = -1;
+        meilleure_valeur = -1.0;
+        premiere = true;
+
+        for (int c = 0; c < 13; c++) {
+            if (!(masque & (1 << c))) {
+                if (esperances != NULL) {
+                    double valeur;
+
+                    valeur = valeur_combinaison(esperances, masque, total_sup, c, TABLE_POINTS[m].points[c]);
+                    if (valeur > meilleure_valeur) {
+                        meilleure = c;
+                        meilleure_valeur = valeur;
+                    }
+                }
+                else {
+                    const t_probabilites *decale;
+
+                    decale = vecteur_decale(vecteurs, true, masque, total_sup, c, TABLE_POINTS[m].points[c], tour);
+                    if (premiere) {
+                        memcpy(main, decale, blocs * sizeof(t_probabilites));
+                    }
+                    else {
+                        garder_maximum(main, decale, blocs);
+                    }
+                    premiere = false;
+                }
+            }
+        }
+
+        if (esperances != NULL) {
+            memcpy(main, vecteur_decale(vecteurs, false, masque, total_sup, meilleure,
+                                        TABLE_POINTS[m].points[meilleure], tour), blocs * sizeof(t_probabilites));
+        }
+    }
+
+    propager_vecteurs_tour(tour, esperances != NULL ? valeurs : NULL, resultat);
+}
+
+/**
+ * @brief Représente le travail partagé entre les threads du calcul des distributions pour un niveau de remplissage
+ * 
+ */
+typedef struct {
+    t_probabilites *vecteurs;
+    const double *esperances;
+    int niveau;
+    atomic_int prochain_masque;
+} t_travail_distributions;
+
+/**
+ * @fn void *distribuer_niveau(void *argument)
+ * 
+ * @brief Cette fonction est exécutée par chaque thread du calcul des distributions
+ * 
+ * @param argument Le travail partagé, de type t_travail_distributions
+ * @return void* NULL
+ * 
+ * Les masques sont répartis comme dans resoudre_niveau : un état ne lit que les vecteurs du niveau supérieur
+ */
+void *distribuer_niveau(void *argument) {
+    t_travail_distributions *travail;
+    t_vecteurs_tour tour;
+    t_valeurs_tour *valeurs;
+    size_t taille;
+    int masque;
+
+    travail = argument;
+    valeurs = malloc(sizeof(t_valeurs_tour));
+    taille = (SCORE_MAXIMAL / PROBABILITES_PAR_VECTEUR + 1) * sizeof(t_probabilites);
+    tour.mains[0] = aligned_alloc(sizeof(t_probabilites), NOMBRE_MAINS * taille);
+    tour.mains[1] = aligned_alloc(sizeof(t_probabilites), NOMBRE_MAINS * taille);
+    tour.gardes = aligned_alloc(sizeof(t_probabilites), NOMBRE_GARDES * taille);
+    tour.decales = aligned_alloc(sizeof(t_probabilites), 13 * NOMBRE_DECALAGES * taille);
+
+    masque = atomic_fetch_add(&travail->prochain_masque, 1);
+    while (masque < 8192) {
+        if (__builtin_popcount(masque) == travail->niveau) {
+            for (int total_sup = 0; total_sup < 64; total_sup++) {
+                if (TOTAUX_ATTEIGNABLES[masque & 63][total_sup]) {
+                    calculer_vecteurs_tour(travail->vecteurs, travail->esperances, masque, total_sup, &tour, valeurs,
+                                           travail->vecteurs + DEBUT_VECTEURS[INDICE_ETAT(masque, total_sup)]);
+                }
+            }
+        }
+        masque = atomic_fetch_add(&travail->prochain_masque, 1);
+    }
+
+    free(tour.decales);
+    free(tour.gardes);
+    free(tour.mains[1]);
+    free(tour.mains[0]);
+    free(valeurs);
+    return NULL;
+}
+
+/**
+ * @fn void calculer_distributions(t_probabilites *vecteurs, const double *esperances, int nombre_threads)
+ * 
+ * @brief Cette procédure calcule le vecteur des points restants de chaque état atteignable
+ * 
+ * @param vecteurs La table des vecteurs à remplir, DEBUT_VECTEURS[NOMBRE_ETATS] t_probabilites placés par
+ * initialiser_vecteurs
+ * @param esperances La table des espérances pour obtenir la distribution des points sous la stratégie optimale,
+ * NULL pour obtenir pour chaque nombre de points la plus grande probabilité de l'atteindre
+ * @param nombre_threads Le nombre de threads de calcul
+ * 
+ * Remonte les niveaux de remplissage comme resoudre_strategie. Le vecteur de la feuille vide, à
+ * DEBUT_VECTEURS[INDICE_ETAT(0, 0)], donne la distribution du score final ou, sans espérances, la probabilité
+ * maximale de finir avec au moins chaque score, chaque seuil ayant sa propre stratégie.
+ */
+void calculer_distributions(t_probabilites *vecteurs, const double *esperances, int nombre_threads) {
+    t_travail_distributions travail;
+    pthread_t threads[nombre_threads];
+
+    for (int total_sup = 0; total_sup < 64; total_sup++) {
+        if (TOTAUX_ATTEIGNABLES[63][total_sup]) {
+            t_probabilites *feuille_pleine;
+
+            feuille_pleine = vecteurs + DEBUT_VECTEURS[INDICE_ETAT(8191, total_sup)];
+            feuille_pleine[0] = feuille_pleine[0] - feuille_pleine[0];
+            feuille_pleine[0][0] = 1.0f;
+        }
+    }
+
+    travail.vecteurs = vecteurs;
+    travail.esperances = esperances;
+
+    for (int niveau = 12; niveau >= 0; niveau--) {
+        travail.niveau = niveau;
+        atomic_init(&travail.prochain_masque, 0);
+
+        for (int t = 0; t < nombre_threads; t++) {
+            pthread_create(&threads[t], NULL, distribuer_niveau, &travail);
+        }
+        for (int t = 0; t < nombre_threads; t++) {
+            pthread_join(threads[t], NULL);
+        }
+    }
+}
+
+/**
+ * @fn double probabilite_seuil(const float *seuils, int etat, int points)
+ * 
+ * @brief Cette fonction donne la plus grande probabilité qu'un état marque encore au moins un nombre de points
+ * 
+ * @param seuils La table des vecteurs calculée sans espérances, lue comme des float
+ * @param etat L'indice INDICE_ETAT de l'état
+ * @param points Le nombre de points à marquer
+ * @return double 1 si points est négatif ou nul, 0 au-delà du maximum de l'état
+ */
+double probabilite_seuil(const float *seuils, int etat, int points) {
+    if (points <= 0) {
+        return 1.0;
+    }
+    if (points >= (int) (DEBUT_VECTEURS[etat + 1] - DEBUT_VECTEURS[etat]) * PROBABILITES_PAR_VECTEUR) {
+        return 0.0;
+    }
+
+    return seuils[DEBUT_VECTEURS[etat] * PROBABILITES_PAR_VECTEUR + points];
+}
+
+/**
+ * @fn double valeur_seuil(const float *seuils, int masque, int total_sup, int points, int combinaison, int marques)
+ * 
+ * @brief Cette fonction donne la probabilité d'atteindre un seuil après la validation d'une combinaison
+ * 
+ * @param seuils La table des vecteurs calculée sans espérances
+ * @param masque Le masque des combinaisons remplies avant la validation
+ * @param total_sup Le total plafonné de la partie supérieure avant la validation
+ * @param points Les points qu'il reste à marquer avant la validation pour atteindre le seuil
+ * @param combinaison L'indice de la combinaison validée
+ * @param marques Les points marqués dans la combinaison
+ * @return double la plus grande probabilité d'atteindre le seuil en jouant ensuite au mieux
+ */
+double valeur_seuil(const float *seuils, int masque, int total_sup, int points, int combinaison, int marques) {
+    int total_suivant;
+
+    total_suivant = total_sup;
+    points = points - marques;
+    if (combinaison < 6) {
+        total_suivant = total_sup + marques > 63 ? 63 : total_sup + marques;
+        if (total_sup < 63 && total_suivant == 63) {
+            points = points - 35;
+        }
+    }
+
+    return probabilite_seuil(seuils, INDICE_ETAT(masque | (1 << combinaison), total_suivant), points);
+}
+
+/**
+ * @brief Représente le contexte de la stratégie qui maximise la probabilité d'atteindre un score
+ * 
+ * Le contexte partagé porte la table et le seuil, chaque instance y ajoute les valeurs du tour en cours, calculées
+ * pour les points qu'il reste à marquer au début du tour
+ * 
+ */
+typedef struct {
+    const float *seuils;
+    int seuil;
+    int etat;
+    t_valeurs_tour valeurs;
+} t_contexte_seuil;
+
+/**
+ * @fn void calculer_valeurs_seuil(t_contexte_seuil *contexte, t_etat_joueur etat)
+ * 
+ * @brief Cette procédure calcule les valeurs du tour de la stratégie de seuil, si elles ne sont pas déjà calculées
+ * 
+ * @param contexte Le contexte de l'instance
+ * @param etat L'état du joueur au début du tour
+ * 
+ * Les valeurs sont les probabilités d'atteindre le seuil, propagées comme les espérances
+ */
+void calculer_valeurs_seuil(t_contexte_seuil *contexte, t_etat_joueur etat) {
+    int masque;
+    int total_sup;
+    int points;
+
+    masque = ETAT_MASQUE(etat);
+    total_sup = ETAT_SUP_PLAFONNE(etat);
+    points = contexte->seuil - ETAT_TOTAL(etat);
+    if (points < 0) {
+        points = 0;
+    }
+    if (contexte->etat == ((ETAT_CLE_SOLVEUR(etat) << 9) | points)) {
+        return;
+    }
+
+    for (int m = 0; m < NOMBRE_MAINS; m++) {
+        double meilleure;
+        double valeur;
+
+        meilleure = -1.0;
+        for (int c = 0; c < 13; c++) {
+            if (!(masque & (1 << c))) {
+                valeur = valeur_seuil(contexte->seuils, masque, total_sup, points, c, TABLE_POINTS[m].points[c]);
+                if (valeur > meilleure) {
+                    meilleure = valeur;
+                }
+            }
+        }
+        contexte->valeurs.mains[0][m] = meilleure;
+    }
+
+    propager_valeurs_tour(&contexte->valeurs);
+    contexte->etat = (ETAT_CLE_SOLVEUR(etat) << 9) | points;
+}
+
+/**
+ * @fn int seuil_choisir_relance(t_des des, t_score scores, int relances_restantes, void *contexte)
+ * 
+ * @brief Cette fonction est la décision de relance de la stratégie de seuil
+ * 
+ * @param des Les 5 dés du joueur
+ * @param scores La feuille de score
+ * @param relances_restantes Le nombre de relances encore possibles
+ * @param contexte Le contexte de la stratégie, de type t_contexte_seuil
+ * @return int le masque des dés à relancer
+ */
+int seuil_choisir_relance(t_des des, t_score scores, int relances_restantes, void *contexte) {
+    t_contexte_seuil *seuil;
+
+    seuil = contexte;
+    calculer_valeurs_seuil(seuil, resumer_feuille(scores));
+
+    return ~meilleure_garde(&seuil->valeurs, des, relances_restantes) & MASQUE_DES;
+}
+
+/**
+ * @fn int seuil_choisir_combinaison(t_des des, t_score scores, void *contexte)
+ * 
+ * @brief Cette fonction est le choix de combinaison de la stratégie de seuil
+ * 
+ * @param des Les 5 dés du joueur
+ * @param scores La feuille de score
+ * @param contexte Le contexte de la stratégie, de type t_contexte_seuil
+ * @return int l'indice de la combinaison qui maximise la probabilité d'atteindre le seuil
+ */
+int seuil_choisir_combinaison(t_des des, t_score scores, void *contexte) {
+    t_contexte_seuil *seuil;
+    t_ligne_points *ligne;
+    t_etat_joueur etat;
+    int points;
+    int meilleure;
+    double meilleure_valeur;
+    double valeur;
+
+    seuil = contexte;
+    etat = resumer_feuille(scores);
+    ligne = &TABLE_POINTS[indice_main(des)];
+    points = seuil->seuil - ETAT_TOTAL(etat);
+    meilleure = -1;
+    meilleure_valeur = -1.0;
+
+    for (int c = 0; c < 13; c++) {
+        if (!(ETAT_MASQUE(etat) & (1 << c))) {
+            valeur = valeur_seuil(seuil->seuils, ETAT_MASQUE(etat), ETAT_SUP_PLAFONNE(etat), points, c,
+                                  ligne->points[c]);
+            if (valeur > meilleure_valeur) {
+                meilleure = c;
+                meilleure_valeur = valeur;
+            }
+        }
+    }
+
+    return meilleure;
+}
+
+/**
+ * @fn void *creer_contexte_seuil(void *contexte)
+ * 
+ * @brief Cette fonction crée le contexte d'une instance de la stratégie de seuil
+ * 
+ * @param contexte Le contexte partagé, de type t_contexte_seuil, qui porte la table et le seuil
+ * @return void* le contexte de l'instance, à libérer avec free, NULL si la mémoire manque
+ */
+void *creer_contexte_seuil(void *contexte) {
+    t_contexte_seuil *partage;
+    t_contexte_seuil *seuil;
+
+    partage = contexte;
+    seuil = malloc(sizeof(t_contexte_seuil));
+    if (seuil == NULL) {
+        return NULL;
+    }
+    seuil->seuils = partage->seuils;
+    seuil->seuil = partage->seuil;
+    seuil->etat = -1;
+
+    return seuil;
+}
+
+/*********************************
+ *    FINALES À DEUX JOUEURS     *
+ *********************************/
+
+/**
+ * @brief Raccourci associé au plus grand nombre de combinaisons libres par joueur que peut couvrir une table des
+ * finales
+ * 
+ * La dernière table de 3 combinaisons libres compte déjà plus de 20 millions de paires de feuilles
+ * 
+ */
+#define LIBRES_FINALES_MAX 3
+
+/**
+ * @brief Raccourci associé à la valeur enregistrée pour une probabilité de gain de 1, les probabilités étant
+ * arrondies au 65535e
+ * 
+ */
+#define QUANTUM_FINALES 65535
+
+/**
+ * @brief Indique le plus grand nombre de points de chaque combinaison
+ * 
+ */
+int MAXIMUM_COMBINAISON[13];
+
+/**
+ * @brief Indique pour chaque masque des combinaisons supérieures remplies et chaque nombre de points manquant pour
+ * le bonus le besoin canonique
+ * 
+ * Le besoin canonique est la plus petite somme des combinaisons supérieures libres qui atteint les points
+ * manquants, 0 si le bonus est déjà acquis ou ne peut plus l'être. Deux feuilles de même masque et de même besoin
+ * canonique ont le même avenir : les points supérieurs qui restent à marquer atteignent l'un dès qu'ils atteignent
+ * l'autre.
+ * 
+ */
+uint8_t BESOIN_CANONIQUE[64][128];
+
+/**
+ * @brief Indique pour chaque masque des combinaisons supérieures remplies ses besoins canoniques, 0 en premier
+ * 
+ */
+uint8_t BESOINS_CLASSES[64][128];
+
+/**
+ * @brief Indique pour chaque masque des combinaisons supérieures remplies le nombre de ses besoins canoniques
+ * 
+ */
+uint8_t NOMBRE_BESOINS[64];
+
+/**
+ * @brief Indique pour chaque masque des combinaisons supérieures remplies le rang de chaque besoin canonique
+ * dans BESOINS_CLASSES
+ * 
+ */
+uint8_t RANG_BESOIN[64][128];
+
+/**
+ * @brief Indique pour chaque masque des combinaisons remplies l'indice de sa première classe parmi les classes
+ * qui ont le même nombre de combinaisons libres
+ * 
+ * Une classe est un masque et un besoin canonique. Les classes d'un même nombre de combinaisons libres sont
+ * rangées par masque croissant puis dans l'ordre de BESOINS_CLASSES.
+ * 
+ */
+uint32_t DEBUT_CLASSES[8192];
+
+/**
+ * @brief Indique pour chaque nombre de combinaisons libres le nombre de classes
+ * 
+ */
+uint32_t CLASSES_PAR_LIBRES[14];
+
+/**
+ * @brief Représente l'entrée d'une paire de classes dans une table des finales
+ * 
+ * Le vecteur d'une paire donne la probabilité de gain du joueur qui doit jouer pour chaque écart entre son total
+ * et celui de son adversaire, du plus défavorable au plus favorable qui ne soit pas un gain assuré. Seuls les
+ * nombre éléments à partir de premier sont enregistrés, à partir de debut dans les valeurs de la table : avant,
+ * la probabilité arrondie vaut 0, après, elle vaut 1.
+ * 
+ */
+typedef struct {
+    uint32_t debut;
+    uint16_t premier;
+    uint16_t nombre;
+} t_entree_finale;
+
+/**
+ * @brief Représente la table des finales d'un nombre de tours restants
+ * 
+ * Le joueur qui doit jouer a (tours + 1) / 2 combinaisons libres et son adversaire tours / 2. L'entrée de la
+ * paire (i, j) est à l'indice i * classes_adversaire + j.
+ * 
+ */
+typedef struct {
+    uint32_t classes_joueur;
+    uint32_t classes_adversaire;
+    uint32_t nombre_valeurs;
+    const t_entree_finale *entrees;
+    const uint16_t *valeurs;
+} t_table_finale;
+
+/**
+ * @brief Représente les tables des finales, de 1 à 2 * libres tours restants
+ * 
+ */
+typedef struct {
+    int libres;
+    t_table_finale tables[2 * LIBRES_FINALES_MAX + 1];
+} t_finales;
+
+/**
+ * @brief Représente une paire de classes lue dans les tables des finales, prête pour lire ses probabilités
+ * 
+ */
+typedef struct {
+    int tours;
+    int maximum_joueur;
+    int maximum_adversaire;
+    int premier;
+    int nombre;
+    const uint16_t *valeurs;
+} t_paire_finale;
+
+/**
+ * @fn void initialiser_classes_finales(void)
+ * 
+ * @brief Cette procédure calcule les besoins canoniques et place les classes des feuilles
+ * 
+ * Les sommes atteignables par les combinaisons supérieures libres sont obtenues en ajoutant de 0 à 5 dés de
+ * chacune de leurs faces
+ */
+void initialiser_classes_finales(void) {
+    uint32_t debut;
+
+    for (int c = 0; c < 13; c++) {
+        MAXIMUM_COMBINAISON[c] = 0;
+        for (int m = 0; m < NOMBRE_MAINS; m++) {
+            if (TABLE_POINTS[m].points[c] > MAXIMUM_COMBINAISON[c]) {
+                MAXIMUM_COMBINAISON[c] = TABLE_POINTS[m].points[c];
+            }
+        }
+    }
+
+    for (int masque_sup = 0; masque_sup < 64; masque_sup++) {
+        bool atteignables[128];
+
+        memset(atteignables, 0, sizeof(atteignables));
+        atteignables[0] = true;
+        for (int c = 0; c < 6; c++) {
+            if (!(masque_sup & (1 << c))) {
+                for (int somme = 127; somme > 0; somme--) {
+                    for (int n = 1; n <= NOMBRE_DES && n * (c + 1) <= somme; n++) {
+                        if (atteignables[somme - n * (c + 1)]) {
+                            atteignables[somme] = true;
+                        }
+                    }
+                }
+            }
+        }
+
+        BESOIN_CANONIQUE[masque_sup][0] = 0;
+        for (int besoin = 127; besoin > 0; besoin--) {
+            if (atteignables[besoin]) {
+                BESOIN_CANONIQUE[masque_sup][besoin] = besoin;
+            }
+            else {
+                BESOIN_CANONIQUE[masque_sup][besoin] = besoin < 127 ? BESOIN_CANONIQUE[masque_sup][besoin + 1] : 0;
+            }
+        }
+
+        NOMBRE_BESOINS[masque_sup] = 0;
+        for (int besoin = 0; besoin < 128; besoin++) {
+            if (besoin == 0 || BESOIN_CANONIQUE[masque_sup][besoin] == besoin) {
+                RANG_BESOIN[masque_sup][besoin] = NOMBRE_BESOINS[masque_sup];
+                BESOINS_CLASSES[masque_sup][NOMBRE_BESOINS[masque_sup]] = besoin;
+                NOMBRE_BESOINS[masque_sup] = NOMBRE_BESOINS[masque_sup] + 1;
+            }
+        }
+    }
+
+    for (int libres = 0; libres <= 13; libres++) {
+        debut = 0;
+        for (int masque = 0; masque < 8192; masque++) {
+            if (__builtin_popcount(masque) == 13 - libres) {
+                DEBUT_CLASSES[masque] = debut;
+                debut = debut + NOMBRE_BESOINS[masque & 63];
+            }
+        }
+        CLASSES_PAR_LIBRES[libres] = debut;
+    }
+}
+
+/**
+ * @fn int besoin_feuille(t_etat_joueur etat)
+ * 
+ * @brief Cette fonction donne le besoin canonique d'une feuille
+ * 
+ * @param etat La feuille résumée
+ * @return int le besoin canonique, 0 si le bonus est acquis ou hors d'atteinte
+ */
+int besoin_feuille(t_etat_joueur etat) {
+    return BESOIN_CANONIQUE[ETAT_MASQUE(etat) & 63][63 - ETAT_SUP_PLAFONNE(etat)];
+}
+
+/**
+ * @fn int maximum_finale(int masque, int besoin)
+ * 
+ * @brief Cette fonction donne le plus grand nombre de points qu'une classe peut encore marquer, bonus compris
+ * 
+ * @param masque Le masque des combinaisons remplies
+ * @param besoin Le besoin canonique
+ * @return int le maximum des points restants
+ */
+int maximum_finale(int masque, int besoin) {
+    int maximum;
+
+    maximum = besoin > 0 ? 35 : 0;
+    for (int c = 0; c < 13; c++) {
+        if (!(masque & (1 << c))) {
+            maximum = maximum + MAXIMUM_COMBINAISON[c];
+        }
+    }
+
+    return maximum;
+}
+
+/**
+ * @fn void trouver_paire_finale(const t_finales *finales, int tours, int masque_joueur, int besoin_joueur,
+ *                               int masque_adversaire, int besoin_adversaire, t_paire_finale *paire)
+ * 
+ * @brief Cette procédure cherche l'entrée d'une paire de classes dans les tables des finales
+ * 
+ * @param finales Les tables des finales, remplies jusqu'à tours tours restants
+ * @param tours Le nombre de tours restants, 0 quand les deux feuilles sont pleines
+ * @param masque_joueur Le masque des combinaisons remplies du joueur qui doit jouer
+ * @param besoin_joueur Son besoin canonique
+ * @param masque_adversaire Le masque des combinaisons remplies de son adversaire
+ * @param besoin_adversaire Le besoin canonique de son adversaire
+ * @param paire La paire trouvée
+ */
+void trouver_paire_finale(const t_finales *finales, int tours, int masque_joueur, int besoin_joueur,
+                          int masque_adversaire, int besoin_adversaire, t_paire_finale *paire) {
+    const t_table_finale *table;
+    const t_entree_finale *entree;
+
+    paire->tours = tours;
+    paire->maximum_joueur = maximum_finale(masque_joueur, besoin_joueur);
+    paire->maximum_adversaire = maximum_finale(masque_adversaire, besoin_adversaire);
+    paire->premier = 0;
+    paire->nombre = 0;
+    paire->valeurs = NULL;
+
+    if (tours > 0) {
+        table = &finales->tables[tours];
+        entree = &table->entrees[(DEBUT_CLASSES[masque_joueur] + RANG_BESOIN[masque_joueur & 63][besoin_joueur])
+                                 * table->classes_adversaire
+                                 + DEBUT_CLASSES[masque_adversaire]
+                                 + RANG_BESOIN[masque_adversaire & 63][besoin_adversaire]];
+        paire->premier = entree->premier;
+        paire->nombre = entree->nombre;
+        paire->valeurs = table->valeurs + entree->debut;
+    }
+}
+
+/**
+ * @fn float probabilite_paire_finale(const t_paire_finale *paire, int ecart)
+ * 
+ * @brief Cette fonction donne la probabilité de gain du joueur qui doit jouer
+ * 
+ * @param paire La paire de classes des deux joueurs
+ * @param ecart Le total du joueur moins celui de son adversaire
+ * @return float la probabilité de gain, une égalité comptant pour moitié
+ */
+float probabilite_paire_finale(const t_paire_finale *paire, int ecart) {
+    int x;
+
+    if (ecart > paire->maximum_adversaire) {
+        return 1.0f;
+    }
+    if (ecart < -paire->maximum_joueur) {
+        return 0.0f;
+    }
+    if (paire->tours == 0) {
+        return 0.5f;
+    }
+
+    x = ecart + paire->maximum_joueur - paire->premier;
+    if (x < 0) {
+        return 0.0f;
+    }
+    if (x >= paire->nombre) {
+        return 1.0f;
+    }
+
+    return paire->valeurs[x] / (float) QUANTUM_FINALES;
+}
+
+/**
+ * @fn void suivre_classe_finale(int masque, int besoin, int combinaison, int points, int *masque_suivant,
+ *                               int *besoin_suivant, int *bonus)
+ * 
+ * @brief Cette procédure donne la classe atteinte en validant une combinaison
+ * 
+ * @param masque Le masque des combinaisons remplies avant la validation
+ * @param besoin Le besoin canonique avant la validation
+ * @param combinaison L'indice de la combinaison validée
+ * @param points Les points marqués dans la combinaison
+ * @param masque_suivant Reçoit le masque après la validation
+ * @param besoin_suivant Reçoit le besoin canonique après la validation
+ * @param bonus Reçoit 35 si le bonus est atteint par ce coup, 0 sinon
+ */
+void suivre_classe_finale(int masque, int besoin, int combinaison, int points, int *masque_suivant,
+                          int *besoin_suivant, int *bonus) {
+    *masque_suivant = masque | (1 << combinaison);
+    *besoin_suivant = besoin;
+    *bonus = 0;
+
+    if (combinaison < 6 && besoin > 0) {
+        if (points >= besoin) {
+            *besoin_suivant = 0;
+            *bonus = 35;
+        }
+        else {
+            *besoin_suivant = BESOIN_CANONIQUE[*masque_suivant & 63][besoin - points];
+        }
+    }
+}
+
+/**
+ * @fn float probabilite_validation_finale(const t_finales *finales, int tours, int masque_joueur, int besoin_joueur,
+ *                                        int masque_adversaire, int besoin_adversaire, int ecart, int combinaison,
+ *                                        int points)
+ * 
+ * @brief Cette fonction donne la probabilité de gain du joueur qui valide une combinaison
+ * 
+ * @param finales Les tables des finales, remplies jusqu'à tours - 1 tours restants
+ * @param tours Le nombre de tours restants avant la validation, au moins 1
+ * @param masque_joueur Le masque des combinaisons remplies du joueur qui valide
+ * @param besoin_joueur Son besoin canonique
+ * @param masque_adversaire Le masque des combinaisons remplies de son adversaire
+ * @param besoin_adversaire Le besoin canonique de son adversaire
+ * @param ecart Le total du joueur moins celui de son adversaire avant la validation
+ * @param combinaison L'indice de la combinaison validée
+ * @param points Les points marqués dans la combinaison
+ * @return float la probabilité de gain du joueur
+ */
+float probabilite_validation_finale(const t_finales *finales, int tours, int masque_joueur, int besoin_joueur,
+                                    int masque_adversaire, int besoin_adversaire, int ecart, int combinaison,
+                                    int points) {
+    t_paire_finale paire;
+    int masque_suivant;
+    int besoin_suivant;
+    int bonus;
+
+    suivre_classe_finale(masque_joueur, besoin_joueur, combinaison, points, &masque_suivant, &besoin_suivant, &bonus);
+    trouver_paire_finale(finales, tours - 1, masque_adversaire, besoin_adversaire, masque_suivant, besoin_suivant,
+                         &paire);
+
+    return 1.0f - probabilite_paire_finale(&paire, -(ecart + points + bonus));
+}
+
+/**
+ * @fn int calculer_paire_finale(const t_finales *finales, int tours, int masque_joueur, int besoin_joueur,
+ *                               int masque_adversaire, int besoin_adversaire, t_vecteurs_tour *tour,
+ *                               t_probabilites *resultat)
+ * 
+ * @brief Cette fonction calcule la probabilité de gain du joueur qui doit jouer pour chaque écart des totaux
+ * 
+ * @param finales Les tables des finales, remplies jusqu'à tours - 1 tours restants
+ * @param tours Le nombre de tours restants, au moins 1
+ * @param masque_joueur Le masque des combinaisons remplies du joueur qui doit jouer
+ * @param besoin_joueur Son besoin canonique
+ * @param masque_adversaire Le masque des combinaisons remplies de son adversaire
+ * @param besoin_adversaire Le besoin canonique de son adversaire
+ * @param tour Les vecteurs du tour, alloués pour le plus long vecteur
+ * @param resultat Le vecteur de la paire, l'élément x pour un écart de x moins le maximum du joueur
+ * @return int le nombre d'écarts couverts par le vecteur
+ * 
+ * Reprend calculer_vecteurs_tour sans espérances, chaque élément étant un écart au lieu d'un seuil. Après la
+ * validation, c'est à l'adversaire de jouer : la probabilité de gain du joueur est 1 moins celle de l'adversaire
+ * dans la table du tour suivant, pour l'écart opposé.
+ */
+int calculer_paire_finale(const t_finales *finales, int tours, int masque_joueur, int besoin_joueur,
+                          int masque_adversaire, int besoin_adversaire, t_vecteurs_tour *tour,
+                          t_probabilites *resultat) {
+    t_paire_finale paire;
+    int maximum_joueur;
+    int longueur;
+    int blocs;
+
+    maximum_joueur = maximum_finale(masque_joueur, besoin_joueur);
+    longueur = maximum_joueur + maximum_finale(masque_adversaire, besoin_adversaire) + 1;
+    blocs = longueur / PROBABILITES_PAR_VECTEUR + 1;
+    tour->blocs = blocs;
+    memset(tour->decale_calcule, 0, sizeof(tour->decale_calcule));
+
+    for (int m = 0; m < NOMBRE_MAINS; m++) {
+        t_probabilites *main;
+        bool premiere;
+
+        main = tour->mains[0] + m * blocs;
+        premiere = true;
+
+        for (int c = 0; c < 13; c++) {
+            if (!(masque_joueur & (1 << c))) {
+                t_probabilites *decale;
+                int points;
+
+                points = TABLE_POINTS[m].points[c];
+                decale = tour->decales + (c * NOMBRE_DECALAGES + points) * blocs;
+                if (!tour->decale_calcule[c][points]) {
+                    int masque_suivant;
+                    int besoin_suivant;
+                    int bonus;
+                    float *cible;
+
+                    suivre_classe_finale(masque_joueur, besoin_joueur, c, points, &masque_suivant, &besoin_suivant,
+                                         &bonus);
+                    trouver_paire_finale(finales, tours - 1, masque_adversaire, besoin_adversaire, masque_suivant,
+                                         besoin_suivant, &paire);
+                    cible = (float *) decale;
+                    for (int x = 0; x < blocs * PROBABILITES_PAR_VECTEUR; x++) {
+                        cible[x] = 1.0f - probabilite_paire_finale(&paire,
+                                                                   maximum_joueur - x - points - bonus);
+                    }
+                    tour->decale_calcule[c][points] = true;
+                }
+
+                if (premiere) {
+                    memcpy(main, decale, blocs * sizeof(t_probabilites));
+                }
+                else {
+                    garder_maximum(main, decale, blocs);
+                }
+                premiere = false;
+            }
+        }
+    }
+
+    propager_vecteurs_tour(tour, NULL, resultat);
+    return longueur;
+}
+
+/**
+ * @brief Représente le travail partagé entre les threads du calcul d'une table des finales
+ * 
+ * Chaque masque du joueur qui doit jouer est traité par un seul thread, qui écrit les entrées de ses paires dans la
+ * table et range leurs valeurs dans son propre tampon, ses débuts comptés depuis le début de ce tampon. Un thread
+ * à court de mémoire lève manque_memoire et les threads s'arrêtent au masque suivant.
+ * 
+ */
+typedef struct {
+    const t_finales *finales;
+    int tours;
+    t_entree_finale *entrees;
+    uint16_t *valeurs_masques[8192];
+    uint32_t nombre_valeurs_masques[8192];
+    atomic_int prochain_masque;
+    atomic_bool manque_memoire;
+} t_travail_finales;
+
+/**
+ * @fn void *calculer_niveau_finales(void *argument)
+ * 
+ * @brief Cette fonction est exécutée par chaque thread du calcul d'une table des finales
+ * 
+ * @param argument Le travail partagé, de type t_travail_finales
+ * @return void* NULL
+ * 
+ * Une table ne lit que la table du tour suivant, déjà complète. Les probabilités sont arrondies avant d'être
+ * rangées : la table suivante est calculée à partir des valeurs enregistrées, comme le ferait une lecture du
+ * fichier.
+ */
+void *calculer_niveau_finales(void *argument) {
+    t_travail_finales *travail;
+    t_vecteurs_tour tour;
+    t_probabilites *resultat;
+    uint16_t *arrondies;
+    size_t taille;
+    int libres_joueur;
+    int libres_adversaire;
+    int masque;
+
+    travail = argument;
+    libres_joueur = (travail->tours + 1) / 2;
+    libres_adversaire = travail->tours / 2;
+    taille = (2 * SCORE_MAXIMAL / PROBABILITES_PAR_VECTEUR + 1) * sizeof(t_probabilites);
+    tour.mains[0] = aligned_alloc(sizeof(t_probabilites), NOMBRE_MAINS * taille);
+    tour.mains[1] = aligned_alloc(sizeof(t_probabilites), NOMBRE_MAINS * taille);
+    tour.gardes = aligned_alloc(sizeof(t_probabilites), NOMBRE_GARDES * taille);
+    tour.decales = aligned_alloc(sizeof(t_probabilites), 13 * NOMBRE_DECALAGES * taille);
+    resultat = aligned_alloc(sizeof(t_probabilites), taille);
+    arrondies = malloc(taille);
+    if (tour.mains[0] == NULL || tour.mains[1] == NULL || tour.gardes == NULL || tour.decales == NULL
+        || resultat == NULL || arrondies == NULL) {
+        atomic_store(&travail->manque_memoire, true);
+    }
+
+    masque = atomic_fetch_add(&travail->prochain_masque, 1);
+    while (masque < 8192 && !atomic_load_explicit(&travail->manque_memoire, memory_order_relaxed)) {
+        if (__builtin_popcount(masque) == 13 - libres_joueur) {
+            uint16_t *valeurs;
+            uint32_t nombre_valeurs;
+            uint32_t capacite;
+            bool manque;
+
+            valeurs = NULL;
+            nombre_valeurs = 0;
+            capacite = 0;
+            manque = false;
+
+            for (int rang = 0; rang < NOMBRE_BESOINS[masque & 63] && !manque; rang++) {
+                int besoin;
+
+                besoin = BESOINS_CLASSES[masque & 63][rang];
+                for (int adverse = 0; adverse < 8192 && !manque; adverse++) {
+                    if (__builtin_popcount(adverse) == 13 - libres_adversaire) {
+                        for (int rang_adverse = 0; rang_adverse < NOMBRE_BESOINS[adverse & 63]; rang_adverse++) {
+                            t_entree_finale *entree;
+                            const float *probabilites;
+                            int longueur;
+                            int premier;
+                            int fin;
+
+                            longueur = calculer_paire_finale(travail->finales, travail->tours, masque, besoin, adverse,
+                                                             BESOINS_CLASSES[adverse & 63][rang_adverse], &tour,
+                                                             resultat);
+
+                            probabilites = (const float *) resultat;
+                            for (int x = 0; x < longueur; x++) {
+                                float probabilite;
+
+                                probabilite = probabilites[x] < 0.0f ? 0.0f : probabilites[x] > 1.0f ? 1.0f
+                                                                                                      : probabilites[x];
+                                arrondies[x] = (uint16_t) lrintf(probabilite * QUANTUM_FINALES);
+                            }
+                            premier = 0;
+                            while (premier < longueur && arrondies[premier] == 0) {
+                                premier = premier + 1;
+                            }
+                            fin = longueur;
+                            while (fin > premier && arrondies[fin - 1] == QUANTUM_FINALES) {
+                                fin = fin - 1;
+                            }
+
+                            if (nombre_valeurs + (fin - premier) > capacite) {
+                                uint16_t *agrandies;
+
+                                capacite = 2 * capacite + longueur;
+                                agrandies = realloc(valeurs, capacite * sizeof(uint16_t));
+                                if (agrandies == NULL) {
+                                    atomic_store(&travail->manque_memoire, true);
+                                    manque = true;
+                                    break;
+                                }
+                                valeurs = agrandies;
+                            }
+                            memcpy(valeurs + nombre_valeurs, arrondies + premier, (fin - premier) * sizeof(uint16_t));
+
+                            entree = &travail->entrees[(DEBUT_CLASSES[masque] + rang)
+                                                       * CLASSES_PAR_LIBRES[libres_adversaire]
+                                                       + DEBUT_CLASSES[adverse] + rang_adverse];
+                            entree->debut = nombre_valeurs;
+                            entree->premier = premier;
+                            entree->nombre = fin - premier;
+                            nombre_valeurs = nombre_valeurs + (fin - premier);
+                        }
+                    }
+                }
+            }
+
+            travail->valeurs_masques[masque] = valeurs;
+            travail->nombre_valeurs_masques[masque] = nombre_valeurs;
+        }
+        masque = atomic_fetch_add(&travail->prochain_masque, 1);
+    }
+
+    free(arrondies);
+    free(resultat);
+    free(tour.decales);
+    free(tour.gardes);
+    free(tour.mains[1]);
+    free(tour.mains[0]);
+    return NULL;
+}
+
+/**
+ * @fn bool calculer_table_finale(t_finales *finales, int tours, int nombre_threads)
+ * 
+ * @brief Cette fonction calcule la table des finales d'un nombre de tours restants
+ * 
+ * @param finales Les tables des finales, remplies jusqu'à tours - 1 tours restants, qui reçoivent la nouvelle table
+ * @param tours Le nombre de tours restants, au moins 1
+ * @param nombre_threads Le nombre de threads de calcul
+ * @return true si la table a été calculée
+ * @return false si la mémoire manque
+ * 
+ * Les tampons des masques sont mis bout à bout dans l'ordre des classes une fois tous les threads terminés
+ */
+bool calculer_table_finale(t_finales *finales, int tours, int nombre_threads) {
+    t_travail_finales *travail;
+    t_table_finale *table;
+    pthread_t threads[nombre_threads];
+    uint16_t *valeurs;
+    uint64_t paires;
+    uint64_t nombre_valeurs;
+    bool resultat;
+
+    table = &finales->tables[tours];
+    table->classes_joueur = CLASSES_PAR_LIBRES[(tours + 1) / 2];
+    table->classes_adversaire = CLASSES_PAR_LIBRES[tours / 2];
+    paires = (uint64_t) table->classes_joueur * table->classes_adversaire;
+
+    travail = calloc(1, sizeof(t_travail_finales));
+    if (travail == NULL) {
+        return false;
+    }
+    travail->finales = finales;
+    travail->tours = tours;
+    travail->entrees = malloc(paires * sizeof(t_entree_finale));
+    atomic_init(&travail->prochain_masque, 0);
+    atomic_init(&travail->manque_memoire, false);
+    if (travail->entrees == NULL) {
+        free(travail);
+        return false;
+    }
+
+    for (int t = 0; t < nombre_threads; t++) {
+        pthread_create(&threads[t], NULL, calculer_niveau_finales, travail);
+    }
+    for (int t = 0; t < nombre_threads; t++) {
+        pthread_join(threads[t], NULL);
+    }
+
+    nombre_valeurs = 0;
+    for (int masque = 0; masque < 8192; masque++) {
+        nombre_valeurs = nombre_valeurs + travail->nombre_valeurs_masques[masque];
+    }
+
+    resultat = nombre_valeurs <= UINT32_MAX && !atomic_load(&travail->manque_memoire);
+    valeurs = resultat ? malloc((nombre_valeurs + 1) * sizeof(uint16_t)) : NULL;
+    resultat = valeurs != NULL;
+
+    nombre_valeurs = 0;
+    for (int masque = 0; masque < 8192; masque++) {
+        if (__builtin_popcount(masque) == 13 - (tours + 1) / 2) {
+            if (resultat) {
+                uint64_t premiere_paire;
+
+                premiere_paire = (uint64_t) DEBUT_CLASSES[masque] * table->classes_adversaire;
+                for (uint64_t p = premiere_paire;
+                     p < premiere_paire + (uint64_t) NOMBRE_BESOINS[masque & 63] * table->classes_adversaire; p++) {
+                    travail->entrees[p].debut = travail->entrees[p].debut + nombre_valeurs;
+                }
+                memcpy(valeurs + nombre_valeurs, travail->valeurs_masques[masque],
+                       travail->nombre_valeurs_masques[masque] * sizeof(uint16_t));
+                nombre_valeurs = nombre_valeurs + travail->nombre_valeurs_masques[masque];
+            }
+            free(travail->valeurs_masques[masque]);
+        }
+    }
+
+    if (!resultat) {
+        free(travail->entrees);
+        free(travail);
+        return false;
+    }
+
+    table->nombre_valeurs = nombre_valeurs;
+    table->entrees = travail->entrees;
+    table->valeurs = valeurs;
+    free(travail);
+    return true;
+}
+
+/**
+ * @fn void liberer_finales(t_finales *finales)
+ * 
+ * @brief Cette procédure libère les tables des finales calculées par calculer_finales
+ * 
+ * @param finales Les tables des finales
+ */
+void liberer_finales(t_finales *finales) {
+    for (int tours = 1; tours <= 2 * LIBRES_FINALES_MAX; tours++) {
+        free((void *) finales->tables[tours].entrees);
+        free((void *) finales->tables[tours].valeurs);
+        finales->tables[tours].entrees = NULL;
+        finales->tables[tours].valeurs = NULL;
+    }
+    finales->libres = 0;
+}
+
+/**
+ * @fn bool calculer_finales(t_finales *finales, int libres, int nombre_threads, bool progression)
+ * 
+ * @brief Cette fonction calcule les tables des finales par analyse rétrograde
+ * 
+ * @param finales Reçoit les tables, à libérer avec liberer_finales
+ * @param libres Le nombre de combinaisons libres de chaque joueur au début de la finale, de 1 à LIBRES_FINALES_MAX
+ * @param nombre_threads Le nombre de threads de calcul
+ * @param progression Vrai pour afficher la taille et la durée de chaque table
+ * @return true si toutes les tables ont été calculées
+ * @return false si la mémoire manque, les tables déjà calculées étant libérées
+ * 
+ * Part des feuilles pleines, où le plus grand total gagne, et remonte d'un tour à la fois jusqu'à la finale où les
+ * deux joueurs ont libres combinaisons libres. Une égalité compte pour moitié, comme au tournoi : la probabilité de
+ * gain d'un joueur est alors 1 moins celle de son adversaire. Chaque table donne pour chaque écart la meilleure
+ * probabilité de gain, la décision qui l'obtient pouvant dépendre de l'écart.
+ */
+bool calculer_finales(t_finales *finales, int libres, int nombre_threads, bool progression) {
+    memset(finales, 0, sizeof(t_finales));
+
+    for (int tours = 1; tours <= 2 * libres; tours++) {
+        double debut;
+
+        debut = secondes_ecoulees();
+        if (!calculer_table_finale(finales, tours, nombre_threads)) {
+            liberer_finales(finales);
+            return false;
+        }
+
+        if (progression) {
+            printf("Tours restants %d : %llu paires, %u valeurs, %.3f s\n", tours,
+                   (unsigned long long) finales->tables[tours].classes_joueur
+                   * finales->tables[tours].classes_adversaire,
+                   finales->tables[tours].nombre_valeurs, secondes_ecoulees() - debut);
+            fflush(stdout);
+        }
+    }
+
+    finales->libres = libres;
+    return true;
+}
+
+/**
+ * @fn uint64_t taille_table_finale(const t_table_finale *table)
+ * 
+ * @brief Cette fonction donne la place d'une table des finales dans un fichier, en uint16_t
+ * 
+ * @param table La table
+ * @return uint64_t la taille des entrées et des valeurs, complétées jusqu'à un multiple de 8 octets
+ * 
+ * Les entrées de la table suivante restent ainsi alignées dans une projection du fichier
+ */
+uint64_t taille_table_finale(const t_table_finale *table) {
+    return (uint64_t) table->classes_joueur * table->classes_adversaire * (sizeof(t_entree_finale) / sizeof(uint16_t))
+         + (table->nombre_valeurs + 3) / 4 * 4;
+}
+
+/**
+ * @fn uint64_t assembler_finales(const t_finales *finales, uint16_t **donnees)
+ * 
+ * @brief Cette fonction met les tables des finales bout à bout pour les enregistrer
+ * 
+ * @param finales Les tables des finales
+ * @param donnees Reçoit les tables assemblées, à libérer avec free
+ * @return uint64_t le nombre de uint16_t assemblés, 0 si la mémoire manque
+ * 
+ * Chaque table, de 1 à 2 * libres tours restants, donne ses entrées puis ses valeurs. Le nombre de tours couverts
+ * n'est pas enregistré : placer_finales le retrouve à partir de la taille totale.
+ */
+uint64_t assembler_finales(const t_finales *finales, uint16_t **donnees) {
+    uint64_t nombre;
+    uint64_t position;
+
+    nombre = 0;
+    for (int tours = 1; tours <= 2 * finales->libres; tours++) {
+        nombre = nombre + taille_table_finale(&finales->tables[tours]);
+    }
+
+    *donnees = calloc(nombre, sizeof(uint16_t));
+    if (*donnees == NULL) {
+        return 0;
+    }
+
+    position = 0;
+    for (int tours = 1; tours <= 2 * finales->libres; tours++) {
+        const t_table_finale *table;
+        uint64_t paires;
+
+        table = &finales->tables[tours];
+        paires = (uint64_t) table->classes_joueur * table->classes_adversaire;
+        memcpy(*donnees + position, table->entrees, paires * sizeof(t_entree_finale));
+        memcpy(*donnees + position + paires * (sizeof(t_entree_finale) / sizeof(uint16_t)), table->valeurs,
+               table->nombre_valeurs * sizeof(uint16_t));
+        position = position + taille_table_finale(table);
+    }
+
+    return nombre;
+}
+
+/**
+ * @fn bool placer_finales(t_finales *finales, const uint16_t *donnees, uint64_t nombre)
+ * 
+ * @brief Cette fonction retrouve les tables des finales dans des données assemblées par assembler_finales
+ * 
+ * @param finales Reçoit les tables, qui pointent dans les données
+ * @param donnees Les données, alignées sur 8 octets, par exemple les valeurs d'une table projetée
+ * @param nombre Le nombre de uint16_t des données
+ * @return true si les données forment des tables complètes
+ * @return false sinon
+ * 
+ * Ne lit que la dernière entrée de chaque table : les autres pages ne sont chargées qu'à la première lecture
+ */
+bool placer_finales(t_finales *finales, const uint16_t *donnees, uint64_t nombre) {
+    uint64_t position;
+
+    memset(finales, 0, sizeof(t_finales));
+    position = 0;
+
+    for (int tours = 1; tours <= 2 * LIBRES_FINALES_MAX && position < nombre; tours++) {
+        t_table_finale *table;
+        uint64_t paires;
+
+        table = &finales->tables[tours];
+        table->classes_joueur = CLASSES_PAR_LIBRES[(tours + 1) / 2];
+        table->classes_adversaire = CLASSES_PAR_LIBRES[tours / 2];
+        paires = (uint64_t) table->classes_joueur * table->classes_adversaire;
+        if (position + paires * (sizeof(t_entree_finale) / sizeof(uint16_t)) > nombre) {
+            return false;
+        }
+
+        table->entrees = (const t_entree_finale *) (donnees + position);
+        table->valeurs = donnees + position + paires * (sizeof(t_entree_finale) / sizeof(uint16_t));
+        table->nombre_valeurs = table->entrees[paires - 1].debut + table->entrees[paires - 1].nombre;
+        position = position + taille_table_finale(table);
+        if (position > nombre) {
+            return false;
+        }
+        finales->libres = (tours + 1) / 2;
+
+        if (position == nombre) {
+            return tours % 2 == 0;
+        }
+    }
+
+    return false;
+}
+
+/*********************************
+ *      CONSEILS DE RELANCE      *
+ *********************************/
+
+/**
+ * @fn int classer_conseils(const t_valeurs_tour *valeurs, t_des des, int relances_restantes, double base,
+ *                          t_conseil conseils[NOMBRE_MASQUES])
+ * 
+ * @brief Cette fonction évalue les 32 façons de relancer les dés à partir des valeurs d'un tour et les classe de la
+ * meilleure à la moins bonne
+ * 
+ * @param valeurs Les valeurs du tour
+ * @param des Les 5 dés du joueur
+ * @param relances_restantes Le nombre de relances encore possibles, au moins 1
+ * @param base La valeur ajoutée à celle de chaque garde, par exemple le total actuel de la feuille
+ * @param conseils Les NOMBRE_MASQUES conseils (32 au jeu classique) classés par valeur décroissante, à égalité
+ * celui qui relance le moins de dés en premier
+ * @return int le nombre de conseils, NOMBRE_MASQUES
+ * 
+ * Ne pas relancer (masque 0) fait partie des conseils
+ */
+int classer_conseils(const t_valeurs_tour *valeurs, t_des des, int relances_restantes, double base,
+                     t_conseil conseils[NOMBRE_MASQUES]) {
+    for (int relance = 0; relance < NOMBRE_MASQUES; relance++) {
+        t_conseil conseil;
+        int garde;
+        int j;
+
+        garde = INDICE_PAR_HISTOGRAMME[code_histogramme(des, ~relance & MASQUE_DES)];
+        conseil.masque_relance = relance;
+        conseil.esperance = base + valeurs->gardes[relances_restantes][garde];
+
+        j = relance;
+        while (j > 0 && (conseils[j - 1].esperance < conseil.esperance
+                         || (conseils[j - 1].esperance == conseil.esperance
+                             && __builtin_popcount(conseils[j - 1].masque_relance)
+                                > __builtin_popcount(conseil.masque_relance)))) {
+            conseils[j] = conseils[j - 1];
+            j = j - 1;
+        }
+        conseils[j] = conseil;
+    }
+
+    return NOMBRE_MASQUES;
+}
+
+/**
+ * @fn int conseiller_relance(t_contexte_optimal *contexte, t_des des, t_score scores, int relances_restantes, t_conseil conseils[NOMBRE_MASQUES])
+ * 
+ * @brief Cette fonction évalue les 32 façons de relancer les dés et les classe de la meilleure à la moins bonne
+ * 
+ * @param contexte Le contexte de la stratégie optimale, dont les valeurs du tour sont réutilisées d'un appel à
+ * l'autre tant que l'état de la feuille ne change pas
+ * @param des Les 5 dés du joueur
+ * @param scores La feuille de score du joueur
+ * @param relances_restantes Le nombre de relances encore possibles, au moins 1
+ * @param conseils Les NOMBRE_MASQUES conseils (32 au jeu classique) classés par score final espéré décroissant, à
+ * égalité celui qui relance le moins de dés en premier
+ * @return int le nombre de conseils, NOMBRE_MASQUES
+ * 
+ * Le score final espéré d'une relance est le total actuel de la feuille plus l'espérance de la garde des dés
+ * conservés, lue dans les valeurs du tour. Ne pas relancer (masque 0) fait partie des conseils.
+ * Une fois les valeurs du tour calculées pour un état, chaque appel ne coûte que 32 lectures et un tri.
+ */
+int conseiller_relance(t_contexte_optimal *contexte, t_des des, t_score scores, int relances_restantes,
+                       t_conseil conseils[NOMBRE_MASQUES]) {
+    t_etat_joueur etat;
+
+    etat = resumer_feuille(scores);
+    if (contexte->etat != ETAT_CLE_SOLVEUR(etat)) {
+        calculer_valeurs_tour(contexte->esperances, ETAT_MASQUE(etat), ETAT_SUP_PLAFONNE(etat), &contexte->valeurs);
+        contexte->etat = ETAT_CLE_SOLVEUR(etat);
+    }
+
+    return classer_conseils(&contexte->valeurs, des, relances_restantes, ETAT_TOTAL(etat), conseils);
+}
+
+/**
+ * @fn void afficher_conseils(t_conseil conseils[], int nombre)
+ * 
+ * @brief Cette procédure affiche les meilleurs conseils de relance
+ * 
+ * @param conseils Les conseils classés, voir conseiller_relance
+ * @param nombre Le nombre de conseils à afficher
+ */
+void afficher_conseils(t_conseil conseils[], int nombre) {
+    printf("Conseils (score final espéré) :\n");
+
+    for (int i = 0; i < nombre; i++) {
+        if (conseils[i].masque_relance == 0) {
+            printf(" - ne pas relancer : %.1f\n", conseils[i].esperance);
+        }
+        else {
+            printf(" - relancer les dés");
+            for (int j = 0; j < NOMBRE_DES; j++) {
+                if (conseils[i].masque_relance & (1 << j)) {
+                    printf(" %d", j + 1);
+                }
+            }
+            printf(" : %.1f\n", conseils[i].esperance);
+        }
+    }
+}
+
+/*********************************
+ *  TABLES PROJETÉES EN MÉMOIRE  *
+ *********************************/
+
+/**
+ * @fn uint64_t somme_controle(const void *donnees, size_t taille)
+ * 
+ * @brief Cette fonction calcule la somme de contrôle FNV-1a sur 64 bits d'une zone mémoire
+ * 
+ * @param donnees La zone mémoire
+ * @param taille Sa taille en octets
+ * @return uint64_t la somme de contrôle
+ */
+uint64_t somme_controle(const void *donnees, size_t taille) {
+    const uint8_t *octets;
+    uint64_t somme;
+
+    octets = donnees;
+    somme = 14695981039346656037ULL;
+
+    for (size_t i = 0; i < taille; i++) {
+        somme = (somme ^ octets[i]) * 1099511628211ULL;
+    }
+
+    return somme;
+}
+
+/**
+ * @fn bool ecrire_table(const char *chemin, uint32_t type, const void *valeurs, uint64_t nombre_valeurs, uint32_t taille_valeur)
+ * 
+ * @brief Cette fonction enregistre une table de valeurs de taille fixe dans un fichier
+ * 
+ * @param chemin Le chemin du fichier
+ * @param type Le type de la table, par exemple TABLE_ESPERANCES
+ * @param valeurs Les valeurs à enregistrer
+ * @param nombre_valeurs Le nombre de valeurs
+ * @param taille_valeur La taille d'une valeur en octets
+ * @return true si le fichier a été écrit
+ * @return false en cas d'erreur
+ * 
+ * Le fichier est d'abord écrit sous un nom temporaire puis renommé, pour qu'un processus qui projette déjà
+ * l'ancienne table ne voie jamais un fichier à moitié écrit
+ */
+bool ecrire_table(const char *chemin, uint32_t type, const void *valeurs, uint64_t nombre_valeurs,
+                  uint32_t taille_valeur) {
+    t_entete_table entete;
+    char temporaire[4096];
+    FILE *fichier;
+    bool resultat;
+
+    memset(&entete, 0, sizeof(entete));
+    memcpy(entete.magie, "YAMSTBL", 8);
+    entete.version = VERSION_TABLES;
+    entete.marqueur_ordre = 0x01020304;
+    entete.variante = VARIANTE_REGLES;
+    entete.type = type;
+    entete.taille_valeur = taille_valeur;
+    entete.nombre_valeurs = nombre_valeurs;
+    entete.somme_valeurs = somme_controle(valeurs, nombre_valeurs * taille_valeur);
+    entete.somme_entete = somme_controle(&entete, offsetof(t_entete_table, somme_entete));
+
+    snprintf(temporaire, sizeof(temporaire), "%s.tmp", chemin);
+    fichier = fopen(temporaire, "wb");
+    if (fichier == NULL) {
+        return false;
+    }
+
+    resultat = fwrite(&entete, sizeof(entete), 1, fichier) == 1
+            && fwrite(valeurs, taille_valeur, nombre_valeurs, fichier) == nombre_valeurs;
+    resultat = fclose(fichier) == 0 && resultat;
+
+    if (!resultat || rename(temporaire, chemin) != 0) {
+        remove(temporaire);
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @fn bool projeter_table(const char *chemin, uint32_t type, uint32_t taille_valeur, t_table_projetee *table)
+ * 
+ * @brief Cette fonction projette une table enregistrée en mémoire, en lecture seule
+ * 
+ * @param chemin Le chemin du fichier
+ * @param type Le type de table attendu
+ * @param taille_valeur La taille attendue d'une valeur en octets
+ * @param table La table projetée, dont les valeurs se lisent directement dans le fichier
+ * @return true si la table a été projetée
+ * @return false si le fichier est absent, tronqué, corrompu, d'un autre format ou d'une autre variante des règles
+ * 
+ * Consiste à vérifier l'entête puis à laisser le système charger les pages à la première lecture. L'ouverture
+ * ne lit pas les valeurs et les processus qui projettent le même fichier partagent les mêmes pages physiques.
+ */
+bool projeter_table(const char *chemin, uint32_t type, uint32_t taille_valeur, t_table_projetee *table) {
+    const t_entete_table *entete;
+    struct stat informations;
+    void *projection;
+    int descripteur;
+
+    descripteur = open(chemin, O_RDONLY);
+    if (descripteur == -1) {
+        return false;
+    }
+
+    if (fstat(descripteur, &informations) != 0 || (size_t) informations.st_size < sizeof(t_entete_table)) {
+        close(descripteur);
+        return false;
+    }
+
+    projection = mmap(NULL, informations.st_size, PROT_READ, MAP_SHARED, descripteur, 0);
+    close(descripteur);
+    if (projection == MAP_FAILED) {
+        return false;
+    }
+
+    entete = projection;
+    if (memcmp(entete->magie, "YAMSTBL", 8) != 0
+        || entete->somme_entete != somme_controle(entete, offsetof(t_entete_table, somme_entete))
+        || entete->version != VERSION_TABLES || entete->marqueur_ordre != 0x01020304
+        || entete->variante != VARIANTE_REGLES || entete->type != type || entete->taille_valeur != taille_valeur
+        || entete->nombre_valeurs * taille_valeur != informations.st_size - sizeof(t_entete_table)) {
+        munmap(projection, informations.st_size);
+        return false;
+    }
+
+    table->entete = entete;
+    table->valeurs = (const uint8_t *) projection + sizeof(t_entete_table);
+    table->taille = informations.st_size;
+    return true;
+}
+
+/**
+ * @fn bool verifier_table(t_table_projetee *table)
+ * 
+ * @brief Cette fonction vérifie la somme de contrôle des valeurs d'une table projetée
+ * 
+ * @param table La table projetée
+ * @return true si les valeurs sont intactes
+ * @return false sinon
+ * 
+ * Cette vérification lit toute la table, elle est réservée au mode verifier et aux outils hors ligne
+ */
+bool verifier_table(t_table_projetee *table) {
+    return table->entete->somme_valeurs
+        == somme_controle(table->valeurs, table->entete->nombre_valeurs * table->entete->taille_valeur);
+}
+
+/**
+ * @fn void liberer_table(t_table_projetee *table)
+ * 
+ * @brief Cette procédure libère la projection d'une table
+ * 
+ * @param table La table projetée
+ */
+void liberer_table(t_table_projetee *table) {
+    munmap((void *) table->entete, table->taille);
+    table->entete = NULL;
+    table->valeurs = NULL;
+    table->taille = 0;
+}
+
+/*********************************
+ *   SIMULATION EN PROCESSUS     *
+ *********************************/
+
+/**
+ * @brief Raccourci associé à la version du format des fichiers de reprise
+ * 
+ */
+#define VERSION_REPRISE 1
+
+/**
+ * @brief Raccourci associé au nombre de tranches de chaque thread entre deux publications d'un fragment
+ * 
+ * Une étape d'un fragment joue nombre_threads * TRANCHES_PAR_ETAPE tranches de FLUX_PAR_TRANCHE blocs, soit
+ * 262144 parties avec un seul thread, avant de publier ses résultats dans la mémoire partagée
+ * 
+ */
+#define TRANCHES_PAR_ETAPE 4
+
+/**
+ * @brief Raccourci associé au temps minimal entre deux écritures du fichier de reprise d'un fragment, en secondes
+ * 
+ */
+#define SECONDES_ENTRE_REPRISES 10.0
+
+/**
+ * @brief Raccourci associé au nombre de fois qu'un fragment arrêté avant la fin est relancé par le coordinateur
+ * 
+ */
+#define RELANCES_FRAGMENT_MAX 3
+
+/**
+ * @brief Représente l'avancement d'un fragment : le prochain bloc à jouer et les résultats des blocs déjà joués
+ * 
+ */
+typedef struct {
+    long bloc_suivant;
+    t_resultats resultats;
+} t_avancement_fragment;
+
+/**
+ * @brief Représente un fragment d'une simulation en plusieurs processus, dans la mémoire partagée
+ * 
+ * Le fragment joue les blocs de PARTIES_PAR_FLUX parties de premier_bloc (inclus) à fin_bloc (exclu). Son
+ * processus publie son avancement dans la copie qui n'est pas désignée par copie puis la désigne : la copie
+ * désignée est toujours complète, même si le processus est tué au milieu d'une publication. Les deux compteurs
+ * atomiques ne servent qu'à l'affichage de la progression.
+ * 
+ */
+typedef struct {
+    long premier_bloc;
+    long fin_bloc;
+    atomic_int copie;
+    atomic_long parties;
+    atomic_llong somme_scores;
+    t_avancement_fragment copies[2];
+} t_fragment;
+
+/**
+ * @brief Représente une simulation répartie entre plusieurs processus
+ * 
+ * Les blocs de la simulation sont partagés en nombre_fragments plages consécutives, chacune jouée par un
+ * processus avec nombre_threads threads. dossier vaut NULL pour une simulation sans fichiers de reprise.
+ * 
+ */
+typedef struct {
+    t_strategie *strategie;
+    long nombre;
+    uint64_t graine;
+    int nombre_fragments;
+    int nombre_threads;
+    const char *dossier;
+    t_fragment *fragments;
+} t_simulation_processus;
+
+/**
+ * @brief Représente l'entête d'un fichier de reprise, suivie des résultats du fragment
+ * 
+ * Les champs jusqu'à bloc_suivant exclu identifient la simulation et le fragment : une reprise n'est acceptée que
+ * s'ils sont identiques à ceux de la simulation relancée.
+ * 
+ */
+typedef struct {
+    char magie[8];
+    uint32_t version;
+    uint32_t taille_resultats;
+    uint64_t variante;
+    uint64_t graine;
+    int64_t nombre;
+    int32_t nombre_fragments;
+    int32_t fragment;
+    char strategie[64];
+    int64_t bloc_suivant;
+    uint64_t somme_resultats;
+    uint64_t somme_entete;
+} t_entete_reprise;
+
+/**
+ * @fn void preparer_entete_reprise(const t_simulation_processus *simulation, int fragment, t_entete_reprise *entete)
+ * 
+ * @brief Cette procédure remplit les champs d'identification de l'entête de reprise d'un fragment
+ * 
+ * @param simulation La simulation
+ * @param fragment Le numéro du fragment
+ * @param entete L'entête, dont les autres champs sont mis à zéro
+ */
+void preparer_entete_reprise(const t_simulation_processus *simulation, int fragment, t_entete_reprise *entete) {
+    memset(entete, 0, sizeof(*entete));
+    memcpy(entete->magie, "YAMSREP", 8);
+    entete->version = VERSION_REPRISE;
+    entete->taille_resultats = sizeof(t_resultats);
+    entete->variante = VARIANTE_REGLES;
+    entete->graine = simulation->graine;
+    entete->nombre = simulation->nombre;
+    entete->nombre_fragments = simulation->nombre_fragments;
+    entete->fragment = fragment;
+    strncpy(entete->strategie, simulation->strategie->nom, sizeof(entete->strategie) - 1);
+}
+
+/**
+ * @fn bool ecrire_reprise(const t_simulation_processus *simulation, int fragment,
+ *                         const t_avancement_fragment *avancement)
+ * 
+ * @brief Cette fonction enregistre l'avancement d'un fragment dans son fichier de reprise
+ * 
+ * @param simulation La simulation, avec un dossier de reprise
+ * @param fragment Le numéro du fragment
+ * @param avancement L'avancement du fragment
+ * @return true si le fichier a été écrit
+ * @return false en cas d'erreur
+ * 
+ * Comme pour les tables, le fichier est écrit sous un nom temporaire puis renommé : un processus tué pendant
+ * l'écriture laisse intacte la reprise précédente
+ */
+bool ecrire_reprise(const t_simulation_processus *simulation, int fragment, const t_avancement_fragment *avancement) {
+    t_entete_reprise entete;
+    char chemin[4096];
+    char temporaire[4096];
+    FILE *fichier;
+    bool resultat;
+
+    preparer_entete_reprise(simulation, fragment, &entete);
+    entete.bloc_suivant = avancement->bloc_suivant;
+    entete.somme_resultats = somme_controle(&avancement->resultats, sizeof(t_resultats));
+    entete.somme_entete = somme_controle(&entete, offsetof(t_entete_reprise, somme_entete));
+
+    snprintf(chemin, sizeof(chemin), "%s/fragment-%03d.bin", simulation->dossier, fragment);
+    snprintf(temporaire, sizeof(temporaire), "%s/fragment-%03d.bin.tmp", simulation->dossier, fragment);
+    fichier = fopen(temporaire, "wb");
+    if (fichier == NULL) {
+        return false;
+    }
+
+    resultat = fwrite(&entete, sizeof(entete), 1, fichier) == 1
+            && fwrite(&avancement->resultats, sizeof(t_resultats), 1, fichier) == 1;
+    resultat = fclose(fichier) == 0 && resultat;
+
+    if (!resultat || rename(temporaire, chemin) != 0) {
+        remove(temporaire);
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @fn int lire_reprise(const t_simulation_processus *simulation, int fragment, t_avancement_fragment *avancement)
+ * 
+ * @brief Cette fonction relit l'avancement d'un fragment dans son fichier de reprise
+ * 
+ * @param simulation La simulation, avec un dossier de reprise et ses fragments découpés
+ * @param fragment Le numéro du fragment
+ * @param avancement L'avancement relu
+ * @return int 1 si l'avancement a été relu, 0 si le fichier est absent, tronqué ou corrompu, -1 s'il appartient
+ * à une autre simulation. L'avancement n'est modifié que si la fonction renvoie 1
+ */
+int lire_reprise(const t_simulation_processus *simulation, int fragment, t_avancement_fragment *avancement) {
+    t_entete_reprise attendue;
+    t_entete_reprise entete;
+    t_resultats resultats;
+    char chemin[4096];
+    FILE *fichier;
+    bool lu;
+
+    snprintf(chemin, sizeof(chemin), "%s/fragment-%03d.bin", simulation->dossier, fragment);
+    fichier = fopen(chemin, "rb");
+    if (fichier == NULL) {
+        return 0;
+    }
+    lu = fread(&entete, sizeof(entete), 1, fichier) == 1
+      && fread(&resultats, sizeof(t_resultats), 1, fichier) == 1;
+    fclose(fichier);
+
+    if (!lu || entete.somme_entete != somme_controle(&entete, offsetof(t_entete_reprise, somme_entete))
+        || entete.somme_resultats != somme_controle(&resultats, sizeof(t_resultats))) {
+        return 0;
+    }
+
+    preparer_entete_reprise(simulation, fragment, &attendue);
+    if (memcmp(&entete, &attendue, offsetof(t_entete_reprise, bloc_suivant)) != 0
+        || entete.bloc_suivant < simulation->fragments[fragment].premier_bloc
+        || entete.bloc_suivant > simulation->fragments[fragment].fin_bloc) {
+        return -1;
+    }
+
+    avancement->resultats = resultats;
+    avancement->bloc_suivant = entete.bloc_suivant;
+    return 1;
+}
+
+/**
+ * @fn void publier_avancement(t_fragment *fragment, const t_avancement_fragment *avancement)
+ * 
+ * @brief Cette procédure publie l'avancement d'un fragment dans la mémoire partagée
+ * 
+ * @param fragment Le fragment
+ * @param avancement Son nouvel avancement
+ */
+void publier_avancement(t_fragment *fragment, const t_avancement_fragment *avancement) {
+    int copie;
+
+    copie = 1 - atomic_load_explicit(&fragment->copie, memory_order_relaxed);
+    fragment->copies[copie] = *avancement;
+    atomic_store_explicit(&fragment->copie, copie, memory_order_release);
+
+    atomic_store_explicit(&fragment->parties, avancement->resultats.nombre_parties, memory_order_relaxed);
+    atomic_store_explicit(&fragment->somme_scores, avancement->resultats.somme_scores, memory_order_relaxed);
+}
+
+/**
+ * @fn bool executer_fragment(t_simulation_processus *simulation, int numero)
+ * 
+ * @brief Cette fonction joue la fin d'un fragment, dans le processus qui lui est dédié
+ * 
+ * @param simulation La simulation
+ * @param numero Le numéro du fragment
+ * @return true si le fragment a été joué jusqu'au bout
+ * @return false si la mémoire a manqué ou si un fichier de reprise n'a pas pu être écrit
+ * 
+ * Le fragment reprend à la dernière copie publiée. Chaque étape est jouée par simuler_flux_paralleles à partir du
+ * flux de son premier bloc, de sorte que les parties jouées ne dépendent ni du découpage en fragments, ni des
+ * reprises : ce sont celles de simuler_parties avec la même graine. Le fichier de reprise est réécrit au plus
+ * toutes les SECONDES_ENTRE_REPRISES secondes, et toujours à la fin du fragment.
+ */
+bool executer_fragment(t_simulation_processus *simulation, int numero) {
+    t_fragment *fragment;
+    t_avancement_fragment avancement;
+    t_resultats etape;
+    t_generateur flux;
+    long taille_etape;
+    long blocs;
+    long parties;
+    double derniere_reprise;
+
+    fragment = &simulation->fragments[numero];
+    avancement = fragment->copies[atomic_load_explicit(&fragment->copie, memory_order_acquire)];
+    taille_etape = (long) simulation->nombre_threads * TRANCHES_PAR_ETAPE * FLUX_PAR_TRANCHE;
+    initialiser_flux(&flux, simulation->graine, avancement.bloc_suivant);
+    derniere_reprise = secondes_ecoulees();
+
+    while (avancement.bloc_suivant < fragment->fin_bloc) {
+        blocs = fragment->fin_bloc - avancement.bloc_suivant;
+        if (blocs > taille_etape) {
+            blocs = taille_etape;
+        }
+        parties = blocs * PARTIES_PAR_FLUX;
+        if (parties > simulation->nombre - avancement.bloc_suivant * PARTIES_PAR_FLUX) {
+            parties = simulation->nombre - avancement.bloc_suivant * PARTIES_PAR_FLUX;
+        }
+
+        if (!simuler_flux_paralleles(parties, simulation->strategie, &flux, simulation->nombre_threads, false,
+                                     &etape)) {
+            fprintf(stderr, "\nMémoire insuffisante pour jouer le fragment %d\n", numero);
+            return false;
+        }
+        fusionner_resultats(&avancement.resultats, &etape);
+        for (long b = 0; b < blocs; b++) {
+            sauter_generateur(&flux);
+        }
+        avancement.bloc_suivant = avancement.bloc_suivant + blocs;
+        publier_avancement(fragment, &avancement);
+
+        if (simulation->dossier != NULL && (avancement.bloc_suivant == fragment->fin_bloc
+                                            || secondes_ecoulees() - derniere_reprise >= SECONDES_ENTRE_REPRISES)) {
+            if (!ecrire_reprise(simulation, numero, &avancement)) {
+                fprintf(stderr, "\nImpossible d'écrire la reprise du fragment %d dans %s\n", numero,
+                        simulation->dossier);
+                return false;
+            }
+            derniere_reprise = secondes_ecoulees();
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @fn pid_t lancer_fragment(t_simulation_processus *simulation, int numero)
+ * 
+ * @brief Cette fonction crée le processus qui joue un fragment
+ * 
+ * @param simulation La simulation
+ * @param numero Le numéro du fragment
+ * @return pid_t l'identifiant du processus, -1 en cas d'erreur
+ * 
+ * Le processus hérite des stratégies et des tables déjà chargées. Il est tué si le coordinateur meurt, pour ne
+ * jamais laisser un fragment orphelin écrire dans le dossier de reprise d'une simulation relancée.
+ */
+pid_t lancer_fragment(t_simulation_processus *simulation, int numero) {
+    pid_t coordinateur;
+    pid_t processus;
+
+    coordinateur = getpid();
+    fflush(stdout);
+    fflush(stderr);
+    processus = fork();
+    if (processus != 0) {
+        return processus;
+    }
+
+    prctl(PR_SET_PDEATHSIG, SIGKILL);
+    if (getppid() != coordinateur) {
+        _exit(EXIT_FAILURE);
+    }
+    _exit(executer_fragment(simulation, numero) ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+/**
+ * @fn bool simuler_parties_processus(t_simulation_processus *simulation, bool progression, t_resultats *resultats)
+ * 
+ * @brief Cette fonction simule une série de parties répartie entre plusieurs processus, avec reprise
+ * 
+ * @param simulation La simulation, sans ses fragments qui sont découpés ici
+ * @param progression Vrai pour afficher chaque seconde la progression sur la sortie d'erreur
+ * @param resultats Les résultats agrégés de la série, les mêmes que ceux de simuler_parties
+ * @return true si tous les fragments ont été joués
+ * @return false si la reprise appartient à une autre simulation ou si un fragment a échoué
+ * 
+ * Le coordinateur découpe les blocs en plages consécutives, relit la reprise de chaque fragment puis crée un
+ * processus par fragment inachevé. Les fragments publient leurs résultats dans un segment de mémoire partagée,
+ * que le coordinateur additionne quand tous sont terminés. Un fragment arrêté avant la fin (tué, plantage) est
+ * relancé jusqu'à RELANCES_FRAGMENT_MAX fois à partir de sa dernière publication, sans rejouer ses blocs terminés ;
+ * si le coordinateur lui-même est arrêté, relancer la même simulation avec le même dossier reprend chaque fragment
+ * à son dernier fichier de reprise.
+ */
+bool simuler_parties_processus(t_simulation_processus *simulation, bool progression, t_resultats *resultats) {
+    t_fragment *fragments;
+    pid_t *processus;
+    int *relances;
+    struct timespec attente;
+    long nombre_blocs;
+    long parties_initiales;
+    int actifs;
+    bool reussite;
+    double debut;
+    double affichage;
+
+    nombre_blocs = (simulation->nombre + PARTIES_PAR_FLUX - 1) / PARTIES_PAR_FLUX;
+    fragments = mmap(NULL, simulation->nombre_fragments * sizeof(t_fragment), PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (fragments == MAP_FAILED) {
+        fprintf(stderr, "Impossible de créer la mémoire partagée des fragments\n");
+        return false;
+    }
+    simulation->fragments = fragments;
+
+    reussite = true;
+    parties_initiales = 0;
+    for (int f = 0; f < simulation->nombre_fragments; f++) {
+        fragments[f].premier_bloc = nombre_blocs * f / simulation->nombre_fragments;
+        fragments[f].fin_bloc = nombre_blocs * (f + 1) / simulation->nombre_fragments;
+        atomic_init(&fragments[f].copie, 0);
+        fragments[f].copies[0].bloc_suivant = fragments[f].premier_bloc;
+
+        if (simulation->dossier != NULL && lire_reprise(simulation, f, &fragments[f].copies[0]) == -1) {
+            fprintf(stderr, "La reprise du fragment %d dans %s appartient à une autre simulation\n", f,
+                    simulation->dossier);
+            reussite = false;
+        }
+        else if (simulation->dossier != NULL && fragments[f].copies[0].bloc_suivant > fragments[f].premier_bloc) {
+            fprintf(stderr, "Fragment %d repris au bloc %ld sur %ld\n", f, fragments[f].copies[0].bloc_suivant,
+                    fragments[f].fin_bloc);
+        }
+        atomic_init(&fragments[f].parties, fragments[f].copies[0].resultats.nombre_parties);
+        atomic_init(&fragments[f].somme_scores, fragments[f].copies[0].resultats.somme_scores);
+        parties_initiales = parties_initiales + fragments[f].copies[0].resultats.nombre_parties;
+    }
+    if (!reussite) {
+        munmap(fragments, simulation->nombre_fragments * sizeof(t_fragment));
+        return false;
+    }
+
+    processus = calloc(simulation->nombre_fragments, sizeof(pid_t));
+    relances = calloc(simulation->nombre_fragments, sizeof(int));
+    actifs = 0;
+    for (int f = 0; f < simulation->nombre_fragments; f++) {
+        if (fragments[f].copies[0].bloc_suivant < fragments[f].fin_bloc) {
+            processus[f] = lancer_fragment(simulation, f);
+            if (processus[f] == -1) {
+                fprintf(stderr, "Impossible de créer le processus du fragment %d\n", f);
+                processus[f] = 0;
+                reussite = false;
+            }
+            else {
+                actifs = actifs + 1;
+            }
+        }
+    }
+
+    debut = secondes_ecoulees();
+    affichage = debut;
+    attente.tv_sec = 0;
+    attente.tv_nsec = 100000000;
+    while (actifs > 0) {
+        pid_t termine;
+        int statut;
+        int f;
+
+        termine = waitpid(-1, &statut, WNOHANG);
+        if (termine == -1 && errno != EINTR) {
+            break;
+        }
+        if (termine <= 0) {
+            nanosleep(&attente, NULL);
+            if (progression && secondes_ecoulees() - affichage >= 1.0) {
+                long parties;
+                long long somme;
+
+                parties = 0;
+                somme = 0;
+                for (int g = 0; g < simulation->nombre_fragments; g++) {
+                    parties = parties + atomic_load_explicit(&fragments[g].parties, memory_order_relaxed);
+                    somme = somme + atomic_load_explicit(&fragments[g].somme_scores, memory_order_relaxed);
+                }
+                affichage = secondes_ecoulees();
+                afficher_progression(parties, somme, simulation->nombre, parties_initiales, affichage - debut);
+            }
+            continue;
+        }
+
+        f = 0;
+        while (f < simulation->nombre_fragments && processus[f] != termine) {
+            f = f + 1;
+        }
+        if (f == simulation->nombre_fragments) {
+            continue;
+        }
+        processus[f] = 0;
+        actifs = actifs - 1;
+        if (WIFEXITED(statut) && WEXITSTATUS(statut) == EXIT_SUCCESS) {
+            continue;
+        }
+
+        if (relances[f] < RELANCES_FRAGMENT_MAX) {
+            relances[f] = relances[f] + 1;
+            fprintf(stderr, "\nLe processus du fragment %d s'est arrêté, reprise au bloc %ld\n", f,
+                    fragments[f].copies[atomic_load_explicit(&fragments[f].copie, memory_order_acquire)].bloc_suivant);
+            processus[f] = lancer_fragment(simulation, f);
+            if (processus[f] != -1) {
+                actifs = actifs + 1;
+                continue;
+            }
+            processus[f] = 0;
+        }
+        fprintf(stderr, "\nAbandon du fragment %d\n", f);
+        reussite = false;
+    }
+    if (progression) {
+        fprintf(stderr, "\n");
+    }
+    if (!reussite && simulation->dossier != NULL) {
+        fprintf(stderr, "Simulation incomplète, relancez la même commande pour reprendre depuis %s\n",
+                simulation->dossier);
+    }
+
+    memset(resultats, 0, sizeof(*resultats));
+    for (int f = 0; f < simulation->nombre_fragments; f++) {
+        fusionner_resultats(resultats, &fragments[f].copies[atomic_load(&fragments[f].copie)].resultats);
+    }
+
+    free(relances);
+    free(processus);
+    munmap(fragments, simulation->nombre_fragments * sizeof(t_fragment));
+    simulation->fragments = NULL;
+    return reussite;
+}
+
+/*********************************
+ *      JOURNAL DES PARTIES      *
+ *********************************/
+
+/**
+ * @fn bool ouvrir_journal(t_journal *journal, const char *chemin)
+ * 
+ * @brief Cette fonction crée un journal de parties et écrit son entête
+ * 
+ * @param journal Le journal
+ * @param chemin Le chemin du fichier, - pour la sortie standard
+ * @return true si le journal est ouvert
+ * @return false si le fichier n'a pas pu être créé ou si la mémoire manque pour le bloc en cours
+ */
+bool ouvrir_journal(t_journal *journal, const char *chemin) {
+    t_entete_journal entete;
+
+    journal->fichier = strcmp(chemin, "-") == 0 ? stdout : fopen(chemin, "wb");
+    if (journal->fichier == NULL) {
+        return false;
+    }
+
+    journal->capacite = 2 * TAILLE_BLOC_JOURNAL;
+    journal->tampon = malloc(journal->capacite);
+    if (journal->tampon == NULL) {
+        if (journal->fichier != stdout) {
+            fclose(journal->fichier);
+        }
+        return false;
+    }
+    journal->longueur = 0;
+    journal->nombre_parties = 0;
+    journal->bits = 0;
+    journal->nombre_bits = 0;
+    journal->erreur = false;
+
+    memset(&entete, 0, sizeof(entete));
+    memcpy(entete.magie, "YAMSLOG", 8);
+    entete.version = VERSION_JOURNAL;
+    entete.marqueur_ordre = 0x01020304;
+    journal->erreur = fwrite(&entete, sizeof(entete), 1, journal->fichier) != 1;
+    journal->octets_ecrits = sizeof(entete);
+
+    return true;
+}
+
+/**
+ * @fn void ecrire_bloc_journal(t_journal *journal)
+ * 
+ * @brief Cette procédure écrit le bloc en cours dans le fichier, précédé de son entête
+ * 
+ * @param journal Le journal
+ */
+void ecrire_bloc_journal(t_journal *journal) {
+    t_entete_bloc entete;
+
+    if (journal->nombre_parties == 0) {
+        return;
+    }
+
+    entete.taille = journal->longueur;
+    entete.nombre_parties = journal->nombre_parties;
+    entete.somme = somme_controle(journal->tampon, journal->longueur);
+    if (fwrite(&entete, sizeof(entete), 1, journal->fichier) != 1
+        || fwrite(journal->tampon, 1, journal->longueur, journal->fichier) != journal->longueur) {
+        journal->erreur = true;
+    }
+
+    journal->octets_ecrits = journal->octets_ecrits + sizeof(entete) + journal->longueur;
+    journal->longueur = 0;
+    journal->nombre_parties = 0;
+}
+
+/**
+ * @fn void ecrire_bits(t_journal *journal, uint32_t valeur, int nombre)
+ * 
+ * @brief Cette procédure ajoute des bits à la partie en cours, les bits de poids faible en premier
+ * 
+ * @param journal Le journal
+ * @param valeur La valeur à écrire
+ * @param nombre Le nombre de bits de la valeur, au plus 32
+ */
+void ecrire_bits(t_journal *journal, uint32_t valeur, int nombre) {
+    journal->bits = journal->bits | ((uint64_t) valeur << journal->nombre_bits);
+    journal->nombre_bits = journal->nombre_bits + nombre;
+
+    while (journal->nombre_bits >= 8) {
+        journal->tampon[journal->longueur] = (uint8_t) journal->bits;
+        journal->longueur = journal->longueur + 1;
+        journal->bits = journal->bits >> 8;
+        journal->nombre_bits = journal->nombre_bits - 8;
+    }
+}
+
+/**
+ * @fn void ecrire_varint(t_journal *journal, uint32_t valeur)
+ * 
+ * @brief Cette procédure écrit un entier de taille variable, 7 bits par octet, à la fin du bloc en cours
+ * 
+ * @param journal Le journal, dont le dernier octet est complet et la place réservée
+ * @param valeur L'entier
+ */
+void ecrire_varint(t_journal *journal, uint32_t valeur) {
+    while (valeur >= 128) {
+        journal->tampon[journal->longueur] = (uint8_t) (valeur | 128);
+        journal->longueur = journal->longueur + 1;
+        valeur = valeur >> 7;
+    }
+    journal->tampon[journal->longueur] = (uint8_t) valeur;
+    journal->longueur = journal->longueur + 1;
+}
+
+/**
+ * @fn bool commencer_partie_journal(t_journal *journal, int nombre_joueurs)
+ * 
+ * @brief Cette fonction commence l'écriture d'une partie
+ * 
+ * @param journal Le journal
+ * @param nombre_joueurs Le nombre de joueurs de la partie
+ * @return true si la partie peut être écrite
+ * @return false si la mémoire manque pour agrandir le bloc, le journal restant alors en erreur
+ * 
+ * Réserve la place de la partie entière dans le bloc en cours : 5 octets pour le nombre de joueurs, de quoi
+ * écrire un tour avec toutes ses relances (10 octets au jeu classique), 2 octets par total et 5 octets pour le
+ * vainqueur
+ */
+bool commencer_partie_journal(t_journal *journal, int nombre_joueurs) {
+    size_t octets_tour;
+    size_t necessaire;
+
+    octets_tour = (BITS_TOUR_JOURNAL + NOMBRE_RELANCES * BITS_RELANCE_JOURNAL + 7) / 8;
+    necessaire = journal->longueur + 10 + (octets_tour * 13 + 2) * (size_t) nombre_joueurs;
+    if (necessaire > journal->capacite) {
+        uint8_t *agrandi;
+
+        agrandi = realloc(journal->tampon, 2 * necessaire);
+        if (agrandi == NULL) {
+            journal->erreur = true;
+            return false;
+        }
+        journal->tampon = agrandi;
+        journal->capacite = 2 * necessaire;
+    }
+
+    ecrire_varint(journal, nombre_joueurs);
+    return true;
+}
+
+/**
+ * @fn void ecrire_tour_journal(t_journal *journal, const t_tour_journal *tour)
+ * 
+ * @brief Cette procédure ajoute un tour à la partie en cours
+ * 
+ * @param journal Le journal
+ * @param tour Le déroulement du tour
+ */
+void ecrire_tour_journal(t_journal *journal, const t_tour_journal *tour) {
+    ecrire_bits(journal, tour->relances | (tour->combinaison << 2) | (tour->lancers[0] << 6), BITS_TOUR_JOURNAL);
+
+    for (int r = 0; r < tour->relances; r++) {
+        ecrire_bits(journal, tour->masques[r] | (tour->lancers[r + 1] << NOMBRE_DES), BITS_RELANCE_JOURNAL);
+    }
+}
+
+/**
+ * @fn void terminer_partie_journal(t_journal *journal, const t_feuilles *feuilles, int vainqueur)
+ * 
+ * @brief Cette procédure termine la partie en cours et écrit son résultat, puis écrit le bloc s'il est plein
+ * 
+ * @param journal Le journal
+ * @param feuilles Les feuilles de score de la partie terminée
+ * @param vainqueur L'indice du vainqueur, donné par trouver_vainqueurs
+ */
+void terminer_partie_journal(t_journal *journal, const t_feuilles *feuilles, int vainqueur) {
+    if (journal->nombre_bits > 0) {
+        ecrire_bits(journal, 0, 8 - journal->nombre_bits);
+    }
+
+    for (int j = 0; j < feuilles->nombre_joueurs; j++) {
+        ecrire_varint(journal, 2 * ETAT_TOTAL(feuilles->etats[j]) + (ETAT_BONUS(feuilles->etats[j]) > 0));
+    }
+    ecrire_varint(journal, vainqueur);
+
+    journal->nombre_parties = journal->nombre_parties + 1;
+    if (journal->longueur >= TAILLE_BLOC_JOURNAL) {
+        ecrire_bloc_journal(journal);
+    }
+}
+
+/**
+ * @fn bool fermer_journal(t_journal *journal)
+ * 
+ * @brief Cette fonction écrit le dernier bloc et ferme le journal
+ * 
+ * @param journal Le journal
+ * @return true si tout le journal a été écrit
+ * @return false en cas d'erreur d'écriture
+ */
+bool fermer_journal(t_journal *journal) {
+    bool resultat;
+
+    ecrire_bloc_journal(journal);
+    free(journal->tampon);
+
+    if (journal->fichier == stdout) {
+        resultat = fflush(stdout) == 0;
+    }
+    else {
+        resultat = fclose(journal->fichier) == 0;
+    }
+
+    return resultat && !journal->erreur;
+}
+
+/**
+ * @brief Les dés de chaque lancer, 3 bits par dé (le dé i dans les bits 3i à 3i + 2), indicés par code_lancer
+ * 
+ */
+uint32_t DES_PAR_LANCER[NOMBRE_LANCERS];
+
+/**
+ * @brief Le masque des bits de DES_PAR_LANCER des dés désignés par un masque de dés
+ * 
+ */
+uint32_t BITS_PAR_MASQUE[NOMBRE_MASQUES];
+
+/**
+ * @fn void initialiser_tables_journal(void)
+ * 
+ * @brief Cette procédure construit les tables qui permettent de comparer deux lancers sans les décoder
+ */
+void initialiser_tables_journal(void) {
+    for (int code = 0; code < NOMBRE_LANCERS; code++) {
+        int reste;
+
+        reste = code;
+        DES_PAR_LANCER[code] = 0;
+        for (int i = NOMBRE_DES - 1; i >= 0; i--) {
+            DES_PAR_LANCER[code] = DES_PAR_LANCER[code] | ((reste % NOMBRE_FACES) << (3 * i));
+            reste = reste / NOMBRE_FACES;
+        }
+    }
+
+    for (int masque = 0; masque < NOMBRE_MASQUES; masque++) {
+        BITS_PAR_MASQUE[masque] = 0;
+        for (int i = 0; i < NOMBRE_DES; i++) {
+            if (masque & (1 << i)) {
+                BITS_PAR_MASQUE[masque] = BITS_PAR_MASQUE[masque] | (7 << (3 * i));
+            }
+        }
+    }
+}
+
+/**
+ * @fn bool agrandir_bilan_journal(t_bilan_journal *bilan, int nombre_joueurs)
+ * 
+ * @brief Cette fonction agrandit au besoin l'espace de travail d'un bilan pour une partie
+ * 
+ * @param bilan Le bilan
+ * @param nombre_joueurs Le nombre de joueurs de la partie
+ * @return true si l'espace de travail suffit pour la partie
+ * @return false si la mémoire manque, la capacité restant alors inchangée
+ */
+bool agrandir_bilan_journal(t_bilan_journal *bilan, int nombre_joueurs) {
+    t_etat_joueur *etats;
+    int *cases;
+    int *totaux;
+
+    if (nombre_joueurs <= bilan->capacite) {
+        return true;
+    }
+
+    etats = realloc(bilan->etats, nombre_joueurs * sizeof(t_etat_joueur));
+    if (etats != NULL) {
+        bilan->etats = etats;
+    }
+    cases = realloc(bilan->cases, TAILLE_FEUILLES(nombre_joueurs) * sizeof(int));
+    if (cases != NULL) {
+        bilan->cases = cases;
+    }
+    totaux = realloc(bilan->totaux, nombre_joueurs * sizeof(int));
+    if (totaux != NULL) {
+        bilan->totaux = totaux;
+    }
+    if (etats == NULL || cases == NULL || totaux == NULL) {
+        return false;
+    }
+
+    bilan->capacite = nombre_joueurs;
+    return true;
+}
+
+/**
+ * @fn void liberer_bilan_journal(t_bilan_journal *bilan)
+ * 
+ * @brief Cette procédure libère l'espace de travail d'un bilan
+ * 
+ * @param bilan Le bilan, dont les compteurs restent lisibles
+ */
+void liberer_bilan_journal(t_bilan_journal *bilan) {
+    free(bilan->etats);
+    free(bilan->cases);
+    free(bilan->totaux);
+    bilan->etats = NULL;
+    bilan->cases = NULL;
+    bilan->totaux = NULL;
+    bilan->capacite = 0;
+}
+
+/**
+ * @fn bool lire_varint(const uint8_t *donnees, size_t taille, size_t *position, uint32_t *valeur)
+ * 
+ * @brief Cette fonction lit un entier de taille variable, 7 bits par octet
+ * 
+ * @param donnees Les données
+ * @param taille La taille des données
+ * @param position La position de l'entier, avancée après lui
+ * @param valeur Reçoit l'entier
+ * @return true si l'entier a été lu
+ * @return false s'il dépasse la fin des données ou 32 bits
+ */
+bool lire_varint(const uint8_t *donnees, size_t taille, size_t *position, uint32_t *valeur) {
+    int decalage;
+
+    *valeur = 0;
+    decalage = 0;
+    do {
+        if (*position >= taille || decalage > 28) {
+            return false;
+        }
+        *valeur = *valeur | ((uint32_t) (donnees[*position] & 127) << decalage);
+        decalage = decalage + 7;
+        *position = *position + 1;
+    }
+    while (donnees[*position - 1] & 128);
+
+    return true;
+}
+
+/**
+ * @fn void decoder_lancer(int code, t_des des)
+ * 
+ * @brief Cette procédure retrouve les dés d'un lancer à partir de son code
+ * 
+ * @param code Le code du lancer, donné par code_lancer
+ * @param des Reçoit les dés
+ */
+void decoder_lancer(int code, t_des des) {
+    for (int i = NOMBRE_DES - 1; i >= 0; i--) {
+        des[i] = code % NOMBRE_FACES + 1;
+        code = code / NOMBRE_FACES;
+    }
+}
+
+/**
+ * @fn bool decoder_partie(const uint8_t *parties, size_t taille, size_t *position, t_partie_journal *partie)
+ * 
+ * @brief Cette fonction décode une partie d'un bloc du journal
+ * 
+ * @param parties Les parties du bloc
+ * @param taille La taille des parties du bloc
+ * @param position La position de la partie, avancée jusqu'à la partie suivante
+ * @param partie Reçoit les tours et le résultat annoncé de la partie
+ * @return true si la partie a été décodée
+ * @return false si elle est tronquée, si un champ sort de son domaine ou si la mémoire manque pour la décoder
+ * 
+ * Vérifie que chaque relance garde les dés qui ne sont pas relancés, sans décoder les lancers.
+ * Les tables du journal doivent avoir été construites par initialiser_tables_journal
+ */
+bool decoder_partie(const uint8_t *parties, size_t taille, size_t *position, t_partie_journal *partie) {
+    size_t indice;
+    uint64_t bits;
+    int nombre_bits;
+    uint32_t nombre_joueurs;
+    uint32_t valeur;
+
+    if (!lire_varint(parties, taille, position, &nombre_joueurs) || nombre_joueurs == 0
+        || *position + (BITS_TOUR_JOURNAL * TAILLE_FEUILLES(nombre_joueurs) + 7) / 8 > taille) {
+        return false;
+    }
+    if ((int) nombre_joueurs > partie->capacite) {
+        t_tour_journal *tours;
+        int *totaux;
+        bool *bonus;
+
+        tours = realloc(partie->tours, TAILLE_FEUILLES(nombre_joueurs) * sizeof(t_tour_journal));
+        if (tours != NULL) {
+            partie->tours = tours;
+        }
+        totaux = realloc(partie->totaux, nombre_joueurs * sizeof(int));
+        if (totaux != NULL) {
+            partie->totaux = totaux;
+        }
+        bonus = realloc(partie->bonus, nombre_joueurs * sizeof(bool));
+        if (bonus != NULL) {
+            partie->bonus = bonus;
+        }
+        if (tours == NULL || totaux == NULL || bonus == NULL) {
+            return false;
+        }
+        partie->capacite = nombre_joueurs;
+    }
+    partie->nombre_joueurs = nombre_joueurs;
+    partie->incoherences = 0;
+
+    indice = *position;
+    bits = 0;
+    nombre_bits = 0;
+    for (size_t t = 0; t < TAILLE_FEUILLES(nombre_joueurs); t++) {
+        t_tour_journal *tour;
+
+        tour = &partie->tours[t];
+        while (nombre_bits <= 56 && indice < taille) {
+            bits = bits | ((uint64_t) parties[indice] << nombre_bits);
+            nombre_bits = nombre_bits + 8;
+            indice = indice + 1;
+        }
+        if (nombre_bits < BITS_TOUR_JOURNAL) {
+            return false;
+        }
+
+        tour->relances = bits & 3;
+        tour->combinaison = (bits >> 2) & 15;
+        tour->lancers[0] = (bits >> 6) & ((1 << BITS_LANCER_JOURNAL) - 1);
+        bits = bits >> BITS_TOUR_JOURNAL;
+        nombre_bits = nombre_bits - BITS_TOUR_JOURNAL;
+        if (tour->relances > NOMBRE_RELANCES || tour->combinaison >= 13 || tour->lancers[0] >= NOMBRE_LANCERS) {
+            return false;
+        }
+
+        for (int r = 0; r < tour->relances; r++) {
+            int lancer;
+
+            while (nombre_bits < BITS_RELANCE_JOURNAL && indice < taille) {
+                bits = bits | ((uint64_t) parties[indice] << nombre_bits);
+                nombre_bits = nombre_bits + 8;
+                indice = indice + 1;
+            }
+            if (nombre_bits < BITS_RELANCE_JOURNAL) {
+                return false;
+            }
+
+            tour->masques[r] = bits & MASQUE_DES;
+            lancer = (bits >> NOMBRE_DES) & ((1 << BITS_LANCER_JOURNAL) - 1);
+            bits = bits >> BITS_RELANCE_JOURNAL;
+            nombre_bits = nombre_bits - BITS_RELANCE_JOURNAL;
+
+            if (lancer >= NOMBRE_LANCERS
+                || (DES_PAR_LANCER[tour->lancers[r]] ^ DES_PAR_LANCER[lancer]) & ~BITS_PAR_MASQUE[tour->masques[r]]
+                   & ((1U << (3 * NOMBRE_DES)) - 1)) {
+                partie->incoherences = partie->incoherences + 1;
+                lancer = tour->lancers[r];
+            }
+            tour->lancers[r + 1] = lancer;
+        }
+    }
+
+    *position = indice - nombre_bits / 8;
+    for (uint32_t j = 0; j < nombre_joueurs; j++) {
+        if (!lire_varint(parties, taille, position, &valeur)) {
+            return false;
+        }
+        partie->totaux[j] = valeur >> 1;
+        partie->bonus[j] = valeur & 1;
+    }
+    if (!lire_varint(parties, taille, position, &valeur) || valeur >= nombre_joueurs) {
+        return false;
+    }
+    partie->vainqueur = valeur;
+
+    return true;
+}
+
+/**
+ * @fn bool relire_bloc(const t_entete_bloc *entete, const uint8_t *parties, t_partie_journal *partie,
+ *                      t_bilan_journal *bilan)
+ * 
+ * @brief Cette fonction rejoue les parties d'un bloc et recalcule leurs points à partir des dés
+ * 
+ * @param entete L'entête du bloc
+ * @param parties Les parties du bloc, entete->taille octets
+ * @param partie L'espace où chaque partie est décodée
+ * @param bilan Le bilan, complété avec les parties du bloc
+ * @return true si le bloc a pu être décodé jusqu'au bout
+ * @return false si le bloc est tronqué ou incohérent, ou si la mémoire manque pour le décoder
+ * 
+ * Les points sont lus dans TABLE_POINTS et les feuilles réduites à leurs états résumés. Les relances qui changent
+ * un dé gardé et les combinaisons remplies deux fois sont comptées dans les erreurs du bilan, les résultats qui
+ * diffèrent de ceux annoncés dans ses écarts
+ */
+bool relire_bloc(const t_entete_bloc *entete, const uint8_t *parties, t_partie_journal *partie,
+                 t_bilan_journal *bilan) {
+    size_t position;
+
+    position = 0;
+    for (uint32_t p = 0; p < entete->nombre_parties; p++) {
+        int vainqueur;
+
+        if (!decoder_partie(parties, entete->taille, &position, partie)
+            || !agrandir_bilan_journal(bilan, partie->nombre_joueurs)) {
+            return false;
+        }
+        for (int j = 0; j < partie->nombre_joueurs; j++) {
+            bilan->etats[j] = 0;
+        }
+
+        for (size_t t = 0; t < TAILLE_FEUILLES(partie->nombre_joueurs); t++) {
+            const t_tour_journal *tour;
+            t_etat_joueur *etat;
+
+            tour = &partie->tours[t];
+            etat = &bilan->etats[t % partie->nombre_joueurs];
+            if (ETAT_MASQUE(*etat) & (1 << tour->combinaison)) {
+                bilan->nombre_erreurs = bilan->nombre_erreurs + 1;
+            }
+            else {
+                *etat = ajouter_points(*etat, tour->combinaison,
+                                       TABLE_POINTS[INDICE_PAR_LANCER[tour->lancers[tour->relances]]]
+                                           .points[tour->combinaison]);
+            }
+            bilan->nombre_relances = bilan->nombre_relances + tour->relances;
+        }
+
+        vainqueur = 0;
+        for (int j = 0; j < partie->nombre_joueurs; j++) {
+            bilan->somme_totaux = bilan->somme_totaux + ETAT_TOTAL(bilan->etats[j]);
+            if (ETAT_TOTAL(bilan->etats[j]) != partie->totaux[j]) {
+                bilan->ecarts_totaux = bilan->ecarts_totaux + 1;
+            }
+            if ((ETAT_BONUS(bilan->etats[j]) > 0) != partie->bonus[j]) {
+                bilan->ecarts_bonus = bilan->ecarts_bonus + 1;
+            }
+            if (ETAT_TOTAL(bilan->etats[j]) > ETAT_TOTAL(bilan->etats[vainqueur])) {
+                vainqueur = j;
+            }
+        }
+        if (vainqueur != partie->vainqueur) {
+            bilan->ecarts_vainqueurs = bilan->ecarts_vainqueurs + 1;
+        }
+
+        bilan->nombre_erreurs = bilan->nombre_erreurs + partie->incoherences;
+        bilan->nombre_totaux = bilan->nombre_totaux + partie->nombre_joueurs;
+        bilan->nombre_tours = bilan->nombre_tours + TAILLE_FEUILLES(partie->nombre_joueurs);
+        bilan->nombre_parties = bilan->nombre_parties + 1;
+    }
+
+    return position == entete->taille;
+}
+
+/**
+ * @fn bool verifier_entete_journal(const uint8_t *donnees, size_t taille)
+ * 
+ * @brief Cette fonction vérifie l'entête d'un journal et construit les tables du journal à la première lecture
+ * 
+ * @param donnees Le contenu du journal
+ * @param taille La taille du journal
+ * @return true si l'entête est celui d'un journal de la version VERSION_JOURNAL
+ * @return false sinon
+ */
+bool verifier_entete_journal(const uint8_t *donnees, size_t taille) {
+    const t_entete_journal *entete;
+
+    static pthread_once_t une_fois = PTHREAD_ONCE_INIT;
+
+    pthread_once(&une_fois, initialiser_tables_journal);
+    entete = (const t_entete_journal *) donnees;
+    return taille >= sizeof(t_entete_journal) && memcmp(entete->magie, "YAMSLOG", 8) == 0
+           && entete->version == VERSION_JOURNAL && entete->marqueur_ordre == 0x01020304;
+}
+
+/**
+ * @fn bool relire_journal(const uint8_t *donnees, size_t taille, bool verifier, t_bilan_journal *bilan)
+ * 
+ * @brief Cette fonction rejoue toutes les parties d'un journal chargé en mémoire
+ * 
+ * @param donnees Le contenu du journal, entête compris
+ * @param taille La taille du journal
+ * @param verifier Vrai pour vérifier la somme de contrôle de chaque bloc avant de le rejouer
+ * @param bilan Le bilan de la relecture, remis à zéro, à libérer par liberer_bilan_journal
+ * @return true si le journal est complet et bien formé
+ * @return false si l'entête est invalide ou si un bloc est tronqué, corrompu ou incohérent
+ */
+bool relire_journal(const uint8_t *donnees, size_t taille, bool verifier, t_bilan_journal *bilan) {
+    t_partie_journal partie;
+    size_t position;
+    bool valide;
+
+    memset(bilan, 0, sizeof(*bilan));
+    if (!verifier_entete_journal(donnees, taille)) {
+        return false;
+    }
+
+    memset(&partie, 0, sizeof(partie));
+    valide = true;
+    position = sizeof(t_entete_journal);
+    while (valide && position < taille) {
+        t_entete_bloc bloc;
+
+        if (taille - position < sizeof(bloc)) {
+            valide = false;
+            break;
+        }
+        memcpy(&bloc, donnees + position, sizeof(bloc));
+        position = position + sizeof(bloc);
+
+        valide = taille - position >= bloc.taille
+                 && (!verifier || somme_controle(donnees + position, bloc.taille) == bloc.somme)
+                 && relire_bloc(&bloc, donnees + position, &partie, bilan);
+        position = position + bloc.taille;
+    }
+
+    free(partie.tours);
+    free(partie.totaux);
+    free(partie.bonus);
+    return valide;
+}
+
+/*********************************
+ *       AUDIT DES JOURNAUX      *
+ *********************************/
+
+/**
+ * @brief Représente le travail partagé entre les threads d'un audit
+ * 
+ * blocs contient la position de l'entête de chaque bloc du journal ; les threads prennent les blocs un par un
+ * dans l'ordre en avançant suivant.
+ * 
+ */
+typedef struct {
+    const uint8_t *donnees;
+    const size_t *blocs;
+    int nombre_blocs;
+    bool verifier;
+    atomic_int suivant;
+    atomic_int blocs_invalides;
+} t_travail_audit;
+
+/**
+ * @brief Représente un thread d'un audit, avec son bilan privé
+ * 
+ * Chaque thread est alloué sur sa propre ligne de cache, les bilans n'étant additionnés qu'à la fin de l'audit.
+ * 
+ */
+typedef struct {
+    t_travail_audit *travail;
+    t_partie_journal partie;
+    t_bilan_journal bilan;
+} t_thread_audit;
+
+/**
+ * @fn bool auditer_bloc(const t_entete_bloc *entete, const uint8_t *parties, t_partie_journal *partie,
+ *                       t_bilan_journal *bilan)
+ * 
+ * @brief Cette fonction recompte les parties d'un bloc avec les règles de référence et les compare au journal
+ * 
+ * @param entete L'entête du bloc
+ * @param parties Les parties du bloc, entete->taille octets
+ * @param partie L'espace où chaque partie est décodée
+ * @param bilan Le bilan, complété avec les parties et les écarts du bloc
+ * @return true si le bloc a pu être décodé jusqu'au bout
+ * @return false si le bloc est tronqué ou mal formé, ou si la mémoire manque pour le décoder
+ * 
+ * Contrairement à relire_bloc, les dés de chaque tour sont décodés et comptés par compter_points, qui est comparé
+ * à TABLE_POINTS. Les feuilles sont remplies case par case : chaque total est recalculé par calculer_total à
+ * partir des cases et comparé à l'état résumé et au total annoncé, le bonus à celui annoncé et le vainqueur de
+ * trouver_vainqueurs à celui annoncé
+ */
+bool auditer_bloc(const t_entete_bloc *entete, const uint8_t *parties, t_partie_journal *partie,
+                  t_bilan_journal *bilan) {
+    t_feuilles feuilles;
+    t_score feuille;
+    t_des des;
+    size_t position;
+
+    position = 0;
+    for (uint32_t p = 0; p < entete->nombre_parties; p++) {
+        if (!decoder_partie(parties, entete->taille, &position, partie)
+            || !agrandir_bilan_journal(bilan, partie->nombre_joueurs)) {
+            return false;
+        }
+        initialiser_feuilles(&feuilles, partie->nombre_joueurs, bilan->cases, bilan->etats);
+
+        for (size_t t = 0; t < TAILLE_FEUILLES(partie->nombre_joueurs); t++) {
+            const t_tour_journal *tour;
+            int joueur;
+            int points;
+
+            tour = &partie->tours[t];
+            joueur = t % partie->nombre_joueurs;
+            decoder_lancer(tour->lancers[tour->relances], des);
+            points = compter_points(tour->combinaison, des);
+            if (points != TABLE_POINTS[INDICE_PAR_LANCER[tour->lancers[tour->relances]]].points[tour->combinaison]) {
+                bilan->ecarts_points = bilan->ecarts_points + 1;
+            }
+
+            if (feuilles.cases[tour->combinaison][joueur] != -1) {
+                bilan->nombre_erreurs = bilan->nombre_erreurs + 1;
+            }
+            else {
+                feuilles.cases[tour->combinaison][joueur] = points;
+                feuilles.etats[joueur] = ajouter_points(feuilles.etats[joueur], tour->combinaison, points);
+            }
+            bilan->nombre_relances = bilan->nombre_relances + tour->relances;
+        }
+
+        if (trouver_vainqueurs(&feuilles, bilan->totaux) != partie->vainqueur) {
+            bilan->ecarts_vainqueurs = bilan->ecarts_vainqueurs + 1;
+        }
+        for (int j = 0; j < partie->nombre_joueurs; j++) {
+            int total;
+            int total_sup;
+
+            lire_feuille(&feuilles, j, feuille);
+            total = calculer_total(feuille);
+            total_sup = 0;
+            for (int c = 0; c < 6; c++) {
+                if (feuille[c] != -1) {
+                    total_sup = total_sup + feuille[c];
+                }
+            }
+
+            if (total != bilan->totaux[j] || total != partie->totaux[j]) {
+                bilan->ecarts_totaux = bilan->ecarts_totaux + 1;
+            }
+            if ((total_sup > 62) != partie->bonus[j]) {
+                bilan->ecarts_bonus = bilan->ecarts_bonus + 1;
+            }
+            bilan->somme_totaux = bilan->somme_totaux + total;
+        }
+
+        bilan->nombre_erreurs = bilan->nombre_erreurs + partie->incoherences;
+        bilan->nombre_totaux = bilan->nombre_totaux + partie->nombre_joueurs;
+        bilan->nombre_tours = bilan->nombre_tours + TAILLE_FEUILLES(partie->nombre_joueurs);
+        bilan->nombre_parties = bilan->nombre_parties + 1;
+    }
+
+    return position == entete->taille;
+}
+
+/**
+ * @fn void *executer_audit(void *argument)
+ * 
+ * @brief Cette fonction est exécutée par chaque thread d'un audit
+ * 
+ * @param argument Le t_thread_audit du thread
+ * @return void* NULL
+ */
+void *executer_audit(void *argument) {
+    t_thread_audit *thread;
+    t_travail_audit *travail;
+    int numero;
+
+    thread = argument;
+    travail = thread->travail;
+
+    numero = atomic_fetch_add_explicit(&travail->suivant, 1, memory_order_relaxed);
+    while (numero < travail->nombre_blocs) {
+        t_entete_bloc bloc;
+        const uint8_t *parties;
+
+        memcpy(&bloc, travail->donnees + travail->blocs[numero], sizeof(bloc));
+        parties = travail->donnees + travail->blocs[numero] + sizeof(bloc);
+        if ((travail->verifier && somme_controle(parties, bloc.taille) != bloc.somme)
+            || !auditer_bloc(&bloc, parties, &thread->partie, &thread->bilan)) {
+            atomic_fetch_add_explicit(&travail->blocs_invalides, 1, memory_order_relaxed);
+        }
+
+        numero = atomic_fetch_add_explicit(&travail->suivant, 1, memory_order_relaxed);
+    }
+
+    return NULL;
+}
+
+/**
+ * @fn bool auditer_journal(const uint8_t *donnees, size_t taille, bool verifier, int nombre_threads,
+ *                          t_bilan_journal *bilan)
+ * 
+ * @brief Cette fonction audite toutes les parties d'un journal chargé en mémoire, réparties entre plusieurs threads
+ * 
+ * @param donnees Le contenu du journal, entête compris
+ * @param taille La taille du journal
+ * @param verifier Vrai pour vérifier la somme de contrôle de chaque bloc avant de l'auditer
+ * @param nombre_threads Le nombre de threads
+ * @param bilan Le bilan de l'audit, remis à zéro
+ * @return true si le journal est complet et bien formé
+ * @return false si l'entête est invalide, si un bloc est tronqué, corrompu ou mal formé, ou si la mémoire manque
+ * pour indexer les blocs
+ * 
+ * Les entêtes de blocs sont d'abord parcourus pour indexer les blocs, ce qui ne lit que quelques octets tous les
+ * TAILLE_BLOC_JOURNAL ; les blocs étant indépendants, les threads les auditent ensuite dans n'importe quel ordre.
+ * Les bilans des blocs complets sont additionnés même si le journal est tronqué
+ */
+bool auditer_journal(const uint8_t *donnees, size_t taille, bool verifier, int nombre_threads,
+                     t_bilan_journal *bilan) {
+    t_travail_audit travail;
+    t_thread_audit **threads;
+    pthread_t *identifiants;
+    size_t *blocs;
+    size_t position;
+    int capacite;
+    bool complet;
+
+    memset(bilan, 0, sizeof(*bilan));
+    if (!verifier_entete_journal(donnees, taille)) {
+        return false;
+    }
+
+    capacite = 1024;
+    blocs = malloc(capacite * sizeof(size_t));
+    if (blocs == NULL) {
+        fprintf(stderr, "Mémoire insuffisante pour indexer les blocs du journal\n");
+        return false;
+    }
+    travail.nombre_blocs = 0;
+    complet = true;
+    position = sizeof(t_entete_journal);
+    while (position < taille) {
+        t_entete_bloc bloc;
+
+        if (taille - position < sizeof(bloc)) {
+            complet = false;
+            break;
+        }
+        memcpy(&bloc, donnees + position, sizeof(bloc));
+        if (taille - position - sizeof(bloc) < bloc.taille) {
+            complet = false;
+            break;
+        }
+
+        if (travail.nombre_blocs == capacite) {
+            size_t *agrandis;
+
+            agrandis = realloc(blocs, 2 * capacite * sizeof(size_t));
+            if (agrandis == NULL) {
+                fprintf(stderr, "Mémoire insuffisante pour indexer les blocs du journal\n");
+                free(blocs);
+                return false;
+            }
+            blocs = agrandis;
+            capacite = 2 * capacite;
+        }
+        blocs[travail.nombre_blocs] = position;
+        travail.nombre_blocs = travail.nombre_blocs + 1;
+        position = position + sizeof(bloc) + bloc.taille;
+    }
+
+    travail.donnees = donnees;
+    travail.blocs = blocs;
+    travail.verifier = verifier;
+    atomic_init(&travail.suivant, 0);
+    atomic_init(&travail.blocs_invalides, 0);
+
+    threads = malloc(nombre_threads * sizeof(t_thread_audit *));
+    identifiants = malloc(nombre_threads * sizeof(pthread_t));
+    for (int t = 0; t < nombre_threads; t++) {
+        threads[t] = aligned_alloc(64, (sizeof(t_thread_audit) + 63) / 64 * 64);
+        memset(threads[t], 0, sizeof(t_thread_audit));
+        threads[t]->travail = &travail;
+        pthread_create(&identifiants[t], NULL, executer_audit, threads[t]);
+    }
+
+    for (int t = 0; t < nombre_threads; t++) {
+        t_bilan_journal *prive;
+
+        pthread_join(identifiants[t], NULL);
+        prive = &threads[t]->bilan;
+        bilan->nombre_parties = bilan->nombre_parties + prive->nombre_parties;
+        bilan->nombre_tours = bilan->nombre_tours + prive->nombre_tours;
+        bilan->nombre_relances = bilan->nombre_relances + prive->nombre_relances;
+        bilan->somme_totaux = bilan->somme_totaux + prive->somme_totaux;
+        bilan->nombre_totaux = bilan->nombre_totaux + prive->nombre_totaux;
+        bilan->nombre_erreurs = bilan->nombre_erreurs + prive->nombre_erreurs;
+        bilan->ecarts_points = bilan->ecarts_points + prive->ecarts_points;
+        bilan->ecarts_totaux = bilan->ecarts_totaux + prive->ecarts_totaux;
+        bilan->ecarts_bonus = bilan->ecarts_bonus + prive->ecarts_bonus;
+        bilan->ecarts_vainqueurs = bilan->ecarts_vainqueurs + prive->ecarts_vainqueurs;
+
+        liberer_bilan_journal(prive);
+        free(threads[t]->partie.tours);
+        free(threads[t]->partie.totaux);
+        free(threads[t]->partie.bonus);
+        free(threads[t]);
+    }
+
+    free(identifiants);
+    free(threads);
+    free(blocs);
+    return complet && atomic_load(&travail.blocs_invalides) == 0;
+}
+
+/*********************************
+ *           TOURNOI             *
+ *********************************/
+
+/**
+ * @brief Représente le travail partagé entre les threads du tournoi
+ * 
+ * Chaque thread écrit ses bilans dans sa propre ligne de bilans, alignée sur une ligne de cache pour que les
+ * threads ne se disputent pas les mêmes lignes ; les lignes sont additionnées à la fin du tournoi. Un thread qui
+ * ne peut pas instancier une stratégie le signale dans manque_memoire et s'arrête.
+ * 
+ */
+typedef struct {
+    t_strategie *strategies;
+    t_rencontre *rencontres;
+    t_tache *taches;
+    t_file_taches *files;
+    int nombre_threads;
+    atomic_bool manque_memoire;
+} t_travail_tournoi;
+
+/**
+ * @brief Représente un thread du tournoi, avec ses bilans privés de victoires, nuls et défaites par rencontre
+ * 
+ */
+typedef struct {
+    t_travail_tournoi *travail;
+    int numero;
+    long (*bilans)[3];
+} t_thread_tournoi;
+
+/**
+ * @fn void jouer_rencontre(t_strategie instances[2], t_generateur *generateur, long resultat[3], bool inverser)
+ * 
+ * @brief Cette procédure joue une partie à deux joueurs et compte son résultat
+ * 
+ * @param instances Les instances des deux stratégies de la rencontre
+ * @param generateur Le flux de dés de la partie
+ * @param resultat Les victoires, nuls et défaites de la première stratégie
+ * @param inverser Vrai si la seconde stratégie commence la partie
+ */
+void jouer_rencontre(t_strategie instances[2], t_generateur *generateur, long resultat[3], bool inverser) {
+    t_partie partie;
+    t_strategie *places[2];
+    int cases[TAILLE_FEUILLES(2)];
+    t_etat_joueur etats[2];
+    int totaux[2];
+    int total_a;
+    int total_b;
+
+    places[0] = &instances[inverser ? 1 : 0];
+    places[1] = &instances[inverser ? 0 : 1];
+    partie.generateur = *generateur;
+    initialiser_partie(&partie, 2, cases, etats);
+
+    while (!partie_terminee(&partie)) {
+        jouer_tour(places[partie.joueur], &partie, NULL);
+    }
+    *generateur = partie.generateur;
+
+    calculer_totaux(&partie.feuilles, totaux);
+    total_a = totaux[inverser ? 1 : 0];
+    total_b = totaux[inverser ? 0 : 1];
+    if (total_a > total_b) {
+        resultat[0] = resultat[0] + 1;
+    }
+    else if (total_a == total_b) {
+        resultat[1] = resultat[1] + 1;
+    }
+    else {
+        resultat[2] = resultat[2] + 1;
+    }
+}
+
+/**
+ * @fn bool prendre_tache(t_file_taches *file, bool voler, int *tache)
+ * 
+ * @brief Cette fonction retire une tâche d'une file
+ * 
+ * @param file La file de tâches
+ * @param voler Vrai pour prendre au début de la file (vol par un autre thread), faux pour prendre à la fin
+ * @param tache La tâche retirée
+ * @return true si une tâche a été retirée
+ * @return false si la file est vide
+ */
+bool prendre_tache(t_file_taches *file, bool voler, int *tache) {
+    bool trouvee;
+
+    pthread_mutex_lock(&file->verrou);
+    trouvee = file->debut < file->fin;
+    if (trouvee && voler) {
+        *tache = file->taches[file->debut];
+        file->debut = file->debut + 1;
+    }
+    else if (trouvee) {
+        file->fin = file->fin - 1;
+        *tache = file->taches[file->fin];
+    }
+    pthread_mutex_unlock(&file->verrou);
+
+    return trouvee;
+}
+
+/**
+ * @fn void *executer_taches(void *argument)
+ * 
+ * @brief Cette fonction est exécutée par chaque thread du tournoi
+ * 
+ * @param argument Le thread, de type t_thread_tournoi
+ * @return void* NULL
+ * 
+ * Consiste à vider sa propre file puis à voler les tâches des autres threads. Aucune tâche n'étant ajoutée en
+ * cours de tournoi, le thread s'arrête dès que toutes les files sont vides
+ */
+void *executer_taches(void *argument) {
+    t_thread_tournoi *thread;
+    t_travail_tournoi *travail;
+    t_strategie instances[2];
+    t_rencontre *rencontre;
+    t_tache *tache;
+    int numero;
+    int victime;
+
+    thread = argument;
+    travail = thread->travail;
+    victime = 0;
+
+    while (victime < travail->nombre_threads) {
+        if (!prendre_tache(&travail->files[(thread->numero + victime) % travail->nombre_threads], victime > 0, &numero)) {
+            victime = victime + 1;
+            continue;
+        }
+        victime = 0;
+
+        tache = &travail->taches[numero];
+        rencontre = &travail->rencontres[tache->rencontre];
+        if (!instancier_strategie(&travail->strategies[rencontre->strategie_a], &instances[0])) {
+            atomic_store_explicit(&travail->manque_memoire, true, memory_order_relaxed);
+            return NULL;
+        }
+        if (!instancier_strategie(&travail->strategies[rencontre->strategie_b], &instances[1])) {
+            liberer_instance(&instances[0]);
+            atomic_store_explicit(&travail->manque_memoire, true, memory_order_relaxed);
+            return NULL;
+        }
+
+        for (long partie = 0; partie < tache->nombre_parties; partie++) {
+            jouer_rencontre(instances, &tache->generateur, thread->bilans[tache->rencontre], partie % 2 == 1);
+        }
+
+        liberer_instance(&instances[0]);
+        liberer_instance(&instances[1]);
+    }
+
+    return NULL;
+}
+
+/**
+ * @fn bool jouer_rencontres(t_strategie *strategies, t_rencontre *rencontres, int nombre_rencontres,
+ *                           long parties, t_generateur *generateur, int nombre_threads)
+ * 
+ * @brief Cette fonction joue toutes les parties d'une série de rencontres en parallèle
+ * 
+ * @param strategies Les stratégies enregistrées
+ * @param rencontres Les rencontres, dont les bilans sont complétés
+ * @param nombre_rencontres Le nombre de rencontres
+ * @param parties Le nombre de parties de chaque rencontre
+ * @param generateur Le générateur du tournoi, avancé d'un saut par tâche
+ * @param nombre_threads Le nombre de threads
+ * @return true si toutes les parties ont été jouées
+ * @return false si la mémoire a manqué, les bilans étant alors incomplets, ou inchangés si elle a manqué avant
+ * le début des parties
+ * 
+ * Consiste à découper chaque rencontre en tâches de PARTIES_PAR_TACHE parties et à donner à chaque tâche son flux
+ * de dés, séparé du précédent par un saut de 2^128 tirages. Les flux ne dépendant que de l'ordre des tâches, les
+ * bilans sont les mêmes quel que soit le nombre de threads et l'ordre dans lequel les tâches sont volées
+ */
+bool jouer_rencontres(t_strategie *strategies, t_rencontre *rencontres, int nombre_rencontres,
+                      long parties, t_generateur *generateur, int nombre_threads) {
+    t_travail_tournoi travail;
+    t_thread_tournoi *threads;
+    pthread_t *identifiants;
+    long taches_par_rencontre;
+    int nombre_taches;
+    size_t taille_bilans;
+    bool manque;
+
+    taches_par_rencontre = (parties + PARTIES_PAR_TACHE - 1) / PARTIES_PAR_TACHE;
+    nombre_taches = nombre_rencontres * taches_par_rencontre;
+    taille_bilans = (nombre_rencontres * sizeof(long[3]) + 63) / 64 * 64;
+
+    travail.strategies = strategies;
+    travail.rencontres = rencontres;
+    travail.nombre_threads = nombre_threads;
+    atomic_init(&travail.manque_memoire, false);
+    travail.taches = malloc(nombre_taches * sizeof(t_tache));
+    travail.files = calloc(nombre_threads, sizeof(t_file_taches));
+    threads = calloc(nombre_threads, sizeof(t_thread_tournoi));
+    identifiants = malloc(nombre_threads * sizeof(pthread_t));
+    manque = travail.taches == NULL || travail.files == NULL || threads == NULL || identifiants == NULL;
+    for (int t = 0; t < nombre_threads && !manque; t++) {
+        travail.files[t].taches = malloc(nombre_taches * sizeof(int));
+        threads[t].bilans = aligned_alloc(64, taille_bilans);
+        manque = travail.files[t].taches == NULL || threads[t].bilans == NULL;
+    }
+    if (manque) {
+        for (int t = 0; travail.files != NULL && threads != NULL && t < nombre_threads; t++) {
+            free(travail.files[t].taches);
+            free(threads[t].bilans);
+        }
+        free(identifiants);
+        free(threads);
+        free(travail.files);
+        free(travail.taches);
+        return false;
+    }
+
+    for (int t = 0; t < nombre_taches; t++) {
+        long debut;
+
+        debut = (t % taches_par_rencontre) * PARTIES_PAR_TACHE;
+        travail.taches[t].rencontre = t / taches_par_rencontre;
+        travail.taches[t].nombre_parties = parties - debut < PARTIES_PAR_TACHE ? parties - debut : PARTIES_PAR_TACHE;
+        travail.taches[t].generateur = *generateur;
+        sauter_generateur(generateur);
+    }
+
+    for (int t = 0; t < nombre_threads; t++) {
+        pthread_mutex_init(&travail.files[t].verrou, NULL);
+        travail.files[t].debut = 0;
+        travail.files[t].fin = 0;
+    }
+    for (int t = 0; t < nombre_taches; t++) {
+        t_file_taches *file;
+
+        file = &travail.files[t % nombre_threads];
+        file->taches[file->fin] = t;
+        file->fin = file->fin + 1;
+    }
+
+    for (int t = 0; t < nombre_threads; t++) {
+        threads[t].travail = &travail;
+        threads[t].numero = t;
+        memset(threads[t].bilans, 0, taille_bilans);
+        pthread_create(&identifiants[t], NULL, executer_taches, &threads[t]);
+    }
+
+    for (int t = 0; t < nombre_threads; t++) {
+        pthread_join(identifiants[t], NULL);
+        for (int r = 0; r < nombre_rencontres; r++) {
+            rencontres[r].victoires = rencontres[r].victoires + threads[t].bilans[r][0];
+            rencontres[r].nuls = rencontres[r].nuls + threads[t].bilans[r][1];
+            rencontres[r].defaites = rencontres[r].defaites + threads[t].bilans[r][2];
+        }
+        free(threads[t].bilans);
+        free(travail.files[t].taches);
+        pthread_mutex_destroy(&travail.files[t].verrou);
+    }
+
+    free(identifiants);
+    free(threads);
+    free(travail.files);
+    free(travail.taches);
+    return !atomic_load_explicit(&travail.manque_memoire, memory_order_relaxed);
+}
+
+/**
+ * @fn void intervalle_wilson(double points, long parties, double *bas, double *haut)
+ * 
+ * @brief Cette procédure calcule l'intervalle de confiance à 95 % d'un taux de points
+ * 
+ * @param points Les points marqués, une victoire valant 1 et un nul 1/2
+ * @param parties Le nombre de parties
+ * @param bas La borne basse de l'intervalle
+ * @param haut La borne haute de l'intervalle
+ * 
+ * Utilise l'intervalle de Wilson, qui reste dans [0, 1] même pour un taux proche de 0 ou de 1
+ */
+void intervalle_wilson(double points, long parties, double *bas, double *haut) {
+    const double z = 1.96;
+    double taux;
+    double centre;
+    double marge;
+    double diviseur;
+
+    taux = points / parties;
+    diviseur = 1.0 + z * z / parties;
+    centre = (taux + z * z / (2.0 * parties)) / diviseur;
+    marge = z * sqrt(taux * (1.0 - taux) / parties + z * z / (4.0 * parties * parties)) / diviseur;
+
+    *bas = centre - marge;
+    *haut = centre + marge;
+}
+
+/**
+ * @fn void afficher_rencontre(t_strategie *strategies, t_rencontre *rencontre)
+ * 
+ * @brief Cette procédure affiche le bilan d'une rencontre avec l'intervalle de confiance de son taux de points
+ * 
+ * @param strategies Les stratégies enregistrées
+ * @param rencontre La rencontre
+ */
+void afficher_rencontre(t_strategie *strategies, t_rencontre *rencontre) {
+    long parties;
+    double points;
+    double bas;
+    double haut;
+
+    parties = rencontre->victoires + rencontre->nuls + rencontre->defaites;
+    points = rencontre->victoires + 0.5 * rencontre->nuls;
+    intervalle_wilson(points, parties, &bas, &haut);
+
+    printf("%-12s - %-12s : %8ld V %6ld N %8ld D   taux %.4f [%.4f ; %.4f]\n",
+           strategies[rencontre->strategie_a].nom, strategies[rencontre->strategie_b].nom,
+           rencontre->victoires, rencontre->nuls, rencontre->defaites, points / parties, bas, haut);
+}
+
+/**
+ * @fn int apparier_suisse(double *points, bool *deja_joue, int nombre_strategies, t_rencontre *rencontres,
+ *                          int *exempte)
+ * 
+ * @brief Cette fonction apparie les stratégies pour une ronde d'un tournoi suisse
+ * 
+ * @param points Les points de chaque stratégie avant la ronde
+ * @param deja_joue Les rencontres déjà jouées, deja_joue[a * nombre_strategies + b] ; deja_joue[a * nombre_strategies
+ * + a] indique que la stratégie a déjà été exempte
+ * @param nombre_strategies Le nombre de stratégies
+ * @param rencontres Les rencontres de la ronde
+ * @param exempte Reçoit la stratégie exempte de la ronde, -1 s'il n'y en a pas
+ * @return int le nombre de rencontres de la ronde
+ * 
+ * Consiste à classer les stratégies par points puis à associer chacune, dans l'ordre, à la suivante la mieux
+ * classée qu'elle n'a pas encore rencontrée (ou à la suivante si elle les a toutes rencontrées). Avec un nombre
+ * impair de stratégies, la moins bien classée qui n'a pas encore été exempte l'est pour cette ronde, avant
+ * l'appariement des autres
+ */
+int apparier_suisse(double *points, bool *deja_joue, int nombre_strategies, t_rencontre *rencontres, int *exempte) {
+    int classement[NOMBRE_STRATEGIES_MAX];
+    bool appariee[NOMBRE_STRATEGIES_MAX];
+    int nombre;
+
+    for (int i = 0; i < nombre_strategies; i++) {
+        int j;
+
+        j = i;
+        while (j > 0 && points[classement[j - 1]] < points[i]) {
+            classement[j] = classement[j - 1];
+            j = j - 1;
+        }
+        classement[j] = i;
+        appariee[i] = false;
+    }
+
+    *exempte = -1;
+    if (nombre_strategies % 2 == 1) {
+        for (int i = nombre_strategies - 1; i >= 0 && *exempte == -1; i--) {
+            if (!deja_joue[classement[i] * nombre_strategies + classement[i]]) {
+                *exempte = classement[i];
+            }
+        }
+        if (*exempte == -1) {
+            *exempte = classement[nombre_strategies - 1];
+        }
+        appariee[*exempte] = true;
+        deja_joue[*exempte * nombre_strategies + *exempte] = true;
+    }
+
+    nombre = 0;
+    for (int i = 0; i < nombre_strategies; i++) {
+        int a;
+        int b;
+
+        a = classement[i];
+        if (appariee[a]) {
+            continue;
+        }
+        b = -1;
+        for (int j = i + 1; j < nombre_strategies; j++) {
+            int candidate;
+
+            candidate = classement[j];
+            if (!appariee[candidate] && (b == -1 || !deja_joue[a * nombre_strategies + candidate])) {
+                b = candidate;
+                if (!deja_joue[a * nombre_strategies + candidate]) {
+                    break;
+                }
+            }
+        }
+        if (b == -1) {
+            continue;
+        }
+
+        appariee[a] = true;
+        appariee[b] = true;
+        deja_joue[a * nombre_strategies + b] = true;
+        deja_joue[b * nombre_strategies + a] = true;
+        rencontres[nombre].strategie_a = a;
+        rencontres[nombre].strategie_b = b;
+        rencontres[nombre].victoires = 0;
+        rencontres[nombre].nuls = 0;
+        rencontres[nombre].defaites = 0;
+        nombre = nombre + 1;
+    }
+
+    return nombre;
+}
+
+/**
+ * @fn int jouer_tablee(t_strategie **places, t_partie *partie, int *totaux, double *victoires)
+ * 
+ * @brief Cette fonction joue une partie à une grande tablée de joueurs et partage la victoire entre les ex-aequo
+ * 
+ * @param places La stratégie de chaque joueur
+ * @param partie Le contexte de la partie, déjà initialisé avec le nombre de joueurs
+ * @param totaux Reçoit le total de chaque joueur
+ * @param victoires La part de victoire de chaque joueur, augmentée de 1 / nombre de vainqueurs pour les vainqueurs
+ * @return int le total du vainqueur
+ */
+int jouer_tablee(t_strategie **places, t_partie *partie, int *totaux, double *victoires) {
+    int vainqueur;
+    int nombre_vainqueurs;
+
+    while (!partie_terminee(partie)) {
+        jouer_tour(places[partie->joueur], partie, NULL);
+    }
+
+    vainqueur = trouver_vainqueurs(&partie->feuilles, totaux);
+    nombre_vainqueurs = 0;
+    for (int j = 0; j < partie->nombre_joueurs; j++) {
+        nombre_vainqueurs = nombre_vainqueurs + (totaux[j] == totaux[vainqueur]);
+    }
+    for (int j = 0; j < partie->nombre_joueurs; j++) {
+        if (totaux[j] == totaux[vainqueur]) {
+            victoires[j] = victoires[j] + 1.0 / nombre_vainqueurs;
+        }
+    }
+
+    return totaux[vainqueur];
+}
+
+/*********************************
+ *       PARTIES SCRIPTÉES       *
+ *********************************/
+
+/**
+ * @brief Représente l'état d'un interpréteur de parties scriptées
+ * 
+ * Le protocole est fait de lignes de commandes, une par action, lues dans un flux tamponné :
+ *   partie <graine> <joueurs>   commence une partie, les dés étant tirés avec la graine donnée
+ *   keep [d1 d2 ...]            garde les dés désignés (de 1 à NOMBRE_DES) et relance les autres
+ *   roll [d1 d2 ...]            relance les dés désignés
+ *   score <combinaison>         valide / barre une combinaison, désignée par son numéro de 1 à 13 ou son nom
+ *   attendu <t1> <t2> ...       vérifie les totaux des joueurs à la fin de la partie
+ * Les lignes vides et celles qui commencent par # sont ignorées. Chaque tour commence par un lancer des NOMBRE_DES dés,
+ * sans commande, dès que le tour précédent est validé.
+ * 
+ */
+typedef struct {
+    t_partie partie;
+    int *cases;
+    t_etat_joueur *etats;
+    int *totaux;
+    int capacite;
+    bool en_cours;
+    long numero_partie;
+    long numero_ligne;
+    long nombre_commandes;
+    long nombre_erreurs;
+    bool verbeux;
+    FILE *sortie;
+} t_interpreteur;
+
+/**
+ * @fn void signaler_erreur(t_interpreteur *interpreteur, const char *message)
+ * 
+ * @brief Cette procédure signale une commande refusée, qui est ignorée
+ * 
+ * @param interpreteur L'interpréteur
+ * @param message La raison du refus
+ */
+void signaler_erreur(t_interpreteur *interpreteur, const char *message) {
+    fprintf(stderr, "ligne %ld : %s\n", interpreteur->numero_ligne, message);
+    interpreteur->nombre_erreurs = interpreteur->nombre_erreurs + 1;
+}
+
+/**
+ * @fn int lire_des_commande(char *arguments, bool *erreur)
+ * 
+ * @brief Cette fonction lit les numéros de dés d'une commande keep ou roll
+ * 
+ * @param arguments Les arguments de la commande
+ * @param erreur Vrai si un argument n'est pas un numéro de dé
+ * @return int le masque des dés désignés, le bit i correspondant au dé i + 1
+ */
+int lire_des_commande(char *arguments, bool *erreur) {
+    char *fin;
+    long de;
+    int masque;
+
+    masque = 0;
+    *erreur = false;
+    while (arguments[strspn(arguments, " \t")] != '\0') {
+        de = strtol(arguments, &fin, 10);
+        if (fin == arguments || de < 1 || de > NOMBRE_DES) {
+            *erreur = true;
+            return 0;
+        }
+        masque = masque | (1 << (de - 1));
+        arguments = fin;
+    }
+
+    return masque;
+}
+
+/**
+ * @fn void commencer_partie_script(t_interpreteur *interpreteur, char *arguments)
+ * 
+ * @brief Cette procédure exécute la commande partie
+ * 
+ * @param interpreteur L'interpréteur
+ * @param arguments La graine et le nombre de joueurs
+ * 
+ * Si la mémoire manque pour agrandir les feuilles, la commande est refusée et la partie en cours abandonnée, ses
+ * feuilles ayant pu être déplacées
+ */
+void commencer_partie_script(t_interpreteur *interpreteur, char *arguments) {
+    unsigned long long graine;
+    int nombre_joueurs;
+
+    if (sscanf(arguments, "%llu %d", &graine, &nombre_joueurs) != 2 || nombre_joueurs <= 0) {
+        signaler_erreur(interpreteur, "partie attend une graine et un nombre de joueurs");
+        return;
+    }
+
+    if (nombre_joueurs > interpreteur->capacite) {
+        int *cases;
+        t_etat_joueur *etats;
+        int *totaux;
+
+        cases = realloc(interpreteur->cases, TAILLE_FEUILLES(nombre_joueurs) * sizeof(int));
+        if (cases != NULL) {
+            interpreteur->cases = cases;
+        }
+        etats = realloc(interpreteur->etats, nombre_joueurs * sizeof(t_etat_joueur));
+        if (etats != NULL) {
+            interpreteur->etats = etats;
+        }
+        totaux = realloc(interpreteur->totaux, nombre_joueurs * sizeof(int));
+        if (totaux != NULL) {
+            interpreteur->totaux = totaux;
+        }
+        if (cases == NULL || etats == NULL || totaux == NULL) {
+            interpreteur->en_cours = false;
+            signaler_erreur(interpreteur, "mémoire insuffisante pour ce nombre de joueurs");
+            return;
+        }
+        interpreteur->capacite = nombre_joueurs;
+    }
+
+    initialiser_generateur(&interpreteur->partie.generateur, graine);
+    initialiser_partie(&interpreteur->partie, nombre_joueurs, interpreteur->cases, interpreteur->etats);
+    commencer_tour(&interpreteur->partie);
+    interpreteur->en_cours = true;
+    interpreteur->numero_partie = interpreteur->numero_partie + 1;
+}
+
+/**
+ * @fn void terminer_partie_script(t_interpreteur *interpreteur)
+ * 
+ * @brief Cette procédure écrit le résultat d'une partie terminée : son numéro, les totaux et le vainqueur
+ * 
+ * @param interpreteur L'interpréteur
+ */
+void terminer_partie_script(t_interpreteur *interpreteur) {
+    t_partie *partie;
+    int vainqueur;
+
+    partie = &interpreteur->partie;
+    vainqueur = trouver_vainqueurs(&partie->feuilles, interpreteur->totaux);
+
+    fprintf(interpreteur->sortie, "fin %ld", interpreteur->numero_partie);
+    for (int j = 0; j < partie->nombre_joueurs; j++) {
+        fprintf(interpreteur->sortie, " %d", interpreteur->totaux[j]);
+    }
+    fprintf(interpreteur->sortie, " vainqueur %d\n", vainqueur + 1);
+    interpreteur->en_cours = false;
+}
+
+/**
+ * @fn void executer_commande(t_interpreteur *interpreteur, char *ligne)
+ * 
+ * @brief Cette procédure exécute une ligne du protocole de parties scriptées
+ * 
+ * @param interpreteur L'interpréteur
+ * @param ligne La ligne, modifiée pendant la lecture
+ */
+void executer_commande(t_interpreteur *interpreteur, char *ligne) {
+    t_partie *partie;
+    char *commande;
+    char *arguments;
+    bool erreur;
+    int masque;
+
+    partie = &interpreteur->partie;
+    commande = ligne + strspn(ligne, " \t");
+    if (*commande == '\0' || *commande == '#') {
+        return;
+    }
+    arguments = commande + strcspn(commande, " \t");
+    if (*arguments != '\0') {
+        *arguments = '\0';
+        arguments = arguments + 1;
+    }
+    interpreteur->nombre_commandes = interpreteur->nombre_commandes + 1;
+
+    if (strcmp(commande, "partie") == 0) {
+        commencer_partie_script(interpreteur, arguments);
+        return;
+    }
+    if (strcmp(commande, "attendu") == 0) {
+        char *fin;
+
+        if (interpreteur->en_cours || interpreteur->numero_partie == 0) {
+            signaler_erreur(interpreteur, "attendu n'est possible qu'à la fin d'une partie");
+            return;
+        }
+        for (int j = 0; j < partie->nombre_joueurs; j++) {
+            long total;
+
+            total = strtol(arguments, &fin, 10);
+            if (fin == arguments || total != interpreteur->totaux[j]) {
+                signaler_erreur(interpreteur, "les totaux ne sont pas ceux attendus");
+                return;
+            }
+            arguments = fin;
+        }
+        return;
+    }
+    if (!interpreteur->en_cours) {
+        signaler_erreur(interpreteur, "aucune partie en cours");
+        return;
+    }
+
+    if (strcmp(commande, "keep") == 0 || strcmp(commande, "roll") == 0) {
+        masque = lire_des_commande(arguments, &erreur);
+        if (erreur) {
+            signaler_erreur(interpreteur, "numéro de dé invalide");
+            return;
+        }
+        if (commande[0] == 'k') {
+            masque = ~masque & MASQUE_DES;
+        }
+        if (!relancer_tour(partie, masque)) {
+            signaler_erreur(interpreteur, "plus de relance possible");
+            return;
+        }
+        if (interpreteur->verbeux) {
+            char texte[4 * NOMBRE_DES];
+
+            formater_des(texte, sizeof(texte), partie->des);
+            fprintf(interpreteur->sortie, "des %s\n", texte);
+        }
+    }
+    else if (strcmp(commande, "score") == 0) {
+        int joueur;
+        int combinaison;
+        int points;
+
+        joueur = partie->joueur;
+        combinaison = chercher_combinaison(arguments + strspn(arguments, " \t"));
+        points = valider_combinaison(partie, combinaison);
+        if (points == -1) {
+            signaler_erreur(interpreteur, "combinaison inconnue ou déjà remplie");
+            return;
+        }
+        if (interpreteur->verbeux) {
+            fprintf(interpreteur->sortie, "score %d %s %d\n", joueur + 1, NOMS_COMBINAISONS[combinaison], points);
+        }
+
+        if (partie_terminee(partie)) {
+            terminer_partie_script(interpreteur);
+        }
+        else {
+            commencer_tour(partie);
+        }
+    }
+    else {
+        signaler_erreur(interpreteur, "commande inconnue");
+    }
+}
+
+/**
+ * @fn bool enregistrer_parties(FILE *sortie, t_strategie *strategie, long nombre, uint64_t graine, int nombre_joueurs)
+ * 
+ * @brief Cette fonction écrit le script de parties jouées par une stratégie, avec les totaux attendus
+ * 
+ * @param sortie Le flux où écrire le script
+ * @param strategie La stratégie de tous les joueurs
+ * @param nombre Le nombre de parties
+ * @param graine La graine dont sont tirées les graines des parties
+ * @param nombre_joueurs Le nombre de joueurs de chaque partie
+ * @return true si le script a été écrit
+ * @return false si la mémoire manque pour la stratégie ou les feuilles, rien n'étant alors écrit
+ * 
+ * Relire le script avec l'interpréteur rejoue exactement les mêmes parties : il tire les dés dans le même ordre
+ */
+bool enregistrer_parties(FILE *sortie, t_strategie *strategie, long nombre, uint64_t graine, int nombre_joueurs) {
+    t_strategie instance;
+    t_generateur graines;
+    t_partie partie;
+    int *cases;
+    t_etat_joueur *etats;
+    int *totaux;
+
+    if (!instancier_strategie(strategie, &instance)) {
+        return false;
+    }
+    initialiser_generateur(&graines, graine);
+    cases = malloc(TAILLE_FEUILLES(nombre_joueurs) * sizeof(int));
+    etats = malloc(nombre_joueurs * sizeof(t_etat_joueur));
+    totaux = malloc(nombre_joueurs * sizeof(int));
+    if (cases == NULL || etats == NULL || totaux == NULL) {
+        free(totaux);
+        free(etats);
+        free(cases);
+        liberer_instance(&instance);
+        return false;
+    }
+
+    for (long p = 0; p < nombre; p++) {
+        uint64_t graine_partie;
+
+        graine_partie = tirer_64(&graines);
+        fprintf(sortie, "partie %llu %d\n", (unsigned long long) graine_partie, nombre_joueurs);
+        initialiser_generateur(&partie.generateur, graine_partie);
+        initialiser_partie(&partie, nombre_joueurs, cases, etats);
+
+        while (!partie_terminee(&partie)) {
+            t_tour_journal tour;
+
+            jouer_tour(&instance, &partie, &tour);
+            for (int r = 0; r < tour.relances; r++) {
+                fprintf(sortie, "keep");
+                for (int i = 0; i < NOMBRE_DES; i++) {
+                    if (!(tour.masques[r] & (1 << i))) {
+                        fprintf(sortie, " %d", i + 1);
+                    }
+                }
+                fprintf(sortie, "\n");
+            }
+            fprintf(sortie, "score %d\n", tour.combinaison + 1);
+        }
+
+        calculer_totaux(&partie.feuilles, totaux);
+        fprintf(sortie, "attendu");
+        for (int j = 0; j < nombre_joueurs; j++) {
+            fprintf(sortie, " %d", totaux[j]);
+        }
+        fprintf(sortie, "\n");
+    }
+
+    free(totaux);
+    free(etats);
+    free(cases);
+    liberer_instance(&instance);
+    return true;
+}
+
+/*********************************
+ *       MESURE DES RÈGLES       *
+ *********************************/
+
+/**
+ * @brief Raccourci associé au nombre d'échantillons chronométrés de chaque mesure
+ * 
+ */
+#define ECHANTILLONS_MESURE 21
+
+/**
+ * @brief Raccourci associé à la durée minimale d'un échantillon, en secondes
+ * 
+ */
+#define DUREE_ECHANTILLON 0.002
+
+/**
+ * @brief Représente une fonction des règles mesurée par mesurer-regles
+ * 
+ * noyau appelle la fonction operations fois sur chacun des nombre lancers et renvoie la somme de ses résultats,
+ * pour que le compilateur ne puisse pas supprimer les appels.
+ * 
+ */
+typedef struct {
+    const char *nom;
+    int operations;
+    long (*noyau)(t_des *lancers, long nombre, t_generateur *generateur);
+} t_noyau_regles;
+
+/**
+ * @brief Représente le résultat de la mesure d'une fonction des règles
+ * 
+ * Les durées sont données par opération ; la dispersion est l'écart interquartile des échantillons rapporté à
+ * leur médiane.
+ * 
+ */
+typedef struct {
+    double nanosecondes;
+    double nanosecondes_minimum;
+    double cycles;
+    double dispersion;
+} t_mesure_regles;
+
+/**
+ * @fn uint64_t lire_cycles(void)
+ * 
+ * @brief Cette fonction lit le compteur de cycles du processeur
+ * 
+ * @return uint64_t le compteur d'horodatage sur x86, qui avance à fréquence fixe, 0 ailleurs
+ */
+uint64_t lire_cycles(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return __builtin_ia32_rdtsc();
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @fn long noyau_compter_des(t_des *lancers, long nombre, t_generateur *generateur)
+ * 
+ * @brief Cette fonction appelle compter_des sur chaque lancer
+ * 
+ * @param lancers Les lancers
+ * @param nombre Le nombre de lancers
+ * @param generateur Le générateur des dés
+ * @return long la somme des résultats
+ */
+long noyau_compter_des(t_des *lancers, long nombre, t_generateur *generateur) {
+    int occurences[NOMBRE_FACES];
+    long somme;
+
+    (void) generateur;
+    somme = 0;
+    for (long k = 0; k < nombre; k++) {
+        compter_des(lancers[k], occurences);
+        somme = somme + occurences[k % NOMBRE_FACES];
+    }
+    return somme;
+}
+
+/**
+ * @fn long noyau_trier_des(t_des *lancers, long nombre, t_generateur *generateur)
+ * 
+ * @brief Cette fonction appelle trier_des sur chaque lancer
+ * 
+ * @param lancers Les lancers
+ * @param nombre Le nombre de lancers
+ * @param generateur Le générateur des dés
+ * @return long la somme des résultats
+ */
+long noyau_trier_des(t_des *lancers, long nombre, t_generateur *generateur) {
+    t_des tries;
+    long somme;
+
+    (void) generateur;
+    somme = 0;
+    for (long k = 0; k < nombre; k++) {
+        trier_des(lancers[k], tries);
+        somme = somme + tries[0];
+    }
+    return somme;
+}
+
+/**
+ * @fn long noyau_full_house(t_des *lancers, long nombre, t_generateur *generateur)
+ * 
+ * @brief Cette fonction appelle full_house sur chaque lancer
+ * 
+ * @param lancers Les lancers
+ * @param nombre Le nombre de lancers
+ * @param generateur Le générateur des dés
+ * @return long la somme des résultats
+ */
+long noyau_full_house(t_des *lancers, long nombre, t_generateur *generateur) {
+    long somme;
+
+    (void) generateur;
+    somme = 0;
+    for (long k = 0; k < nombre; k++) {
+        somme = somme + full_house(lancers[k]);
+    }
+    return somme;
+}
+
+/**
+ * @fn long noyau_brelan(t_des *lancers, long nombre, t_generateur *generateur)
+ * 
+ * @brief Cette fonction appelle brelan sur chaque lancer
+ * 
+ * @param lancers Les lancers
+ * @param nombre Le nombre de lancers
+ * @param generateur Le générateur des dés
+ * @return long la somme des résultats
+ */
+long noyau_brelan(t_des *lancers, long nombre, t_generateur *generateur) {
+    long somme;
+
+    (void) generateur;
+    somme = 0;
+    for (long k = 0; k < nombre; k++) {
+        somme = somme + brelan(lancers[k]);
+    }
+    return somme;
+}
+
+/**
+ * @fn long noyau_carre(t_des *lancers, long nombre, t_generateur *generateur)
+ * 
+ * @brief Cette fonction appelle carre sur chaque lancer
+ * 
+ * @param lancers Les lancers
+ * @param nombre Le nombre de lancers
+ * @param generateur Le générateur des dés
+ * @return long la somme des résultats
+ */
+long noyau_carre(t_des *lancers, long nombre, t_generateur *generateur) {
+    long somme;
+
+    (void) generateur;
+    somme = 0;
+    for (long k = 0; k < nombre; k++) {
+        somme = somme + carre(lancers[k]);
+    }
+    return somme;
+}
+
+/**
+ * @fn long noyau_petite_suite(t_des *lancers, long nombre, t_generateur *generateur)
+ * 
+ * @brief Cette fonction appelle petite_suite sur chaque lancer
+ * 
+ * @param lancers Les lancers
+ * @param nombre Le nombre de lancers
+ * @param generateur Le générateur des dés
+ * @return long la somme des résultats
+ */
+long noyau_petite_suite(t_des *lancers, long nombre, t_generateur *generateur) {
+    long somme;
+
+    (void) generateur;
+    somme = 0;
+    for (long k = 0; k < nombre; k++) {
+        somme = somme + petite_suite(lancers[k]);
+    }
+    return somme;
+}
+
+/**
+ * @fn long noyau_grande_suite(t_des *lancers, long nombre, t_generateur *generateur)
+ * 
+ * @brief Cette fonction appelle grande_suite sur chaque lancer
+ * 
+ * @param lancers Les lancers
+ * @param nombre Le nombre de lancers
+ * @param generateur Le générateur des dés
+ * @return long la somme des résultats
+ */
+long noyau_grande_suite(t_des *lancers, long nombre, t_generateur *generateur) {
+    long somme;
+
+    (void) generateur;
+    somme = 0;
+    for (long k = 0; k < nombre; k++) {
+        somme = somme + grande_suite(lancers[k]);
+    }
+    return somme;
+}
+
+/**
+ * @fn long noyau_yams(t_des *lancers, long nombre, t_generateur *generateur)
+ * 
+ * @brief Cette fonction appelle yams sur chaque lancer
+ * 
+ * @param lancers Les lancers
+ * @param nombre Le nombre de lancers
+ * @param generateur Le générateur des dés
+ * @return long la somme des résultats
+ */
+long noyau_yams(t_des *lancers, long nombre, t_generateur *generateur) {
+    long somme;
+
+    (void) generateur;
+    somme = 0;
+    for (long k = 0; k < nombre; k++) {
+        somme = somme + yams(lancers[k]);
+    }
+    return somme;
+}
+
+/**
+ * @fn long noyau_compter_points(t_des *lancers, long nombre, t_generateur *generateur)
+ * 
+ * @brief Cette fonction appelle compter_points sur chaque lancer, pour chaque combinaison
+ * 
+ * @param lancers Les lancers
+ * @param nombre Le nombre de lancers
+ * @param generateur Le générateur des dés
+ * @return long la somme des résultats
+ */
+long noyau_compter_points(t_des *lancers, long nombre, t_generateur *generateur) {
+    long somme;
+
+    (void) generateur;
+    somme = 0;
+    for (long k = 0; k < nombre; k++) {
+        for (int c = 0; c < 13; c++) {
+            somme = somme + compter_points(c, lancers[k]);
+        }
+    }
+    return somme;
+}
+
+/**
+ * @fn long noyau_combinaisons_possibles(t_des *lancers, long nombre, t_generateur *generateur)
+ * 
+ * @brief Cette fonction appelle combinaisons_possibles sur chaque lancer
+ * 
+ * @param lancers Les lancers
+ * @param nombre Le nombre de lancers
+ * @param generateur Le générateur des dés
+ * @return long la somme des résultats
+ */
+long noyau_combinaisons_possibles(t_des *lancers, long nombre, t_generateur *generateur) {
+    int combinaisons[13];
+    int nombre_combinaisons;
+    long somme;
+
+    (void) generateur;
+    somme = 0;
+    for (long k = 0; k < nombre; k++) {
+        combinaisons_possibles(lancers[k], combinaisons, &nombre_combinaisons);
+        somme = somme + nombre_combinaisons;
+    }
+    return somme;
+}
+
+/**
+ * @fn long noyau_lancer_des(t_des *lancers, long nombre, t_generateur *generateur)
+ * 
+ * @brief Cette fonction appelle lancer_des autant de fois qu'il y a de lancers
+ * 
+ * @param lancers Les lancers
+ * @param nombre Le nombre de lancers
+ * @param generateur Le générateur des dés
+ * @return long la somme des résultats
+ */
+long noyau_lancer_des(t_des *lancers, long nombre, t_generateur *generateur) {
+    t_des des;
+    long somme;
+
+    (void) lancers;
+    somme = 0;
+    for (long k = 0; k < nombre; k++) {
+        lancer_des(NOMBRE_DES, des, generateur);
+        somme = somme + des[0];
+    }
+    return somme;
+}
+
+/**
+ * @brief Les fonctions des règles mesurées par mesurer-regles, dans l'ordre de l'affichage
+ * 
+ */
+const t_noyau_regles NOYAUX_REGLES[] = {
+    {"compter_des", 1, noyau_compter_des},
+    {"trier_des", 1, noyau_trier_des},
+    {"full_house", 1, noyau_full_house},
+    {"brelan", 1, noyau_brelan},
+    {"carre", 1, noyau_carre},
+    {"petite_suite", 1, noyau_petite_suite},
+    {"grande_suite", 1, noyau_grande_suite},
+    {"yams", 1, noyau_yams},
+    {"compter_points", 13, noyau_compter_points},
+    {"combinaisons_possibles", 1, noyau_combinaisons_possibles},
+    {"lancer_des", 1, noyau_lancer_des},
+};
+
+/**
+ * @fn int comparer_reels(const void *a, const void *b)
+ * 
+ * @brief Cette fonction compare deux réels pour qsort
+ * 
+ * @param a Le premier réel
+ * @param b Le second réel
+ * @return int négatif, nul ou positif selon que a est plus petit, égal ou plus grand que b
+ */
+int comparer_reels(const void *a, const void *b) {
+    double x;
+    double y;
+
+    x = *(const double *) a;
+    y = *(const double *) b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @fn long mesurer_noyau(const t_noyau_regles *noyau, t_des *lancers, long nombre, t_generateur *generateur,
+ *                        t_mesure_regles *mesure)
+ * 
+ * @brief Cette fonction chronomètre une fonction des règles sur une série de lancers
+ * 
+ * @param noyau La fonction mesurée
+ * @param lancers Les lancers
+ * @param nombre Le nombre de lancers
+ * @param generateur Le générateur des fonctions qui lancent les dés
+ * @param mesure Reçoit les durées par opération
+ * @return long la somme des résultats de la fonction, à consommer par l'appelant
+ * 
+ * Consiste à chauffer les caches et les prédicteurs de branchement en passant sur les lancers jusqu'à ce qu'un
+ * passage dure DUREE_ECHANTILLON, puis à chronométrer ECHANTILLONS_MESURE échantillons de ce nombre de passages.
+ * La médiane est peu sensible aux interruptions du système, le minimum approche le coût sans perturbation
+ */
+long mesurer_noyau(const t_noyau_regles *noyau, t_des *lancers, long nombre, t_generateur *generateur,
+                   t_mesure_regles *mesure) {
+    double nanosecondes[ECHANTILLONS_MESURE];
+    double cycles[ECHANTILLONS_MESURE];
+    double operations;
+    double debut;
+    long repetitions;
+    long somme;
+
+    somme = 0;
+    repetitions = 1;
+    do {
+        debut = secondes_ecoulees();
+        for (long r = 0; r < repetitions; r++) {
+            somme = somme + noyau->noyau(lancers, nombre, generateur);
+        }
+        if (secondes_ecoulees() - debut >= DUREE_ECHANTILLON) {
+            break;
+        }
+        repetitions = 2 * repetitions;
+    }
+    while (true);
+
+    operations = (double) repetitions * nombre * noyau->operations;
+    for (int e = 0; e < ECHANTILLONS_MESURE; e++) {
+        uint64_t cycles_debut;
+
+        debut = secondes_ecoulees();
+        cycles_debut = lire_cycles();
+        for (long r = 0; r < repetitions; r++) {
+            somme = somme + noyau->noyau(lancers, nombre, generateur);
+        }
+        cycles[e] = (lire_cycles() - cycles_debut) / operations;
+        nanosecondes[e] = (secondes_ecoulees() - debut) * 1e9 / operations;
+    }
+
+    qsort(nanosecondes, ECHANTILLONS_MESURE, sizeof(double), comparer_reels);
+    qsort(cycles, ECHANTILLONS_MESURE, sizeof(double), comparer_reels);
+    mesure->nanosecondes = nanosecondes[ECHANTILLONS_MESURE / 2];
+    mesure->nanosecondes_minimum = nanosecondes[0];
+    mesure->cycles = cycles[ECHANTILLONS_MESURE / 2];
+    mesure->dispersion = (nanosecondes[3 * ECHANTILLONS_MESURE / 4] - nanosecondes[ECHANTILLONS_MESURE / 4])
+                         / mesure->nanosecondes;
+
+    return somme;
+}
+
+/*********************************
+ *     STRATÉGIES EXTERNES       *
+ *********************************/
+
+/**
+ * @brief Représente le contexte d'une instance d'une stratégie externe
+ * 
+ */
+typedef struct {
+    const t_module_strategie *module;
+    void *donnees;
+} t_contexte_module;
+
+/**
+ * @fn int module_choisir_relance(t_des des, t_score scores, int relances_restantes, void *contexte)
+ * 
+ * @brief Cette fonction transmet une décision de relance à une stratégie externe
+ * 
+ * @param des Les 5 dés du joueur
+ * @param scores La feuille de score
+ * @param relances_restantes Le nombre de relances encore possibles
+ * @param contexte Le t_contexte_module de l'instance
+ * @return int le masque des dés à relancer
+ */
+int module_choisir_relance(t_des des, t_score scores, int relances_restantes, void *contexte) {
+    t_contexte_module *module;
+    t_vue_partie vue;
+
+    module = contexte;
+    remplir_vue(&vue, des, scores, resumer_feuille(scores), relances_restantes);
+    return module->module->choisir_relance(module->donnees, &vue);
+}
+
+/**
+ * @fn int module_choisir_combinaison(t_des des, t_score scores, void *contexte)
+ * 
+ * @brief Cette fonction transmet un choix de combinaison à une stratégie externe
+ * 
+ * @param des Les 5 dés du joueur
+ * @param scores La feuille de score
+ * @param contexte Le t_contexte_module de l'instance
+ * @return int l'indice de la combinaison choisie
+ */
+int module_choisir_combinaison(t_des des, t_score scores, void *contexte) {
+    t_contexte_module *module;
+    t_vue_partie vue;
+
+    module = contexte;
+    remplir_vue(&vue, des, scores, resumer_feuille(scores), 0);
+    return module->module->choisir_combinaison(module->donnees, &vue);
+}
+
+/**
+ * @fn void module_choisir_relances(const t_vue_partie *vues, int32_t *masques, size_t nombre, void *contexte)
+ * 
+ * @brief Cette procédure transmet un lot de décisions de relance à une stratégie externe
+ * 
+ * @param vues Les vues des parties
+ * @param masques Reçoit le masque des dés à relancer de chaque partie
+ * @param nombre Le nombre de parties
+ * @param contexte Le t_contexte_module de l'instance
+ * 
+ * Une stratégie sans version par lots reçoit les parties une par une
+ */
+void module_choisir_relances(const t_vue_partie *vues, int32_t *masques, size_t nombre, void *contexte) {
+    t_contexte_module *module;
+
+    module = contexte;
+    if (module->module->choisir_relances != NULL) {
+        module->module->choisir_relances(module->donnees, vues, masques, nombre);
+    }
+    else {
+        for (size_t k = 0; k < nombre; k++) {
+            masques[k] = module->module->choisir_relance(module->donnees, &vues[k]);
+        }
+    }
+}
+
+/**
+ * @fn void module_choisir_combinaisons(const t_vue_partie *vues, int32_t *combinaisons, size_t nombre,
+ *                                      void *contexte)
+ * 
+ * @brief Cette procédure transmet un lot de choix de combinaison à une stratégie externe
+ * 
+ * @param vues Les vues des parties
+ * @param combinaisons Reçoit la combinaison choisie pour chaque partie
+ * @param nombre Le nombre de parties
+ * @param contexte Le t_contexte_module de l'instance
+ * 
+ * Une stratégie sans version par lots reçoit les parties une par une
+ */
+void module_choisir_combinaisons(const t_vue_partie *vues, int32_t *combinaisons, size_t nombre, void *contexte) {
+    t_contexte_module *module;
+
+    module = contexte;
+    if (module->module->choisir_combinaisons != NULL) {
+        module->module->choisir_combinaisons(module->donnees, vues, combinaisons, nombre);
+    }
+    else {
+        for (size_t k = 0; k < nombre; k++) {
+            combinaisons[k] = module->module->choisir_combinaison(module->donnees, &vues[k]);
+        }
+    }
+}
+
+/**
+ * @fn void *creer_contexte_module(void *contexte)
+ * 
+ * @brief Cette fonction crée le contexte d'une instance d'une stratégie externe
+ * 
+ * @param contexte Le t_module_strategie de la stratégie
+ * @return void* le t_contexte_module de l'instance, avec les données créées par la stratégie, NULL si la mémoire
+ * manque ou si creer échoue
+ */
+void *creer_contexte_module(void *contexte) {
+    t_contexte_module *module;
+
+    module = malloc(sizeof(t_contexte_module));
+    if (module == NULL) {
+        return NULL;
+    }
+    module->module = contexte;
+    module->donnees = NULL;
+    if (module->module->creer != NULL) {
+        module->donnees = module->module->creer();
+        if (module->donnees == NULL) {
+            free(module);
+            return NULL;
+        }
+    }
+
+    return module;
+}
+
+/**
+ * @fn void detruire_contexte_module(void *contexte)
+ * 
+ * @brief Cette procédure libère le contexte d'une instance d'une stratégie externe
+ * 
+ * @param contexte Le t_contexte_module de l'instance
+ */
+void detruire_contexte_module(void *contexte) {
+    t_contexte_module *module;
+
+    module = contexte;
+    if (module->module->detruire != NULL) {
+        module->module->detruire(module->donnees);
+    }
+    free(module);
+}
+
+/**
+ * @fn bool charger_module(const char *chemin, t_strategie *strategie)
+ * 
+ * @brief Cette fonction charge une stratégie externe depuis une bibliothèque partagée
+ * 
+ * @param chemin Le chemin de la bibliothèque, passé tel quel à dlopen
+ * @param strategie Reçoit la stratégie, qui décide par lots et porte le chemin comme nom
+ * @return true si la bibliothèque exporte une stratégie de la version VERSION_MODULE_STRATEGIE
+ * @return false sinon, le message d'erreur étant affiché
+ * 
+ * La bibliothèque reste chargée jusqu'à la fin du programme. L'interface des stratégies externes ne décrit que
+ * 5 dés à 6 faces : une variante à d'autres dés refuse de les charger.
+ */
+bool charger_module(const char *chemin, t_strategie *strategie) {
+    void *bibliotheque;
+    t_point_entree_strategie point_entree;
+    const t_module_strategie *module;
+
+    if (NOMBRE_DES != 5 || NOMBRE_FACES != 6) {
+        fprintf(stderr, "Les stratégies externes ne jouent qu'avec 5 dés à 6 faces : %s\n", chemin);
+        return false;
+    }
+
+    bibliotheque = dlopen(chemin, RTLD_NOW | RTLD_LOCAL);
+    if (bibliotheque == NULL) {
+        fprintf(stderr, "Impossible de charger %s : %s\n", chemin, dlerror());
+        return false;
+    }
+
+    *(void **) &point_entree = dlsym(bibliotheque, SYMBOLE_MODULE_STRATEGIE);
+    module = point_entree != NULL ? point_entree() : NULL;
+    if (module == NULL || module->version != VERSION_MODULE_STRATEGIE || module->choisir_relance == NULL
+        || module->choisir_combinaison == NULL) {
+        fprintf(stderr, "%s n'exporte pas de stratégie de version %d\n", chemin, VERSION_MODULE_STRATEGIE);
+        dlclose(bibliotheque);
+        return false;
+    }
+
+    strategie->nom = chemin;
+    strategie->choisir_relance = module_choisir_relance;
+    strategie->choisir_combinaison = module_choisir_combinaison;
+    strategie->contexte = (void *) module;
+    strategie->creer_contexte = creer_contexte_module;
+    strategie->detruire_contexte = detruire_contexte_module;
+    strategie->choisir_relances = module_choisir_relances;
+    strategie->choisir_combinaisons = module_choisir_combinaisons;
+
+    return true;
+}
+
+/*********************************
+ *      CACHE DES DÉCISIONS      *
+ *********************************/
+
+/**
+ * @brief Raccourci associé au nombre de tranches du cache des décisions, chacune avec son propre verrou d'écriture
+ * 
+ */
+#define TRANCHES_CACHE 64
+
+/**
+ * @brief Raccourci associé au nombre d'emplacements d'un ensemble du cache, une ligne de cache du processeur
+ * 
+ */
+#define EMPLACEMENTS_ENSEMBLE 8
+
+/**
+ * @brief Raccourci associé au nombre d'emplacements par défaut du cache des décisions, 8 Mo
+ * 
+ */
+#define EMPLACEMENTS_CACHE (1 << 20)
+
+/**
+ * @brief Représente une tranche du cache des décisions
+ * 
+ * Une clé ne peut occuper que les EMPLACEMENTS_ENSEMBLE emplacements de son ensemble. Chaque emplacement est un
+ * mot de 64 bits qui contient la clé plus 1 et la décision, 0 s'il est vide : une lecture est un chargement
+ * atomique, sans verrou. Le verrou ne sérialise que les écritures de la tranche. references contient le bit de
+ * référence de chaque emplacement d'un ensemble, mis par les lectures réussies et effacé par l'aiguille de
+ * l'horloge de l'ensemble quand elle cherche une victime.
+ * 
+ */
+typedef struct {
+    pthread_mutex_t verrou;
+    _Atomic uint64_t *emplacements;
+    _Atomic uint8_t *references;
+    uint8_t *aiguilles;
+} __attribute__((aligned(64))) t_tranche_cache;
+
+/**
+ * @brief Représente un cache borné et partagé entre threads des décisions d'une stratégie
+ * 
+ */
+typedef struct {
+    uint32_t ensembles_par_tranche;
+    t_tranche_cache tranches[TRANCHES_CACHE];
+} t_cache_decisions;
+
+/**
+ * @brief Représente une stratégie dont les décisions passent par un cache, partagée par toutes ses instances
+ * 
+ * succes et echecs additionnent les compteurs des instances détruites
+ * 
+ */
+typedef struct {
+    t_strategie interne;
+    t_cache_decisions *cache;
+    atomic_long succes;
+    atomic_long echecs;
+} t_partage_memo;
+
+/**
+ * @brief Représente le contexte d'une instance d'une stratégie avec cache, qui a sa propre instance de la
+ * stratégie interne pour les décisions absentes du cache
+ * 
+ * Les décisions trouvées et calculées sont comptées dans l'instance, utilisée par un seul thread : les lectures du
+ * cache n'écrivent ainsi dans aucune mémoire partagée. Les compteurs sont ajoutés à ceux de la stratégie partagée
+ * à la destruction de l'instance.
+ * 
+ */
+typedef struct {
+    t_partage_memo *partage;
+    t_strategie instance;
+    long succes;
+    long echecs;
+} t_contexte_memo;
+
+/**
+ * @fn t_cache_decisions *creer_cache_decisions(size_t emplacements)
+ * 
+ * @brief Cette fonction crée un cache des décisions vide
+ * 
+ * @param emplacements Le nombre d'emplacements, arrondi à un nombre entier d'ensembles par tranche
+ * @return t_cache_decisions* le cache, à libérer avec liberer_cache_decisions, NULL si la mémoire manque
+ */
+t_cache_decisions *creer_cache_decisions(size_t emplacements) {
+    t_cache_decisions *cache;
+    size_t par_tranche;
+
+    cache = aligned_alloc(64, sizeof(t_cache_decisions));
+    if (cache == NULL) {
+        return NULL;
+    }
+    cache->ensembles_par_tranche = emplacements / (TRANCHES_CACHE * EMPLACEMENTS_ENSEMBLE);
+    if (cache->ensembles_par_tranche == 0) {
+        cache->ensembles_par_tranche = 1;
+    }
+    par_tranche = (size_t) cache->ensembles_par_tranche * EMPLACEMENTS_ENSEMBLE;
+
+    for (int t = 0; t < TRANCHES_CACHE; t++) {
+        t_tranche_cache *tranche;
+
+        tranche = &cache->tranches[t];
+        pthread_mutex_init(&tranche->verrou, NULL);
+        tranche->emplacements = aligned_alloc(64, par_tranche * sizeof(uint64_t));
+        tranche->references = malloc(cache->ensembles_par_tranche);
+        tranche->aiguilles = calloc(cache->ensembles_par_tranche, 1);
+        if (tranche->emplacements == NULL || tranche->references == NULL || tranche->aiguilles == NULL) {
+            for (int u = 0; u <= t; u++) {
+                pthread_mutex_destroy(&cache->tranches[u].verrou);
+                free((void *) cache->tranches[u].emplacements);
+                free((void *) cache->tranches[u].references);
+                free(cache->tranches[u].aiguilles);
+            }
+            free(cache);
+            return NULL;
+        }
+        for (size_t e = 0; e < par_tranche; e++) {
+            atomic_init(&tranche->emplacements[e], 0);
+        }
+        for (uint32_t e = 0; e < cache->ensembles_par_tranche; e++) {
+            atomic_init(&tranche->references[e], 0);
+        }
+    }
+
+    return cache;
+}
+
+/**
+ * @fn void liberer_cache_decisions(t_cache_decisions *cache)
+ * 
+ * @brief Cette procédure libère un cache des décisions
+ * 
+ * @param cache Le cache
+ */
+void liberer_cache_decisions(t_cache_decisions *cache) {
+    for (int t = 0; t < TRANCHES_CACHE; t++) {
+        pthread_mutex_destroy(&cache->tranches[t].verrou);
+        free((void *) cache->tranches[t].emplacements);
+        free((void *) cache->tranches[t].references);
+        free(cache->tranches[t].aiguilles);
+    }
+    free(cache);
+}
+
+/**
+ * @fn uint64_t cle_decision(t_des des, t_etat_joueur etat, int relances_restantes)
+ * 
+ * @brief Cette fonction code une question posée à une stratégie sur 29 bits
+ * 
+ * @param des Les 5 dés, dont seul compte l'ensemble des faces
+ * @param etat La feuille résumée, dont comptent le masque des combinaisons remplies et le total supérieur plafonné
+ * @param relances_restantes Le nombre de relances encore possibles, 0 pour le choix de la combinaison
+ * @return uint64_t la clé : l'indice de la main, les relances, le masque et le total plafonné
+ */
+uint64_t cle_decision(t_des des, t_etat_joueur etat, int relances_restantes) {
+    return ((uint64_t) indice_main(des) << 21) | ((uint64_t) relances_restantes << 19)
+         | (uint64_t) ETAT_CLE_SOLVEUR(etat);
+}
+
+/**
+ * @fn bool chercher_decision(t_cache_decisions *cache, uint64_t cle, int *decision)
+ * 
+ * @brief Cette fonction cherche une décision dans le cache, sans verrou
+ * 
+ * @param cache Le cache
+ * @param cle La clé de la question, voir cle_decision
+ * @param decision Reçoit la décision si elle est dans le cache
+ * @return true si la décision est dans le cache
+ * @return false sinon
+ * 
+ * Les 8 emplacements de l'ensemble occupent une seule ligne de cache. Le bit de référence n'est écrit que s'il
+ * n'est pas déjà mis, pour que les lectures répétées d'une même décision ne fassent pas circuler la ligne entre
+ * les coeurs ; pour la même raison, les succès et les échecs sont comptés par l'appelant dans son instance.
+ */
+bool chercher_decision(t_cache_decisions *cache, uint64_t cle, int *decision) {
+    t_tranche_cache *tranche;
+    _Atomic uint64_t *ensemble;
+    uint64_t hachage;
+    uint32_t indice;
+
+    hachage = hacher_etat(cle);
+    tranche = &cache->tranches[hachage % TRANCHES_CACHE];
+    indice = (hachage / TRANCHES_CACHE) % cache->ensembles_par_tranche;
+    ensemble = tranche->emplacements + (size_t) indice * EMPLACEMENTS_ENSEMBLE;
+
+    for (int e = 0; e < EMPLACEMENTS_ENSEMBLE; e++) {
+        uint64_t emplacement;
+
+        emplacement = atomic_load_explicit(&ensemble[e], memory_order_acquire);
+        if (emplacement >> 16 == cle + 1) {
+            *decision = emplacement & 0xFFFF;
+            if (!(atomic_load_explicit(&tranche->references[indice], memory_order_relaxed) & (1 << e))) {
+                atomic_fetch_or_explicit(&tranche->references[indice], 1 << e, memory_order_relaxed);
+            }
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @fn void ranger_decision(t_cache_decisions *cache, uint64_t cle, int decision)
+ * 
+ * @brief Cette procédure range une décision dans le cache
+ * 
+ * @param cache Le cache
+ * @param cle La clé de la question, voir cle_decision
+ * @param decision La décision, de 0 à 65535
+ * 
+ * Prend un emplacement vide de l'ensemble s'il en reste, sinon le premier emplacement sans bit de référence en
+ * partant de l'aiguille, dont le passage efface les bits de référence des emplacements épargnés (algorithme de
+ * l'horloge). Une décision rangée entre-temps par un autre thread n'est pas dupliquée.
+ */
+void ranger_decision(t_cache_decisions *cache, uint64_t cle, int decision) {
+    t_tranche_cache *tranche;
+    _Atomic uint64_t *ensemble;
+    uint64_t hachage;
+    uint32_t indice;
+    int victime;
+
+    hachage = hacher_etat(cle);
+    tranche = &cache->tranches[hachage % TRANCHES_CACHE];
+    indice = (hachage / TRANCHES_CACHE) % cache->ensembles_par_tranche;
+    ensemble = tranche->emplacements + (size_t) indice * EMPLACEMENTS_ENSEMBLE;
+
+    pthread_mutex_lock(&tranche->verrou);
+
+    victime = -1;
+    for (int e = 0; e < EMPLACEMENTS_ENSEMBLE; e++) {
+        uint64_t emplacement;
+
+        emplacement = atomic_load_explicit(&ensemble[e], memory_order_relaxed);
+        if (emplacement >> 16 == cle + 1) {
+            pthread_mutex_unlock(&tranche->verrou);
+            return;
+        }
+        if (emplacement == 0 && victime == -1) {
+            victime = e;
+        }
+    }
+
+    while (victime == -1) {
+        int aiguille;
+
+        aiguille = tranche->aiguilles[indice];
+        tranche->aiguilles[indice] = (aiguille + 1) % EMPLACEMENTS_ENSEMBLE;
+        if (atomic_load_explicit(&tranche->references[indice], memory_order_relaxed) & (1 << aiguille)) {
+            atomic_fetch_and_explicit(&tranche->references[indice], ~(1 << aiguille), memory_order_relaxed);
+        }
+        else {
+            victime = aiguille;
+        }
+    }
+
+    atomic_fetch_and_explicit(&tranche->references[indice], ~(1 << victime), memory_order_relaxed);
+    atomic_store_explicit(&ensemble[victime], ((cle + 1) << 16) | (decision & 0xFFFF), memory_order_release);
+
+    pthread_mutex_unlock(&tranche->verrou);
+}
+
+/**
+ * @fn int memo_choisir_relance(t_des des, t_score scores, int relances_restantes, void *contexte)
+ * 
+ * @brief Cette fonction est la décision de relance d'une stratégie avec cache
+ * 
+ * @param des Les 5 dés du joueur
+ * @param scores La feuille de score
+ * @param relances_restantes Le nombre de relances encore possibles
+ * @param contexte Le contexte de l'instance, de type t_contexte_memo
+ * @return int le masque des dés à relancer
+ * 
+ * Le cache garde l'indice de la garde plutôt que le masque, qui dépend de l'ordre des dés : la garde est
+ * retrouvée parmi les 32 façons de garder les dés tenus, dans l'ordre où meilleure_garde les essaie. memo-optimal
+ * relance donc les mêmes dés que optimal, sauf entre deux gardes d'espérances exactement égales, où le premier
+ * ordre des dés rencontré décide.
+ */
+int memo_choisir_relance(t_des des, t_score scores, int relances_restantes, void *contexte) {
+    t_contexte_memo *memo;
+    uint64_t cle;
+    int garde;
+    int masque;
+
+    memo = contexte;
+    cle = cle_decision(des, resumer_feuille(scores), relances_restantes);
+
+    if (chercher_decision(memo->partage->cache, cle, &garde)) {
+        for (int k = 0; k < NOMBRE_MASQUES; k++) {
+            int garde_des;
+
+            garde_des = (k + MASQUE_DES) % NOMBRE_MASQUES;
+            if (INDICE_PAR_HISTOGRAMME[code_histogramme(des, garde_des)] == garde) {
+                memo->succes = memo->succes + 1;
+                return ~garde_des & MASQUE_DES;
+            }
+        }
+    }
+
+    memo->echecs = memo->echecs + 1;
+    masque = memo->instance.choisir_relance(des, scores, relances_restantes, memo->instance.contexte);
+    ranger_decision(memo->partage->cache, cle, INDICE_PAR_HISTOGRAMME[code_histogramme(des, ~masque & MASQUE_DES)]);
+    return masque;
+}
+
+/**
+ * @fn int memo_choisir_combinaison(t_des des, t_score scores, void *contexte)
+ * 
+ * @brief Cette fonction est le choix de combinaison d'une stratégie avec cache
+ * 
+ * @param des Les 5 dés du joueur
+ * @param scores La feuille de score
+ * @param contexte Le contexte de l'instance, de type t_contexte_memo
+ * @return int l'indice de la combinaison choisie
+ */
+int memo_choisir_combinaison(t_des des, t_score scores, void *contexte) {
+    t_contexte_memo *memo;
+    uint64_t cle;
+    int combinaison;
+
+    memo = contexte;
+    cle = cle_decision(des, resumer_feuille(scores), 0);
+
+    if (chercher_decision(memo->partage->cache, cle, &combinaison)) {
+        memo->succes = memo->succes + 1;
+    }
+    else {
+        memo->echecs = memo->echecs + 1;
+        combinaison = memo->instance.choisir_combinaison(des, scores, memo->instance.contexte);
+        ranger_decision(memo->partage->cache, cle, combinaison);
+    }
+
+    return combinaison;
+}
+
+/**
+ * @fn void *creer_contexte_memo(void *contexte)
+ * 
+ * @brief Cette fonction crée le contexte d'une instance d'une stratégie avec cache
+ * 
+ * @param contexte La stratégie partagée, de type t_partage_memo
+ * @return void* le contexte, de type t_contexte_memo, à libérer avec detruire_contexte_memo, NULL si la mémoire
+ * manque pour lui ou pour l'instance de la stratégie interne
+ */
+void *creer_contexte_memo(void *contexte) {
+    t_contexte_memo *memo;
+
+    memo = malloc(sizeof(t_contexte_memo));
+    if (memo == NULL) {
+        return NULL;
+    }
+    memo->partage = contexte;
+    if (!instancier_strategie(&memo->partage->interne, &memo->instance)) {
+        free(memo);
+        return NULL;
+    }
+    memo->succes = 0;
+    memo->echecs = 0;
+
+    return memo;
+}
+
+/**
+ * @fn void detruire_contexte_memo(void *contexte)
+ * 
+ * @brief Cette procédure libère le contexte d'une instance d'une stratégie avec cache
+ * 
+ * @param contexte Le contexte, de type t_contexte_memo, dont les compteurs sont ajoutés à la stratégie partagée
+ */
+void detruire_contexte_memo(void *contexte) {
+    t_contexte_memo *memo;
+
+    memo = contexte;
+    atomic_fetch_add_explicit(&memo->partage->succes, memo->succes, memory_order_relaxed);
+    atomic_fetch_add_explicit(&memo->partage->echecs, memo->echecs, memory_order_relaxed);
+    liberer_instance(&memo->instance);
+    free(memo);
+}
+
+/**
+ * @fn bool mettre_en_cache(const t_strategie *interne, const char *nom, t_strategie *strategie)
+ * 
+ * @brief Cette fonction prépare une stratégie qui passe les décisions d'une autre par un cache partagé
+ * 
+ * @param interne La stratégie dont les décisions sont mises en cache
+ * @param nom Le nom de la nouvelle stratégie
+ * @param strategie Reçoit la stratégie, dont le cache reste alloué jusqu'à la fin du programme
+ * @return true si la stratégie a été préparée
+ * @return false si la mémoire manque pour le cache
+ * 
+ * La clé ne retient que l'ensemble des dés, les relances restantes, les combinaisons remplies et le total
+ * supérieur plafonné : ce sont les seules informations que lit la stratégie optimale, mais une stratégie qui
+ * regarde le total de la feuille, comme seuil-N, ne doit pas être mise en cache. Les décisions par lots de la
+ * stratégie interne ne sont pas utilisées.
+ */
+bool mettre_en_cache(const t_strategie *interne, const char *nom, t_strategie *strategie) {
+    t_partage_memo *partage;
+
+    partage = malloc(sizeof(t_partage_memo));
+    if (partage == NULL) {
+        return false;
+    }
+    partage->interne = *interne;
+    partage->cache = creer_cache_decisions(EMPLACEMENTS_CACHE);
+    if (partage->cache == NULL) {
+        free(partage);
+        return false;
+    }
+    atomic_init(&partage->succes, 0);
+    atomic_init(&partage->echecs, 0);
+
+    strategie->nom = nom;
+    strategie->choisir_relance = memo_choisir_relance;
+    strategie->choisir_combinaison = memo_choisir_combinaison;
+    strategie->contexte = partage;
+    strategie->creer_contexte = creer_contexte_memo;
+    strategie->detruire_contexte = detruire_contexte_memo;
+    strategie->choisir_relances = NULL;
+    strategie->choisir_combinaisons = NULL;
+
+    return true;
+}
+
+/**
+ * @fn void afficher_cache_strategie(FILE *flux, const t_strategie *strategie)
+ * 
+ * @brief Cette procédure affiche les compteurs du cache d'une stratégie, si elle en a un
+ * 
+ * @param flux Le flux où écrire
+ * @param strategie La stratégie
+ * 
+ * Seules comptent les instances déjà détruites, c'est-à-dire les simulations terminées
+ */
+void afficher_cache_strategie(FILE *flux, const t_strategie *strategie) {
+    t_partage_memo *partage;
+    long succes;
+    long echecs;
+
+    if (strategie->choisir_relance != memo_choisir_relance) {
+        return;
+    }
+
+    partage = strategie->contexte;
+    succes = atomic_load_explicit(&partage->succes, memory_order_relaxed);
+    echecs = atomic_load_explicit(&partage->echecs, memory_order_relaxed);
+    fprintf(flux, "Cache         : %ld trouvées, %ld calculées (%.1f %%)\n", succes, echecs,
+            succes + echecs > 0 ? 100.0 * succes / (succes + echecs) : 0.0);
+}
+
+/*********************************
+ *      SERVEUR DE PARTIES       *
+ *********************************/
+
+/**
+ * @brief Raccourci associé au nombre maximal de joueurs d'une partie du serveur
+ * 
+ */
+#define JOUEURS_SESSION_MAX 4
+
+/**
+ * @brief Raccourci associé à la longueur maximale d'une commande reçue par le serveur, fin de ligne comprise
+ * 
+ */
+#define TAILLE_ENTREE_SESSION 64
+
+/**
+ * @brief Raccourci associé à la taille maximale d'une réponse du serveur à une commande
+ * 
+ */
+#define TAILLE_REPONSE_SESSION 512
+
+/**
+ * @brief Raccourcis associés aux étapes d'une session : sans partie, en attente d'une relance ou d'une validation,
+ * d'une validation seulement quand il ne reste plus de relance, et partie terminée dont les feuilles restent
+ * lisibles jusqu'à la partie suivante
+ * 
+ */
+#define ETAPE_SANS_PARTIE 0
+#define ETAPE_RELANCE 1
+#define ETAPE_COMBINAISON 2
+#define ETAPE_TERMINEE 3
+
+/**
+ * @brief Représente une session du serveur : une connexion et la partie qui s'y joue
+ * 
+ * Toute la partie tient dans la session, feuilles comprises, et la commande en cours de réception dans un tampon
+ * fixe. Une réponse qui ne peut pas être envoyée d'un coup est gardée dans attente, alloué seulement dans ce cas ;
+ * la session ne lit plus de commande tant que cette réponse n'est pas partie.
+ * 
+ */
+typedef struct {
+    int descripteur;
+    uint8_t etape;
+    uint8_t longueur_entree;
+    bool ligne_trop_longue;
+    uint16_t longueur_attente;
+    char *attente;
+    t_partie partie;
+    int cases[TAILLE_FEUILLES(JOUEURS_SESSION_MAX)];
+    t_etat_joueur etats[JOUEURS_SESSION_MAX];
+    char entree[TAILLE_ENTREE_SESSION];
+} t_session;
+
+/**
+ * @brief Représente l'état du serveur de parties
+ * 
+ * ecoute_suspendue vaut vrai quand la socket d'écoute n'est plus surveillée, faute de descripteur libre pour
+ * accepter une connexion
+ * 
+ */
+typedef struct {
+    int epoll;
+    int ecoute;
+    bool ecoute_suspendue;
+    t_generateur graines;
+    long sessions_ouvertes;
+    long sessions_max;
+    long sessions_totales;
+    long commandes;
+} t_serveur;
+
+/**
+ * @brief Vaut 1 quand le serveur a reçu une demande d'arrêt
+ * 
+ */
+volatile sig_atomic_t ARRET_SERVEUR = 0;
+
+/**
+ * @fn void demander_arret_serveur(int signal)
+ * 
+ * @brief Cette procédure est appelée à la réception de SIGINT ou SIGTERM
+ * 
+ * @param signal Le signal reçu
+ */
+void demander_arret_serveur(int signal) {
+    (void) signal;
+    ARRET_SERVEUR = 1;
+}
+
+/**
+ * @fn void reprendre_ecoute(t_serveur *serveur)
+ * 
+ * @brief Cette procédure surveille de nouveau la socket d'écoute si elle avait été suspendue
+ * 
+ * @param serveur Le serveur
+ */
+void reprendre_ecoute(t_serveur *serveur) {
+    struct epoll_event evenement;
+
+    if (!serveur->ecoute_suspendue) {
+        return;
+    }
+    evenement.events = EPOLLIN;
+    evenement.data.ptr = NULL;
+    epoll_ctl(serveur->epoll, EPOLL_CTL_MOD, serveur->ecoute, &evenement);
+    serveur->ecoute_suspendue = false;
+}
+
+/**
+ * @fn void fermer_session(t_serveur *serveur, t_session *session)
+ * 
+ * @brief Cette procédure ferme une session et libère sa mémoire
+ * 
+ * @param serveur Le serveur
+ * @param session La session
+ * 
+ * Un descripteur se libère : la socket d'écoute suspendue est de nouveau surveillée
+ */
+void fermer_session(t_serveur *serveur, t_session *session) {
+    close(session->descripteur);
+    free(session->attente);
+    free(session);
+    serveur->sessions_ouvertes = serveur->sessions_ouvertes - 1;
+    reprendre_ecoute(serveur);
+}
+
+/**
+ * @fn bool envoyer_session(t_serveur *serveur, t_session *session, const char *reponse, size_t longueur)
+ * 
+ * @brief Cette fonction envoie une réponse à une session, sans jamais bloquer le serveur
+ * 
+ * @param serveur Le serveur
+ * @param session La session
+ * @param reponse La réponse
+ * @param longueur Sa longueur en octets
+ * @return true si la session reste ouverte
+ * @return false si elle a été fermée, faute de mémoire pour garder la réponse
+ * 
+ * Ce qui n'a pas pu être envoyé est gardé dans la session, qui ne surveille plus que la possibilité d'écrire
+ */
+bool envoyer_session(t_serveur *serveur, t_session *session, const char *reponse, size_t longueur) {
+    struct epoll_event evenement;
+    ssize_t envoyes;
+    char *attente;
+
+    envoyes = 0;
+    if (session->longueur_attente == 0) {
+        envoyes = send(session->descripteur, reponse, longueur, MSG_DONTWAIT | MSG_NOSIGNAL);
+        if (envoyes < 0) {
+            envoyes = 0;
+        }
+    }
+    if ((size_t) envoyes == longueur) {
+        return true;
+    }
+
+    attente = realloc(session->attente, session->longueur_attente + longueur - envoyes);
+    if (attente == NULL) {
+        fermer_session(serveur, session);
+        return false;
+    }
+    session->attente = attente;
+    memcpy(session->attente + session->longueur_attente, reponse + envoyes, longueur - envoyes);
+    session->longueur_attente = session->longueur_attente + longueur - envoyes;
+
+    evenement.events = EPOLLOUT;
+    evenement.data.ptr = session;
+    epoll_ctl(serveur->epoll, EPOLL_CTL_MOD, session->descripteur, &evenement);
+    return true;
+}
+
+/**
+ * @fn int ecrire_invite(t_session *session, char *reponse, int longueur)
+ * 
+ * @brief Cette fonction ajoute à une réponse l'invite de l'étape en cours de la session
+ * 
+ * @param session La session
+ * @param reponse La réponse
+ * @param longueur La longueur actuelle de la réponse
+ * @return int la nouvelle longueur de la réponse
+ * 
+ * En cours de partie, l'invite rappelle les dés, le joueur et les relances restantes
+ */
+int ecrire_invite(t_session *session, char *reponse, int longueur) {
+    t_partie *partie;
+    char texte[4 * NOMBRE_DES];
+
+    partie = &session->partie;
+    if (session->etape == ETAPE_SANS_PARTIE || session->etape == ETAPE_TERMINEE) {
+        return longueur + snprintf(reponse + longueur, TAILLE_REPONSE_SESSION - longueur,
+                                   "invite partie <joueurs> [graine]\n");
+    }
+
+    formater_des(texte, sizeof(texte), partie->des);
+    return longueur + snprintf(reponse + longueur, TAILLE_REPONSE_SESSION - longueur,
+                               "des %s joueur %d relances %d\ninvite %s\n", texte, partie->joueur + 1,
+                               partie->relances_restantes,
+                               session->etape == ETAPE_RELANCE ? "keep|roll|score" : "score");
+}
+
+/**
+ * @fn int executer_commande_session(t_serveur *serveur, t_session *session, char *ligne, char *reponse)
+ * 
+ * @brief Cette fonction exécute une commande reçue par une session et prépare la réponse
+ * 
+ * @param serveur Le serveur, qui fournit les graines des parties
+ * @param session La session
+ * @param ligne La commande, sans fin de ligne
+ * @param reponse La réponse, TAILLE_REPONSE_SESSION octets au plus
+ * @return int la longueur de la réponse, -1 pour fermer la session
+ * 
+ * Les commandes sont celles des parties scriptées, plus feuille et quitter :
+ *   partie <joueurs> [graine]   commence une partie de 1 à JOUEURS_SESSION_MAX joueurs
+ *   keep [d1 d2 ...]            garde les dés désignés et relance les autres
+ *   roll [d1 d2 ...]            relance les dés désignés
+ *   score <combinaison>         valide / barre une combinaison pour le joueur en cours
+ *   feuille                     donne la feuille de chaque joueur, -1 pour une case vide, y compris celles de
+ *                               la dernière partie terminée
+ *   quitter                     ferme la session
+ * Une commande refusée donne une ligne erreur et laisse la partie inchangée. Chaque réponse se termine par
+ * l'invite de l'étape suivante.
+ */
+int executer_commande_session(t_serveur *serveur, t_session *session, char *ligne, char *reponse) {
+    t_partie *partie;
+    char *commande;
+    char *arguments;
+    const char *erreur;
+    int longueur;
+
+    partie = &session->partie;
+    erreur = NULL;
+    longueur = 0;
+
+    commande = ligne + strspn(ligne, " \t\r");
+    arguments = commande + strcspn(commande, " \t\r");
+    if (*arguments != '\0') {
+        *arguments = '\0';
+        arguments = arguments + 1;
+    }
+    arguments[strcspn(arguments, "\r")] = '\0';
+    serveur->commandes = serveur->commandes + 1;
+
+    if (strcmp(commande, "quitter") == 0) {
+        return -1;
+    }
+    else if (*commande == '\0') {
+        erreur = NULL;
+    }
+    else if (strcmp(commande, "partie") == 0) {
+        unsigned long long graine;
+        int nombre_joueurs;
+        int lus;
+
+        lus = sscanf(arguments, "%d %llu", &nombre_joueurs, &graine);
+        if (lus < 1 || nombre_joueurs < 1 || nombre_joueurs > JOUEURS_SESSION_MAX) {
+            erreur = "partie attend un nombre de joueurs de 1 à 4 et une graine facultative";
+        }
+        else {
+            initialiser_generateur(&partie->generateur, lus == 2 ? graine : tirer_64(&serveur->graines));
+            initialiser_partie(partie, nombre_joueurs, session->cases, session->etats);
+            commencer_tour(partie);
+            session->etape = ETAPE_RELANCE;
+        }
+    }
+    else if (strcmp(commande, "feuille") == 0) {
+        if (session->etape == ETAPE_SANS_PARTIE) {
+            erreur = "aucune partie en cours";
+        }
+        for (int j = 0; erreur == NULL && j < partie->nombre_joueurs; j++) {
+            t_score feuille;
+
+            lire_feuille(&partie->feuilles, j, feuille);
+            longueur = longueur + snprintf(reponse + longueur, TAILLE_REPONSE_SESSION - longueur, "feuille %d", j + 1);
+            for (int c = 0; c < 13; c++) {
+                longueur = longueur + snprintf(reponse + longueur, TAILLE_REPONSE_SESSION - longueur, " %d",
+                                               feuille[c]);
+            }
+            longueur = longueur + snprintf(reponse + longueur, TAILLE_REPONSE_SESSION - longueur, " total %d\n",
+                                           calculer_total(feuille));
+        }
+    }
+    else if (session->etape == ETAPE_SANS_PARTIE) {
+        erreur = "aucune partie en cours";
+    }
+    else if (session->etape == ETAPE_TERMINEE) {
+        erreur = "partie terminée";
+    }
+    else if (strcmp(commande, "keep") == 0 || strcmp(commande, "roll") == 0) {
+        bool invalide;
+        int masque;
+
+        masque = lire_des_commande(arguments, &invalide);
+        if (invalide) {
+            erreur = "numéro de dé invalide";
+        }
+        else if (!relancer_tour(partie, commande[0] == 'k' ? ~masque & MASQUE_DES : masque)) {
+            erreur = "plus de relance possible";
+        }
+        else if (partie->relances_restantes == 0) {
+            session->etape = ETAPE_COMBINAISON;
+        }
+    }
+    else if (strcmp(commande, "score") == 0) {
+        int joueur;
+        int combinaison;
+        int points;
+
+        joueur = partie->joueur;
+        combinaison = chercher_combinaison(arguments + strspn(arguments, " \t"));
+        points = valider_combinaison(partie, combinaison);
+        if (points == -1) {
+            erreur = "combinaison inconnue ou déjà remplie";
+        }
+        else {
+            longueur = snprintf(reponse, TAILLE_REPONSE_SESSION, "score %d %s %d\n", joueur + 1,
+                                NOMS_COMBINAISONS[combinaison], points);
+            if (partie_terminee(partie)) {
+                int totaux[JOUEURS_SESSION_MAX];
+                int vainqueur;
+
+                vainqueur = trouver_vainqueurs(&partie->feuilles, totaux);
+                longueur = longueur + snprintf(reponse + longueur, TAILLE_REPONSE_SESSION - longueur, "fin");
+                for (int j = 0; j < partie->nombre_joueurs; j++) {
+                    longueur = longueur + snprintf(reponse + longueur, TAILLE_REPONSE_SESSION - longueur, " %d",
+                                                   totaux[j]);
+                }
+                longueur = longueur + snprintf(reponse + longueur, TAILLE_REPONSE_SESSION - longueur,
+                                               " vainqueur %d\n", vainqueur + 1);
+                session->etape = ETAPE_TERMINEE;
+            }
+            else {
+                commencer_tour(partie);
+                session->etape = ETAPE_RELANCE;
+            }
+        }
+    }
+    else {
+        erreur = "commande inconnue";
+    }
+
+    if (erreur != NULL) {
+        longueur = snprintf(reponse, TAILLE_REPONSE_SESSION, "erreur %s\n", erreur);
+    }
+
+    return ecrire_invite(session, reponse, longueur);
+}
+
+/**
+ * @fn bool traiter_entree_session(t_serveur *serveur, t_session *session)
+ * 
+ * @brief Cette fonction exécute les commandes complètes reçues par une session, puis lit la suite
+ * 
+ * @param serveur Le serveur
+ * @param session La session
+ * @return true si la session reste ouverte
+ * @return false si elle a été fermée, par le client ou par la commande quitter
+ * 
+ * S'arrête dès qu'une réponse reste en attente : les commandes suivantes seront exécutées quand elle sera partie.
+ * Une ligne trop longue est refusée et ignorée jusqu'à sa fin.
+ */
+bool traiter_entree_session(t_serveur *serveur, t_session *session) {
+    char reponse[TAILLE_REPONSE_SESSION];
+    ssize_t lus;
+
+    while (session->longueur_attente == 0) {
+        char *fin;
+
+        fin = memchr(session->entree, '\n', session->longueur_entree);
+        if (fin != NULL) {
+            int longueur;
+            int consommes;
+
+            *fin = '\0';
+            consommes = fin - session->entree + 1;
+            if (session->ligne_trop_longue) {
+                session->ligne_trop_longue = false;
+                longueur = -2;
+            }
+            else {
+                longueur = executer_commande_session(serveur, session, session->entree, reponse);
+            }
+            memmove(session->entree, session->entree + consommes, session->longueur_entree - consommes);
+            session->longueur_entree = session->longueur_entree - consommes;
+
+            if (longueur == -1) {
+                fermer_session(serveur, session);
+                return false;
+            }
+            if (longueur >= 0 && !envoyer_session(serveur, session, reponse, longueur)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (session->longueur_entree == TAILLE_ENTREE_SESSION) {
+            int longueur;
+
+            if (!session->ligne_trop_longue) {
+                longueur = snprintf(reponse, TAILLE_REPONSE_SESSION, "erreur commande trop longue\n");
+                if (!envoyer_session(serveur, session, reponse, ecrire_invite(session, reponse, longueur))) {
+                    return false;
+                }
+            }
+            session->ligne_trop_longue = true;
+            session->longueur_entree = 0;
+        }
+
+        lus = recv(session->descripteur, session->entree + session->longueur_entree,
+                   TAILLE_ENTREE_SESSION - session->longueur_entree, MSG_DONTWAIT);
+        if (lus == 0 || (lus < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+            fermer_session(serveur, session);
+            return false;
+        }
+        if (lus < 0) {
+            return true;
+        }
+        session->longueur_entree = session->longueur_entree + lus;
+    }
+
+    return true;
+}
+
+/**
+ * @fn bool vider_attente_session(t_serveur *serveur, t_session *session)
+ * 
+ * @brief Cette fonction envoie la réponse en attente d'une session, puis reprend la lecture de ses commandes
+ * 
+ * @param serveur Le serveur
+ * @param session La session, dont une réponse est en attente
+ * @return true si la session reste ouverte
+ * @return false si elle a été fermée
+ */
+bool vider_attente_session(t_serveur *serveur, t_session *session) {
+    struct epoll_event evenement;
+    ssize_t envoyes;
+
+    envoyes = send(session->descripteur, session->attente, session->longueur_attente, MSG_DONTWAIT | MSG_NOSIGNAL);
+    if (envoyes < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+            return true;
+        }
+        fermer_session(serveur, session);
+        return false;
+    }
+
+    session->longueur_attente = session->longueur_attente - envoyes;
+    memmove(session->attente, session->attente + envoyes, session->longueur_attente);
+    if (session->longueur_attente > 0) {
+        return true;
+    }
+
+    free(session->attente);
+    session->attente = NULL;
+    evenement.events = EPOLLIN | EPOLLRDHUP;
+    evenement.data.ptr = session;
+    epoll_ctl(serveur->epoll, EPOLL_CTL_MOD, session->descripteur, &evenement);
+
+    return traiter_entree_session(serveur, session);
+}
+
+/**
+ * @fn void accepter_sessions(t_serveur *serveur)
+ * 
+ * @brief Cette procédure accepte toutes les connexions en attente et ouvre une session pour chacune
+ * 
+ * @param serveur Le serveur
+ * 
+ * Une connexion acceptée sans mémoire pour sa session est refermée aussitôt. Quand accept échoue faute de
+ * descripteur ou de mémoire, la connexion reste dans la file : la socket d'écoute, surveillée par niveau, serait
+ * signalée sans fin. Elle est donc suspendue jusqu'à la fermeture d'une session, ou au plus une seconde.
+ */
+void accepter_sessions(t_serveur *serveur) {
+    char reponse[TAILLE_REPONSE_SESSION];
+    int descripteur;
+
+    descripteur = accept(serveur->ecoute, NULL, NULL);
+    while (descripteur != -1) {
+        struct epoll_event evenement;
+        t_session *session;
+        int longueur;
+
+        session = calloc(1, sizeof(t_session));
+        if (session == NULL) {
+            close(descripteur);
+            descripteur = accept(serveur->ecoute, NULL, NULL);
+            continue;
+        }
+        fcntl(descripteur, F_SETFL, O_NONBLOCK);
+        fcntl(descripteur, F_SETFD, FD_CLOEXEC);
+        session->descripteur = descripteur;
+        session->etape = ETAPE_SANS_PARTIE;
+
+        evenement.events = EPOLLIN | EPOLLRDHUP;
+        evenement.data.ptr = session;
+        epoll_ctl(serveur->epoll, EPOLL_CTL_ADD, descripteur, &evenement);
+
+        serveur->sessions_ouvertes = serveur->sessions_ouvertes + 1;
+        serveur->sessions_totales = serveur->sessions_totales + 1;
+        if (serveur->sessions_ouvertes > serveur->sessions_max) {
+            serveur->sessions_max = serveur->sessions_ouvertes;
+        }
+
+        longueur = snprintf(reponse, TAILLE_REPONSE_SESSION, "yams %d\n", JOUEURS_SESSION_MAX);
+        envoyer_session(serveur, session, reponse, ecrire_invite(session, reponse, longueur));
+
+        descripteur = accept(serveur->ecoute, NULL, NULL);
+    }
+
+    if (errno == EMFILE || errno == ENFILE || errno == ENOBUFS || errno == ENOMEM) {
+        struct epoll_event evenement;
+
+        evenement.events = 0;
+        evenement.data.ptr = NULL;
+        epoll_ctl(serveur->epoll, EPOLL_CTL_MOD, serveur->ecoute, &evenement);
+        serveur->ecoute_suspendue = true;
+    }
+}
+
+/**
+ * @fn bool servir_parties(const char *chemin, uint64_t graine, t_serveur *serveur)
+ * 
+ * @brief Cette fonction sert des parties sur une socket locale jusqu'à la réception de SIGINT ou SIGTERM
+ * 
+ * @param chemin Le chemin de la socket, remplacée si elle existe déjà
+ * @param graine La graine dont sont tirées les graines des parties sans graine
+ * @param serveur Le serveur, qui contient à la fin le bilan des sessions
+ * @return true si le serveur s'est arrêté sur demande
+ * @return false si la socket n'a pas pu être ouverte
+ * 
+ * Un seul thread sert toutes les sessions : epoll signale celles qui ont reçu des commandes ou peuvent de nouveau
+ * écrire, et chaque commande est exécutée entièrement avant de passer à la suivante, sans jamais attendre un
+ * client. Le coût d'une commande ne dépend donc pas du nombre de sessions ouvertes.
+ */
+bool servir_parties(const char *chemin, uint64_t graine, t_serveur *serveur) {
+    struct sockaddr_un adresse;
+    struct epoll_event evenement;
+    struct epoll_event evenements[64];
+    struct sigaction action;
+
+    if (strlen(chemin) >= sizeof(adresse.sun_path)) {
+        return false;
+    }
+
+    memset(serveur, 0, sizeof(*serveur));
+    initialiser_generateur(&serveur->graines, graine);
+
+    memset(&adresse, 0, sizeof(adresse));
+    adresse.sun_family = AF_UNIX;
+    strcpy(adresse.sun_path, chemin);
+    unlink(chemin);
+
+    serveur->ecoute = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (serveur->ecoute == -1 || bind(serveur->ecoute, (struct sockaddr *) &adresse, sizeof(adresse)) != 0
+        || listen(serveur->ecoute, SOMAXCONN) != 0) {
+        if (serveur->ecoute != -1) {
+            close(serveur->ecoute);
+        }
+        return false;
+    }
+
+    serveur->epoll = epoll_create1(EPOLL_CLOEXEC);
+    evenement.events = EPOLLIN;
+    evenement.data.ptr = NULL;
+    epoll_ctl(serveur->epoll, EPOLL_CTL_ADD, serveur->ecoute, &evenement);
+
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = demander_arret_serveur;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+    ARRET_SERVEUR = 0;
+
+    while (!ARRET_SERVEUR) {
+        int nombre;
+
+        nombre = epoll_wait(serveur->epoll, evenements, 64, serveur->ecoute_suspendue ? 1000 : -1);
+        if (nombre == 0) {
+            reprendre_ecoute(serveur);
+        }
+        for (int i = 0; i < nombre; i++) {
+            t_session *session;
+
+            session = evenements[i].data.ptr;
+            if (session == NULL) {
+                accepter_sessions(serveur);
+            }
+            else if (session->longueur_attente > 0) {
+                if (evenements[i].events & (EPOLLERR | EPOLLHUP)) {
+                    fermer_session(serveur, session);
+                }
+                else {
+                    vider_attente_session(serveur, session);
+                }
+            }
+            else {
+                traiter_entree_session(serveur, session);
+            }
+        }
+    }
+
+    close(serveur->epoll);
+    close(serveur->ecoute);
+    unlink(chemin);
+    return true;
+}
+
+/*********************************
+ *      LIGNE DE COMMANDE        *
+ *********************************/
+
+/**
+ * @brief Le fichier par défaut de la table des espérances de la stratégie optimale
+ * 
+ */
+#define FICHIER_ESPERANCES "yams_esperances.bin"
+
+/**
+ * @fn const double *charger_esperances(const char *chemin, t_table_projetee *table)
+ * 
+ * @brief Cette fonction projette la table des espérances si elle existe
+ * 
+ * @param chemin Le chemin du fichier
+ * @param table La table projetée, dont l'entête vaut NULL si la table n'est pas disponible
+ * @return const double* les espérances, NULL si le fichier est absent ou n'est pas une table des espérances
+ */
+const double *charger_esperances(const char *chemin, t_table_projetee *table) {
+    table->entete = NULL;
+    table->valeurs = NULL;
+    if (!projeter_table(chemin, TABLE_ESPERANCES, sizeof(double), table)) {
+        table->entete = NULL;
+        return NULL;
+    }
+    if (table->entete->nombre_valeurs != NOMBRE_ETATS) {
+        liberer_table(table);
+        table->entete = NULL;
+        return NULL;
+    }
+
+    return table->valeurs;
+}
+
+/**
+ * @brief Le fichier par défaut de la table des probabilités de seuil
+ * 
+ */
+#define FICHIER_SEUILS "yams_seuils.bin"
+
+/**
+ * @fn const float *charger_seuils(const char *chemin, t_table_projetee *table)
+ * 
+ * @brief Cette fonction projette la table des probabilités de seuil si elle existe
+ * 
+ * @param chemin Le chemin du fichier
+ * @param table La table projetée, dont l'entête vaut NULL si la table n'est pas disponible
+ * @return const float* les vecteurs des états, placés par initialiser_vecteurs, NULL si le fichier est absent ou
+ * n'est pas une table des seuils
+ */
+const float *charger_seuils(const char *chemin, t_table_projetee *table) {
+    uint32_t blocs;
+
+    blocs = initialiser_vecteurs();
+    table->entete = NULL;
+    table->valeurs = NULL;
+    if (!projeter_table(chemin, TABLE_SEUILS, sizeof(float), table)) {
+        table->entete = NULL;
+        return NULL;
+    }
+    if (table->entete->nombre_valeurs != (uint64_t) blocs * PROBABILITES_PAR_VECTEUR) {
+        liberer_table(table);
+        table->entete = NULL;
+        return NULL;
+    }
+
+    return table->valeurs;
+}
+
+/**
+ * @brief Le fichier par défaut des tables des finales à deux joueurs
+ * 
+ */
+#define FICHIER_FINALES "yams_finales.bin"
+
+/**
+ * @fn bool charger_finales(const char *chemin, t_table_projetee *table, t_finales *finales)
+ * 
+ * @brief Cette fonction projette les tables des finales si elles existent
+ * 
+ * @param chemin Le chemin du fichier
+ * @param table La table projetée, à libérer avec liberer_table
+ * @param finales Reçoit les tables, qui se lisent directement dans le fichier
+ * @return true si les tables sont disponibles
+ * @return false si le fichier est absent ou n'est pas une table des finales complète
+ */
+bool charger_finales(const char *chemin, t_table_projetee *table, t_finales *finales) {
+    initialiser_classes_finales();
+    if (!projeter_table(chemin, TABLE_FINALES, sizeof(uint16_t), table)) {
+        return false;
+    }
+    if (!placer_finales(finales, table->valeurs, table->entete->nombre_valeurs)) {
+        liberer_table(table);
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @fn bool charger_strategie_seuil(const char *nom, t_strategie *strategie)
+ * 
+ * @brief Cette fonction prépare la stratégie qui maximise la probabilité d'atteindre un score
+ * 
+ * @param nom Le nom de la stratégie, seuil-N pour viser au moins N points
+ * @param strategie Reçoit la stratégie
+ * @return true si le nom est valide et la table des seuils disponible
+ * @return false sinon, le message d'erreur étant affiché si la table manque
+ * 
+ * La table reste projetée jusqu'à la fin du programme
+ */
+bool charger_strategie_seuil(const char *nom, t_strategie *strategie) {
+    t_table_projetee table;
+    t_contexte_seuil *contexte;
+    const float *seuils;
+    char *fin;
+    long seuil;
+
+    if (strncmp(nom, "seuil-", 6) != 0) {
+        return false;
+    }
+    errno = 0;
+    seuil = strtol(nom + 6, &fin, 10);
+    if (fin == nom + 6 || *fin != '\0' || errno != 0 || seuil <= 0 || seuil > INT32_MAX) {
+        return false;
+    }
+
+    seuils = charger_seuils(FICHIER_SEUILS, &table);
+    if (seuils == NULL) {
+        fprintf(stderr, "Impossible de lire la table des seuils, lancez d'abord le mode resoudre-seuils\n");
+        return false;
+    }
+
+    contexte = malloc(sizeof(t_contexte_seuil));
+    if (contexte == NULL) {
+        liberer_table(&table);
+        return false;
+    }
+    contexte->seuils = seuils;
+    contexte->seuil = seuil;
+    contexte->etat = -1;
+
+    strategie->nom = nom;
+    strategie->choisir_relance = seuil_choisir_relance;
+    strategie->choisir_combinaison = seuil_choisir_combinaison;
+    strategie->contexte = contexte;
+    strategie->creer_contexte = creer_contexte_seuil;
+    strategie->detruire_contexte = free;
+    strategie->choisir_relances = NULL;
+    strategie->choisir_combinaisons = NULL;
+
+    return true;
+}
+
+/**
+ * @fn int chercher_strategie(t_strategie *strategies, int *nombre_strategies, const char *nom)
+ * 
+ * @brief Cette fonction cherche une stratégie enregistrée par son nom, ou charge une stratégie externe
+ * 
+ * @param strategies Les stratégies enregistrées, NOMBRE_STRATEGIES_MAX places
+ * @param nombre_strategies Le nombre de stratégies, augmenté si une stratégie externe est chargée
+ * @param nom Le nom cherché, le chemin d'une bibliothèque partagée s'il contient un « / » ou se termine par
+ * « .so », seuil-N pour la stratégie qui maximise la probabilité de marquer au moins N points, ou memo-nom pour la
+ * stratégie nom dont les décisions passent par un cache partagé (le préfixe est retiré avant toute autre
+ * recherche, et memo-seuil-N est refusée : la clé du cache ne retient pas le total de la feuille)
+ * @return int l'indice de la stratégie, -1 si aucune stratégie ne porte ce nom
+ */
+int chercher_strategie(t_strategie *strategies, int *nombre_strategies, const char *nom) {
+    size_t longueur;
+
+    for (int i = 0; i < *nombre_strategies; i++) {
+        if (strcmp(strategies[i].nom, nom) == 0) {
+            return i;
+        }
+    }
+
+    if (strncmp(nom, "memo-", 5) == 0) {
+        int interne;
+
+        if (strncmp(nom + 5, "seuil-", 6) == 0) {
+            fprintf(stderr, "%s dépend du total de la feuille et ne peut pas passer par le cache\n", nom + 5);
+            return -1;
+        }
+        interne = chercher_strategie(strategies, nombre_strategies, nom + 5);
+        if (interne == -1 || *nombre_strategies >= NOMBRE_STRATEGIES_MAX) {
+            return -1;
+        }
+        if (!mettre_en_cache(&strategies[interne], nom, &strategies[*nombre_strategies])) {
+            fprintf(stderr, "Mémoire insuffisante pour le cache de %s\n", nom + 5);
+            return -1;
+        }
+        *nombre_strategies = *nombre_strategies + 1;
+        return *nombre_strategies - 1;
+    }
+
+    longueur = strlen(nom);
+    if ((strchr(nom, '/') != NULL || (longueur > 3 && strcmp(nom + longueur - 3, ".so") == 0))
+        && *nombre_strategies < NOMBRE_STRATEGIES_MAX && charger_module(nom, &strategies[*nombre_strategies])) {
+        *nombre_strategies = *nombre_strategies + 1;
+        return *nombre_strategies - 1;
+    }
+    if (*nombre_strategies < NOMBRE_STRATEGIES_MAX && charger_strategie_seuil(nom, &strategies[*nombre_strategies])) {
+        *nombre_strategies = *nombre_strategies + 1;
+        return *nombre_strategies - 1;
+    }
+
+    return -1;
+}
+
+/**
+ * @fn int mode_simuler(int argc, char *argv[])
+ * 
+ * @brief Cette fonction lance une série de parties simulées depuis la ligne de commande
+ * 
+ * @param argc Le nombre d'arguments
+ * @param argv Les arguments : simuler [nombre de parties] [graine] [stratégie] [fichier des espérances]
+ * @return int le code de retour du programme
+ */
+int mode_simuler(int argc, char *argv[]) {
+    t_resultats resultats;
+    t_strategie strategies[NOMBRE_STRATEGIES_MAX];
+    t_table_projetee esperances;
+    int nombre_strategies;
+    int choisie;
+    long nombre;
+    uint64_t graine;
+    double debut;
+    double duree;
+
+    nombre = 1000000;
+    graine = time(NULL);
+
+    if (argc > 2) {
+        nombre = atol(argv[2]);
+    }
+    if (argc > 3) {
+        graine = strtoull(argv[3], NULL, 10);
+    }
+    if (nombre <= 0) {
+        fprintf(stderr, "Nombre de parties invalide : %s\n", argv[2]);
+        return EXIT_FAILURE;
+    }
+
+    charger_esperances(argc > 5 ? argv[5] : FICHIER_ESPERANCES, &esperances);
+    nombre_strategies = enregistrer_strategies(strategies, esperances.valeurs);
+    choisie = chercher_strategie(strategies, &nombre_strategies, argc > 4 ? argv[4] : "glouton");
+    if (choisie == -1 && argc > 4 && strcmp(argv[4], "optimal") == 0) {
+        fprintf(stderr, "Impossible de lire la table des espérances, lancez d'abord le mode resoudre\n");
+        return EXIT_FAILURE;
+    }
+    if (choisie == -1) {
+        fprintf(stderr, "Stratégie inconnue : %s\n", argv[4]);
+        return EXIT_FAILURE;
+    }
+
+    debut = secondes_ecoulees();
+    if (!simuler_parties(nombre, &strategies[choisie], graine, &resultats)) {
+        fprintf(stderr, "Mémoire insuffisante pour instancier la stratégie %s\n", strategies[choisie].nom);
+        return EXIT_FAILURE;
+    }
+    duree = secondes_ecoulees() - debut;
+
+    printf("Stratégie     : %s\n", strategies[choisie].nom);
+    printf("Graine        : %llu\n", (unsigned long long) graine);
+    printf("Parties       : %ld\n", resultats.nombre_parties);
+    printf("Score moyen   : %.2f\n", (double) resultats.somme_scores / resultats.nombre_parties);
+    printf("Score min/max : %d / %d\n", resultats.score_min, resultats.score_max);
+    printf("Taux de bonus : %.2f %%\n", 100.0 * resultats.nombre_bonus / resultats.nombre_parties);
+    printf("Taux de Yams  : %.2f %%\n", 100.0 * resultats.nombre_yams / resultats.nombre_parties);
+    printf("Durée         : %.3f s (%.0f parties/s)\n", duree, resultats.nombre_parties / duree);
+    afficher_cache_strategie(stdout, &strategies[choisie]);
+
+    if (esperances.entete != NULL) {
+        liberer_table(&esperances);
+    }
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @fn int mode_statistiques(int argc, char *argv[])
+ * 
+ * @brief Cette fonction lance une série de parties sur plusieurs threads et écrit le rapport de leurs statistiques
+ * 
+ * @param argc Le nombre d'arguments
+ * @param argv Les arguments : statistiques [parties] [graine] [stratégie] [threads] [json|csv] [fichier|-]
+ * @return int le code de retour du programme
+ * 
+ * La progression est affichée chaque seconde sur la sortie d'erreur. Avec la même graine, les résultats sont
+ * ceux du mode simuler, quel que soit le nombre de threads
+ */
+int mode_statistiques(int argc, char *argv[]) {
+    t_resultats resultats;
+    t_strategie strategies[NOMBRE_STRATEGIES_MAX];
+    t_table_projetee esperances;
+    FILE *fichier;
+    bool csv;
+    bool reussite;
+    int nombre_strategies;
+    int choisie;
+    int nombre_threads;
+    long nombre;
+    uint64_t graine;
+    double debut;
+    double duree;
+
+    nombre = argc > 2 ? atol(argv[2]) : 1000000;
+    graine = argc > 3 ? strtoull(argv[3], NULL, 10) : (uint64_t) time(NULL);
+    nombre_threads = argc > 5 ? atoi(argv[5]) : sysconf(_SC_NPROCESSORS_ONLN);
+    csv = argc > 6 && strcmp(argv[6], "csv") == 0;
+    if (nombre <= 0) {
+        fprintf(stderr, "Nombre de parties invalide : %s\n", argv[2]);
+        return EXIT_FAILURE;
+    }
+    if (nombre_threads <= 0) {
+        fprintf(stderr, "Nombre de threads invalide : %s\n", argv[5]);
+        return EXIT_FAILURE;
+    }
+    if (argc > 6 && !csv && strcmp(argv[6], "json") != 0) {
+        fprintf(stderr, "Format inconnu : %s\n", argv[6]);
+        return EXIT_FAILURE;
+    }
+
+    charger_esperances(FICHIER_ESPERANCES, &esperances);
+    nombre_strategies = enregistrer_strategies(strategies, esperances.valeurs);
+    choisie = chercher_strategie(strategies, &nombre_strategies, argc > 4 ? argv[4] : "glouton");
+    if (choisie == -1) {
+        fprintf(stderr, "Stratégie inconnue : %s\n", argv[4]);
+        return EXIT_FAILURE;
+    }
+
+    fichier = stdout;
+    if (argc > 7 && strcmp(argv[7], "-") != 0) {
+        fichier = fopen(argv[7], "w");
+        if (fichier == NULL) {
+            fprintf(stderr, "Impossible d'écrire %s\n", argv[7]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    debut = secondes_ecoulees();
+    reussite = simuler_parties_paralleles(nombre, &strategies[choisie], graine, nombre_threads, true, &resultats);
+    duree = secondes_ecoulees() - debut;
+
+    if (!reussite) {
+        fprintf(stderr, "Mémoire insuffisante pour jouer les parties\n");
+    }
+    else if (csv) {
+        ecrire_rapport_csv(fichier, strategies[choisie].nom, graine, duree, &resultats);
+    }
+    else {
+        ecrire_rapport_json(fichier, strategies[choisie].nom, graine, duree, &resultats);
+    }
+    if (fichier != stdout) {
+        fclose(fichier);
+    }
+    afficher_cache_strategie(stderr, &strategies[choisie]);
+
+    if (esperances.entete != NULL) {
+        liberer_table(&esperances);
+    }
+    return reussite ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**
+ * @fn int mode_repartir(int argc, char *argv[])
+ * 
+ * @brief Cette fonction lance une série de parties répartie entre plusieurs processus et écrit son rapport
+ * 
+ * @param argc Le nombre d'arguments
+ * @param argv Les arguments : repartir [parties] [graine] [stratégie] [processus] [threads] [dossier|-] [json|csv]
+ * [fichier|-]
+ * @return int le code de retour du programme
+ * 
+ * Destiné aux très longues simulations : avec un dossier de reprise, une simulation interrompue se relance avec
+ * les mêmes arguments et ne rejoue que les blocs qui n'avaient pas été enregistrés. Les résultats sont ceux des
+ * modes simuler et statistiques avec la même graine, quels que soient le nombre de processus et les reprises
+ */
+int mode_repartir(int argc, char *argv[]) {
+    t_resultats resultats;
+    t_strategie strategies[NOMBRE_STRATEGIES_MAX];
+    t_table_projetee esperances;
+    t_simulation_processus simulation;
+    FILE *fichier;
+    bool csv;
+    bool reussite;
+    int nombre_strategies;
+    int choisie;
+    double debut;
+    double duree;
+
+    simulation.nombre = argc > 2 ? atol(argv[2]) : 1000000;
+    simulation.graine = argc > 3 ? strtoull(argv[3], NULL, 10) : (uint64_t) time(NULL);
+    simulation.nombre_fragments = argc > 5 ? atoi(argv[5]) : sysconf(_SC_NPROCESSORS_ONLN);
+    simulation.nombre_threads = argc > 6 ? atoi(argv[6]) : 1;
+    simulation.dossier = argc > 7 && strcmp(argv[7], "-") != 0 ? argv[7] : NULL;
+    simulation.fragments = NULL;
+    csv = argc > 8 && strcmp(argv[8], "csv") == 0;
+    if (simulation.nombre <= 0) {
+        fprintf(stderr, "Nombre de parties invalide : %s\n", argv[2]);
+        return EXIT_FAILURE;
+    }
+    if (simulation.nombre_fragments <= 0) {
+        fprintf(stderr, "Nombre de processus invalide : %s\n", argv[5]);
+        return EXIT_FAILURE;
+    }
+    if (simulation.nombre_threads <= 0) {
+        fprintf(stderr, "Nombre de threads invalide : %s\n", argv[6]);
+        return EXIT_FAILURE;
+    }
+    if (argc > 8 && !csv && strcmp(argv[8], "json") != 0) {
+        fprintf(stderr, "Format inconnu : %s\n", argv[8]);
+        return EXIT_FAILURE;
+    }
+    if (simulation.dossier != NULL && mkdir(simulation.dossier, 0755) != 0 && errno != EEXIST) {
+        fprintf(stderr, "Impossible de créer le dossier de reprise %s\n", simulation.dossier);
+        return EXIT_FAILURE;
+    }
+
+    charger_esperances(FICHIER_ESPERANCES, &esperances);
+    nombre_strategies = enregistrer_strategies(strategies, esperances.valeurs);
+    choisie = chercher_strategie(strategies, &nombre_strategies, argc > 4 ? argv[4] : "glouton");
+    if (choisie == -1) {
+        fprintf(stderr, "Stratégie inconnue : %s\n", argv[4]);
+        return EXIT_FAILURE;
+    }
+    simulation.strategie = &strategies[choisie];
+
+    fichier = stdout;
+    if (argc > 9 && strcmp(argv[9], "-") != 0) {
+        fichier = fopen(argv[9], "w");
+        if (fichier == NULL) {
+            fprintf(stderr, "Impossible d'écrire %s\n", argv[9]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    debut = secondes_ecoulees();
+    reussite = simuler_parties_processus(&simulation, true, &resultats);
+    duree = secondes_ecoulees() - debut;
+
+    if (reussite && csv) {
+        ecrire_rapport_csv(fichier, strategies[choisie].nom, simulation.graine, duree, &resultats);
+    }
+    else if (reussite) {
+        ecrire_rapport_json(fichier, strategies[choisie].nom, simulation.graine, duree, &resultats);
+    }
+    if (fichier != stdout) {
+        fclose(fichier);
+    }
+
+    if (esperances.entete != NULL) {
+        liberer_table(&esperances);
+    }
+    return reussite ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**
+ * @fn int mode_tournoi(int argc, char *argv[])
+ * 
+ * @brief Cette fonction fait s'affronter les stratégies enregistrées en parties à deux joueurs
+ * 
+ * @param argc Le nombre d'arguments
+ * @param argv Les arguments : tournoi [parties par rencontre] [graine] [ronde|suisse] [threads] [rondes]
+ * @return int le code de retour du programme
+ * 
+ * En ronde, chaque stratégie rencontre toutes les autres. En suisse, les rondes sont jouées l'une après l'autre
+ * et chaque ronde apparie les stratégies de points voisins ; une stratégie exempte marque une rencontre gagnée,
+ * qui compte pour l'appariement et le classement mais pas dans ses parties jouées. Le classement, du plus grand
+ * nombre de points au plus petit, donne le taux de points de chaque stratégie sur les seules parties qu'elle a
+ * jouées, une victoire valant 1 et un nul 1/2, et son nombre d'exemptions
+ */
+int mode_tournoi(int argc, char *argv[]) {
+    t_strategie strategies[NOMBRE_STRATEGIES_MAX];
+    t_rencontre rencontres[NOMBRE_STRATEGIES_MAX * NOMBRE_STRATEGIES_MAX / 2];
+    bool deja_joue[NOMBRE_STRATEGIES_MAX * NOMBRE_STRATEGIES_MAX];
+    double points[NOMBRE_STRATEGIES_MAX];
+    double points_classement[NOMBRE_STRATEGIES_MAX];
+    long parties_jouees[NOMBRE_STRATEGIES_MAX];
+    int exemptions[NOMBRE_STRATEGIES_MAX];
+    int classement[NOMBRE_STRATEGIES_MAX];
+    t_table_projetee esperances;
+    t_generateur generateur;
+    int nombre_strategies;
+    int nombre_rencontres;
+    int exempte;
+    int nombre_threads;
+    int rondes;
+    bool suisse;
+    long parties;
+    long total_parties;
+    uint64_t graine;
+    double debut;
+    double duree;
+
+    parties = argc > 2 ? atol(argv[2]) : 100000;
+    graine = argc > 3 ? strtoull(argv[3], NULL, 10) : (uint64_t) time(NULL);
+    suisse = argc > 4 && strcmp(argv[4], "suisse") == 0;
+    nombre_threads = argc > 5 ? atoi(argv[5]) : sysconf(_SC_NPROCESSORS_ONLN);
+    rondes = argc > 6 ? atoi(argv[6]) : 3;
+    if (parties <= 0 || rondes <= 0) {
+        fprintf(stderr, "Nombre de parties ou de rondes invalide\n");
+        return EXIT_FAILURE;
+    }
+    if (argc > 4 && !suisse && strcmp(argv[4], "ronde") != 0) {
+        fprintf(stderr, "Format de tournoi inconnu : %s\n", argv[4]);
+        return EXIT_FAILURE;
+    }
+    if (nombre_threads <= 0) {
+        nombre_threads = 1;
+    }
+
+    charger_esperances(FICHIER_ESPERANCES, &esperances);
+    nombre_strategies = enregistrer_strategies(strategies, esperances.valeurs);
+    initialiser_generateur(&generateur, graine);
+    memset(deja_joue, 0, sizeof(deja_joue));
+    for (int i = 0; i < nombre_strategies; i++) {
+        points[i] = 0.0;
+        points_classement[i] = 0.0;
+        parties_jouees[i] = 0;
+        exemptions[i] = 0;
+    }
+
+    printf("Tournoi %s, %d stratégies, %ld parties par rencontre, graine %llu, %d threads\n",
+           suisse ? "suisse" : "en ronde", nombre_strategies, parties, (unsigned long long) graine, nombre_threads);
+
+    total_parties = 0;
+    debut = secondes_ecoulees();
+    for (int ronde = 0; ronde < (suisse ? rondes : 1); ronde++) {
+        exempte = -1;
+        if (suisse) {
+            nombre_rencontres = apparier_suisse(points_classement, deja_joue, nombre_strategies, rencontres, &exempte);
+            printf("\nRonde %d\n", ronde + 1);
+        }
+        else {
+            nombre_rencontres = 0;
+            for (int a = 0; a < nombre_strategies; a++) {
+                for (int b = a + 1; b < nombre_strategies; b++) {
+                    rencontres[nombre_rencontres].strategie_a = a;
+                    rencontres[nombre_rencontres].strategie_b = b;
+                    rencontres[nombre_rencontres].victoires = 0;
+                    rencontres[nombre_rencontres].nuls = 0;
+                    rencontres[nombre_rencontres].defaites = 0;
+                    nombre_rencontres = nombre_rencontres + 1;
+                }
+            }
+        }
+
+        if (!jouer_rencontres(strategies, rencontres, nombre_rencontres, parties, &generateur, nombre_threads)) {
+            fprintf(stderr, "Mémoire insuffisante pour jouer la ronde %d\n", ronde + 1);
+            if (esperances.entete != NULL) {
+                liberer_table(&esperances);
+            }
+            return EXIT_FAILURE;
+        }
+
+        for (int r = 0; r < nombre_rencontres; r++) {
+            t_rencontre *rencontre;
+
+            rencontre = &rencontres[r];
+            afficher_rencontre(strategies, rencontre);
+            points[rencontre->strategie_a] += rencontre->victoires + 0.5 * rencontre->nuls;
+            points[rencontre->strategie_b] += rencontre->defaites + 0.5 * rencontre->nuls;
+            points_classement[rencontre->strategie_a] += rencontre->victoires + 0.5 * rencontre->nuls;
+            points_classement[rencontre->strategie_b] += rencontre->defaites + 0.5 * rencontre->nuls;
+            parties_jouees[rencontre->strategie_a] += parties;
+            parties_jouees[rencontre->strategie_b] += parties;
+            total_parties = total_parties + parties;
+        }
+        if (exempte != -1) {
+            printf("%-12s : exempte, rencontre gagnée\n", strategies[exempte].nom);
+            points_classement[exempte] += parties;
+            exemptions[exempte] = exemptions[exempte] + 1;
+        }
+    }
+    duree = secondes_ecoulees() - debut;
+
+    for (int i = 0; i < nombre_strategies; i++) {
+        int j;
+
+        j = i;
+        while (j > 0 && points_classement[classement[j - 1]] < points_classement[i]) {
+            classement[j] = classement[j - 1];
+            j = j - 1;
+        }
+        classement[j] = i;
+    }
+
+    printf("\nClassement\n");
+    for (int k = 0; k < nombre_strategies; k++) {
+        double bas;
+        double haut;
+        int i;
+
+        i = classement[k];
+        if (parties_jouees[i] == 0) {
+            printf("%-12s : %3d exemptions, aucune partie jouée\n", strategies[i].nom, exemptions[i]);
+            continue;
+        }
+        intervalle_wilson(points[i], parties_jouees[i], &bas, &haut);
+        printf("%-12s : %12.1f points / %10ld parties %3d exemptions   taux %.4f [%.4f ; %.4f]\n",
+               strategies[i].nom, points[i], parties_jouees[i], exemptions[i], points[i] / parties_jouees[i],
+               bas, haut);
+    }
+    printf("Durée : %.3f s (%.0f parties/s)\n", duree, total_parties / duree);
+
+    if (esperances.entete != NULL) {
+        liberer_table(&esperances);
+    }
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @fn int mode_tablee(int argc, char *argv[])
+ * 
+ * @brief Cette fonction simule des parties à un nombre quelconque de joueurs
+ * 
+ * @param argc Le nombre d'arguments
+ * @param argv Les arguments : tablee [joueurs] [parties] [graine] [stratégies séparées par des virgules]
+ * @return int le code de retour du programme
+ * 
+ * Les stratégies sont attribuées aux places à tour de rôle. La place de départ donnant un léger avantage,
+ * le tableau des victoires est donné par place et par stratégie
+ */
+int mode_tablee(int argc, char *argv[]) {
+    t_strategie strategies[NOMBRE_STRATEGIES_MAX];
+    t_strategie instances[NOMBRE_STRATEGIES_MAX];
+    t_strategie **places;
+    t_table_projetee esperances;
+    t_generateur flux;
+    t_partie partie;
+    char liste[256];
+    int choisies[NOMBRE_STRATEGIES_MAX];
+    int nombre_choisies;
+    int nombre_strategies;
+    int nombre_joueurs;
+    int *cases;
+    t_etat_joueur *etats;
+    int *totaux;
+    double *victoires;
+    long nombre;
+    long somme_vainqueurs;
+    long somme_totaux;
+    uint64_t graine;
+    double debut;
+    double duree;
+
+    nombre_joueurs = argc > 2 ? atoi(argv[2]) : 8;
+    nombre = argc > 3 ? atol(argv[3]) : 10000;
+    graine = argc > 4 ? strtoull(argv[4], NULL, 10) : (uint64_t) time(NULL);
+    if (nombre_joueurs <= 0 || nombre <= 0) {
+        fprintf(stderr, "Nombre de joueurs ou de parties invalide\n");
+        return EXIT_FAILURE;
+    }
+
+    charger_esperances(FICHIER_ESPERANCES, &esperances);
+    nombre_strategies = enregistrer_strategies(strategies, esperances.valeurs);
+
+    snprintf(liste, sizeof(liste), "%s", argc > 5 ? argv[5] : "glouton");
+    nombre_choisies = 0;
+    for (char *nom = strtok(liste, ","); nom != NULL && nombre_choisies < NOMBRE_STRATEGIES_MAX; nom = strtok(NULL, ",")) {
+        choisies[nombre_choisies] = chercher_strategie(strategies, &nombre_strategies, nom);
+        if (choisies[nombre_choisies] == -1) {
+            fprintf(stderr, "Stratégie inconnue : %s\n", nom);
+            return EXIT_FAILURE;
+        }
+        if (!instancier_strategie(&strategies[choisies[nombre_choisies]], &instances[nombre_choisies])) {
+            fprintf(stderr, "Mémoire insuffisante pour instancier la stratégie %s\n", nom);
+            for (int i = 0; i < nombre_choisies; i++) {
+                liberer_instance(&instances[i]);
+            }
+            return EXIT_FAILURE;
+        }
+        nombre_choisies = nombre_choisies + 1;
+    }
+
+    places = malloc(nombre_joueurs * sizeof(t_strategie *));
+    cases = malloc(TAILLE_FEUILLES(nombre_joueurs) * sizeof(int));
+    etats = malloc(nombre_joueurs * sizeof(t_etat_joueur));
+    totaux = malloc(nombre_joueurs * sizeof(int));
+    victoires = calloc(nombre_joueurs, sizeof(double));
+    for (int j = 0; j < nombre_joueurs; j++) {
+        places[j] = &instances[j % nombre_choisies];
+    }
+
+    somme_vainqueurs = 0;
+    somme_totaux = 0;
+    initialiser_generateur(&flux, graine);
+    debut = secondes_ecoulees();
+    for (long p = 0; p < nombre; p++) {
+        if (p % PARTIES_PAR_FLUX == 0) {
+            partie.generateur = flux;
+            sauter_generateur(&flux);
+        }
+        initialiser_partie(&partie, nombre_joueurs, cases, etats);
+        somme_vainqueurs = somme_vainqueurs + jouer_tablee(places, &partie, totaux, victoires);
+        for (int j = 0; j < nombre_joueurs; j++) {
+            somme_totaux = somme_totaux + totaux[j];
+        }
+    }
+    duree = secondes_ecoulees() - debut;
+
+    printf("Tablée de %d joueurs, %ld parties, graine %llu\n", nombre_joueurs, nombre, (unsigned long long) graine);
+    printf("Total moyen          : %.2f\n", (double) somme_totaux / ((double) nombre * nombre_joueurs));
+    printf("Total moyen gagnant  : %.2f\n", (double) somme_vainqueurs / nombre);
+    for (int j = 0; j < nombre_joueurs; j++) {
+        printf("Place %3d %-12s : %6.2f %% de victoires\n", j + 1, places[j]->nom, 100.0 * victoires[j] / nombre);
+    }
+    printf("Durée                : %.3f s (%.0f parties/s)\n", duree, nombre / duree);
+
+    for (int i = 0; i < nombre_choisies; i++) {
+        liberer_instance(&instances[i]);
+    }
+    free(victoires);
+    free(totaux);
+    free(etats);
+    free(cases);
+    free(places);
+    if (esperances.entete != NULL) {
+        liberer_table(&esperances);
+    }
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @fn int mode_script(int argc, char *argv[])
+ * 
+ * @brief Cette fonction rejoue des parties scriptées lues dans un fichier ou sur l'entrée standard
+ * 
+ * @param argc Le nombre d'arguments
+ * @param argv Les arguments : script [fichier|-] [verbeux]
+ * @return int le code de retour du programme, un échec si une commande a été refusée
+ * 
+ * Écrit une ligne par partie terminée sur la sortie standard, et le bilan sur la sortie d'erreur
+ */
+int mode_script(int argc, char *argv[]) {
+    static char tampon_entree[1 << 16];
+    static char tampon_sortie[1 << 16];
+    t_interpreteur interpreteur;
+    char ligne[TAILLE_LIGNE];
+    FILE *entree;
+    double debut;
+    double duree;
+
+    entree = stdin;
+    if (argc > 2 && strcmp(argv[2], "-") != 0) {
+        entree = fopen(argv[2], "r");
+        if (entree == NULL) {
+            fprintf(stderr, "Impossible d'ouvrir %s\n", argv[2]);
+            return EXIT_FAILURE;
+        }
+    }
+    setvbuf(entree, tampon_entree, _IOFBF, sizeof(tampon_entree));
+    setvbuf(stdout, tampon_sortie, _IOFBF, sizeof(tampon_sortie));
+
+    memset(&interpreteur, 0, sizeof(interpreteur));
+    interpreteur.verbeux = argc > 3 && strcmp(argv[3], "verbeux") == 0;
+    interpreteur.sortie = stdout;
+
+    debut = secondes_ecoulees();
+    while (lire_ligne(entree, ligne, sizeof(ligne))) {
+        interpreteur.numero_ligne = interpreteur.numero_ligne + 1;
+        executer_commande(&interpreteur, ligne);
+    }
+    duree = secondes_ecoulees() - debut;
+    fflush(stdout);
+
+    if (interpreteur.en_cours) {
+        signaler_erreur(&interpreteur, "la dernière partie n'est pas terminée");
+    }
+    fprintf(stderr, "%ld parties, %ld commandes, %ld erreurs en %.3f s (%.0f commandes/s)\n",
+            interpreteur.numero_partie, interpreteur.nombre_commandes, interpreteur.nombre_erreurs, duree,
+            interpreteur.nombre_commandes / duree);
+
+    free(interpreteur.cases);
+    free(interpreteur.etats);
+    free(interpreteur.totaux);
+    if (entree != stdin) {
+        fclose(entree);
+    }
+    return interpreteur.nombre_erreurs == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**
+ * @fn int mode_enregistrer(int argc, char *argv[])
+ * 
+ * @brief Cette fonction écrit sur la sortie standard le script de parties jouées par une stratégie
+ * 
+ * @param argc Le nombre d'arguments
+ * @param argv Les arguments : enregistrer [parties] [graine] [stratégie] [joueurs]
+ * @return int le code de retour du programme
+ */
+int mode_enregistrer(int argc, char *argv[]) {
+    static char tampon_sortie[1 << 16];
+    t_strategie strategies[NOMBRE_STRATEGIES_MAX];
+    t_table_projetee esperances;
+    int nombre_strategies;
+    int choisie;
+    int nombre_joueurs;
+    long nombre;
+    uint64_t graine;
+    bool reussite;
+
+    nombre = argc > 2 ? atol(argv[2]) : 1000;
+    graine = argc > 3 ? strtoull(argv[3], NULL, 10) : (uint64_t) time(NULL);
+    nombre_joueurs = argc > 5 ? atoi(argv[5]) : NOMBRE_JOUEURS;
+    if (nombre <= 0 || nombre_joueurs <= 0) {
+        fprintf(stderr, "Nombre de parties ou de joueurs invalide\n");
+        return EXIT_FAILURE;
+    }
+
+    charger_esperances(FICHIER_ESPERANCES, &esperances);
+    nombre_strategies = enregistrer_strategies(strategies, esperances.valeurs);
+    choisie = chercher_strategie(strategies, &nombre_strategies, argc > 4 ? argv[4] : "glouton");
+    if (choisie == -1) {
+        fprintf(stderr, "Stratégie inconnue : %s\n", argv[4]);
+        return EXIT_FAILURE;
+    }
+
+    setvbuf(stdout, tampon_sortie, _IOFBF, sizeof(tampon_sortie));
+    reussite = enregistrer_parties(stdout, &strategies[choisie], nombre, graine, nombre_joueurs);
+    fflush(stdout);
+    if (!reussite) {
+        fprintf(stderr, "Mémoire insuffisante pour enregistrer les parties\n");
+    }
+
+    if (esperances.entete != NULL) {
+        liberer_table(&esperances);
+    }
+    return reussite ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**
+ * @brief Le fichier par défaut du journal des parties
+ * 
+ */
+#define FICHIER_JOURNAL "yams_parties.log"
+
+/**
+ * @fn int mode_journaliser(int argc, char *argv[])
+ * 
+ * @brief Cette fonction simule des parties et écrit chaque lancer, relance et combinaison dans un journal
+ * 
+ * @param argc Le nombre d'arguments
+ * @param argv Les arguments : journaliser [parties] [graine] [stratégie] [joueurs] [fichier|-]
+ * @return int le code de retour du programme
+ */
+int mode_journaliser(int argc, char *argv[]) {
+    t_strategie strategies[NOMBRE_STRATEGIES_MAX];
+    t_strategie instance;
+    t_table_projetee esperances;
+    t_journal journal;
+    t_generateur flux;
+    t_partie partie;
+    t_tour_journal tour;
+    const char *chemin;
+    int *cases;
+    t_etat_joueur *etats;
+    int *totaux;
+    int nombre_strategies;
+    int choisie;
+    int nombre_joueurs;
+    long nombre;
+    uint64_t graine;
+    double debut;
+    double duree;
+
+    nombre = argc > 2 ? atol(argv[2]) : 1000000;
+    graine = argc > 3 ? strtoull(argv[3], NULL, 10) : (uint64_t) time(NULL);
+    nombre_joueurs = argc > 5 ? atoi(argv[5]) : 1;
+    chemin = argc > 6 ? argv[6] : FICHIER_JOURNAL;
+    if (nombre <= 0 || nombre_joueurs <= 0) {
+        fprintf(stderr, "Nombre de parties ou de joueurs invalide\n");
+        return EXIT_FAILURE;
+    }
+
+    charger_esperances(FICHIER_ESPERANCES, &esperances);
+    nombre_strategies = enregistrer_strategies(strategies, esperances.valeurs);
+    choisie = chercher_strategie(strategies, &nombre_strategies, argc > 4 ? argv[4] : "glouton");
+    if (choisie == -1) {
+        fprintf(stderr, "Stratégie inconnue : %s\n", argv[4]);
+        return EXIT_FAILURE;
+    }
+    if (!instancier_strategie(&strategies[choisie], &instance)) {
+        fprintf(stderr, "Mémoire insuffisante pour instancier la stratégie %s\n", strategies[choisie].nom);
+        return EXIT_FAILURE;
+    }
+    if (!ouvrir_journal(&journal, chemin)) {
+        fprintf(stderr, "Impossible de créer %s\n", chemin);
+        liberer_instance(&instance);
+        return EXIT_FAILURE;
+    }
+
+    cases = malloc(TAILLE_FEUILLES(nombre_joueurs) * sizeof(int));
+    etats = malloc(nombre_joueurs * sizeof(t_etat_joueur));
+    totaux = malloc(nombre_joueurs * sizeof(int));
+    initialiser_generateur(&flux, graine);
+
+    debut = secondes_ecoulees();
+    for (long p = 0; p < nombre; p++) {
+        if (p % PARTIES_PAR_FLUX == 0) {
+            partie.generateur = flux;
+            sauter_generateur(&flux);
+        }
+
+        initialiser_partie(&partie, nombre_joueurs, cases, etats);
+        if (!commencer_partie_journal(&journal, nombre_joueurs)) {
+            fprintf(stderr, "Mémoire insuffisante pour écrire le journal %s\n", chemin);
+            break;
+        }
+        while (!partie_terminee(&partie)) {
+            jouer_tour(&instance, &partie, &tour);
+            ecrire_tour_journal(&journal, &tour);
+        }
+        terminer_partie_journal(&journal, &partie.feuilles, trouver_vainqueurs(&partie.feuilles, totaux));
+    }
+    if (!fermer_journal(&journal)) {
+        fprintf(stderr, "Erreur d'écriture du journal %s\n", chemin);
+        return EXIT_FAILURE;
+    }
+    duree = secondes_ecoulees() - debut;
+
+    fprintf(stderr, "%ld parties écrites dans %s : %llu octets, %.2f octets par tour, %.3f s (%.0f parties/s)\n",
+            nombre, chemin, (unsigned long long) journal.octets_ecrits,
+            (double) journal.octets_ecrits / (13.0 * nombre_joueurs * nombre), duree, nombre / duree);
+
+    liberer_instance(&instance);
+    free(totaux);
+    free(etats);
+    free(cases);
+    if (esperances.entete != NULL) {
+        liberer_table(&esperances);
+    }
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @fn int mode_relire(int argc, char *argv[])
+ * 
+ * @brief Cette fonction rejoue un journal de parties projeté en mémoire et recalcule les points
+ * 
+ * @param argc Le nombre d'arguments
+ * @param argv Les arguments : relire [fichier] [sans-controle]
+ * @return int le code de retour du programme
+ */
+int mode_relire(int argc, char *argv[]) {
+    t_bilan_journal bilan;
+    const char *chemin;
+    struct stat informations;
+    void *donnees;
+    bool valide;
+    int descripteur;
+    double debut;
+    double duree;
+
+    chemin = argc > 2 ? argv[2] : FICHIER_JOURNAL;
+    descripteur = open(chemin, O_RDONLY);
+    if (descripteur == -1 || fstat(descripteur, &informations) != 0 || informations.st_size == 0) {
+        fprintf(stderr, "Impossible de lire %s\n", chemin);
+        return EXIT_FAILURE;
+    }
+    donnees = mmap(NULL, informations.st_size, PROT_READ, MAP_PRIVATE, descripteur, 0);
+    close(descripteur);
+    if (donnees == MAP_FAILED) {
+        fprintf(stderr, "Impossible de projeter %s\n", chemin);
+        return EXIT_FAILURE;
+    }
+    madvise(donnees, informations.st_size, MADV_SEQUENTIAL);
+
+    debut = secondes_ecoulees();
+    valide = relire_journal(donnees, informations.st_size, !(argc > 3 && strcmp(argv[3], "sans-controle") == 0),
+                            &bilan);
+    duree = secondes_ecoulees() - debut;
+
+    printf("Journal        : %s (%s)\n", chemin, valide ? "valide" : "invalide");
+    printf("Parties        : %ld\n", bilan.nombre_parties);
+    printf("Tours          : %ld (%.2f relances par tour)\n", bilan.nombre_tours,
+           bilan.nombre_tours > 0 ? (double) bilan.nombre_relances / bilan.nombre_tours : 0.0);
+    printf("Total moyen    : %.2f\n", bilan.nombre_totaux > 0 ? (double) bilan.somme_totaux / bilan.nombre_totaux : 0.0);
+    printf("Incohérences   : %ld\n", bilan.nombre_erreurs);
+    printf("Écarts         : %ld totaux, %ld bonus, %ld vainqueurs\n", bilan.ecarts_totaux, bilan.ecarts_bonus,
+           bilan.ecarts_vainqueurs);
+    printf("Durée          : %.3f s (%.0f Mo/s, %.0f parties/s)\n", duree, informations.st_size / duree / 1e6,
+           bilan.nombre_parties / duree);
+
+    liberer_bilan_journal(&bilan);
+    munmap(donnees, informations.st_size);
+    return valide && bilan.nombre_erreurs == 0 && bilan.ecarts_totaux == 0 && bilan.ecarts_bonus == 0
+           && bilan.ecarts_vainqueurs == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**
+ * @fn int mode_auditer(int argc, char *argv[])
+ * 
+ * @brief Cette fonction audite un journal de parties projeté en mémoire avec les règles de référence
+ * 
+ * @param argc Le nombre d'arguments
+ * @param argv Les arguments : auditer [fichier] [threads] [sans-controle]
+ * @return int le code de retour du programme, EXIT_FAILURE si le journal est invalide ou a des écarts
+ */
+int mode_auditer(int argc, char *argv[]) {
+    t_bilan_journal bilan;
+    const char *chemin;
+    struct stat informations;
+    void *donnees;
+    bool valide;
+    long ecarts;
+    int nombre_threads;
+    int descripteur;
+    double debut;
+    double duree;
+
+    chemin = argc > 2 ? argv[2] : FICHIER_JOURNAL;
+    nombre_threads = argc > 3 ? atoi(argv[3]) : sysconf(_SC_NPROCESSORS_ONLN);
+    if (nombre_threads <= 0) {
+        fprintf(stderr, "Nombre de threads invalide : %s\n", argv[3]);
+        return EXIT_FAILURE;
+    }
+    descripteur = open(chemin, O_RDONLY);
+    if (descripteur == -1 || fstat(descripteur, &informations) != 0 || informations.st_size == 0) {
+        fprintf(stderr, "Impossible de lire %s\n", chemin);
+        return EXIT_FAILURE;
+    }
+    donnees = mmap(NULL, informations.st_size, PROT_READ, MAP_PRIVATE, descripteur, 0);
+    close(descripteur);
+    if (donnees == MAP_FAILED) {
+        fprintf(stderr, "Impossible de projeter %s\n", chemin);
+        return EXIT_FAILURE;
+    }
+    madvise(donnees, informations.st_size, MADV_WILLNEED);
+
+    debut = secondes_ecoulees();
+    valide = auditer_journal(donnees, informations.st_size, !(argc > 4 && strcmp(argv[4], "sans-controle") == 0),
+                             nombre_threads, &bilan);
+    duree = secondes_ecoulees() - debut;
+    ecarts = bilan.ecarts_points + bilan.ecarts_totaux + bilan.ecarts_bonus + bilan.ecarts_vainqueurs;
+
+    printf("Journal        : %s (%s)\n", chemin, valide ? "valide" : "invalide");
+    printf("Parties        : %ld\n", bilan.nombre_parties);
+    printf("Tours          : %ld (%.2f relances par tour)\n", bilan.nombre_tours,
+           bilan.nombre_tours > 0 ? (double) bilan.nombre_relances / bilan.nombre_tours : 0.0);
+    printf("Total moyen    : %.2f\n", bilan.nombre_totaux > 0 ? (double) bilan.somme_totaux / bilan.nombre_totaux : 0.0);
+    printf("Incohérences   : %ld\n", bilan.nombre_erreurs);
+    printf("Écarts         : %ld points, %ld totaux, %ld bonus, %ld vainqueurs\n", bilan.ecarts_points,
+           bilan.ecarts_totaux, bilan.ecarts_bonus, bilan.ecarts_vainqueurs);
+    printf("Durée          : %.3f s sur %d threads (%.0f Mo/s, %.0f millions de tours/s)\n", duree, nombre_threads,
+           informations.st_size / duree / 1e6, bilan.nombre_tours / duree / 1e6);
+
+    munmap(donnees, informations.st_size);
+    return valide && bilan.nombre_erreurs == 0 && ecarts == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**
+ * @brief Le chemin par défaut de la socket du serveur de parties
+ * 
+ */
+#define FICHIER_SOCKET "yams.sock"
+
+/**
+ * @fn int mode_servir(int argc, char *argv[])
+ * 
+ * @brief Cette fonction sert des parties à des clients connectés sur une socket locale
+ * 
+ * @param argc Le nombre d'arguments
+ * @param argv Les arguments : servir [socket] [graine]
+ * @return int le code de retour du programme
+ * 
+ * Chaque connexion joue ses parties avec les commandes décrites dans executer_commande_session, par exemple :
+ * socat - UNIX-CONNECT:yams.sock
+ */
+int mode_servir(int argc, char *argv[]) {
+    t_serveur serveur;
+    const char *chemin;
+    uint64_t graine;
+
+    chemin = argc > 2 ? argv[2] : FICHIER_SOCKET;
+    graine = argc > 3 ? strtoull(argv[3], NULL, 10) : (uint64_t) time(NULL);
+
+    fprintf(stderr, "Socket            : %s\n", chemin);
+    fprintf(stderr, "Mémoire / session : %zu octets\n", sizeof(t_session));
+    if (!servir_parties(chemin, graine, &serveur)) {
+        fprintf(stderr, "Impossible d'ouvrir la socket %s\n", chemin);
+        return EXIT_FAILURE;
+    }
+
+    printf("Sessions          : %ld (%ld au plus en même temps)\n", serveur.sessions_totales, serveur.sessions_max);
+    printf("Commandes         : %ld\n", serveur.commandes);
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @fn int mode_resoudre(int argc, char *argv[])
+ * 
+ * @brief Cette fonction calcule la stratégie optimale et enregistre la table des espérances
+ * 
+ * @param argc Le nombre d'arguments
+ * @param argv Les arguments : resoudre [fichier des espérances] [nombre de threads]
+ * @return int le code de retour du programme
+ */
+int mode_resoudre(int argc, char *argv[]) {
+    double *esperances;
+    const char *chemin;
+    int nombre_threads;
+    long nombre_etats;
+    double debut;
+    double duree;
+
+    chemin = argc > 2 ? argv[2] : FICHIER_ESPERANCES;
+    nombre_threads = argc > 3 ? atoi(argv[3]) : sysconf(_SC_NPROCESSORS_ONLN);
+    if (nombre_threads <= 0) {
+        nombre_threads = 1;
+    }
+
+    esperances = malloc(NOMBRE_ETATS * sizeof(double));
+
+    debut = secondes_ecoulees();
+    nombre_etats = resoudre_strategie(esperances, nombre_threads);
+    duree = secondes_ecoulees() - debut;
+
+    printf("États résolus     : %ld\n", nombre_etats);
+    printf("Threads           : %d\n", nombre_threads);
+    printf("Durée             : %.3f s\n", duree);
+    printf("Espérance optimale: %.4f\n", esperances[INDICE_ETAT(0, 0)]);
+
+    if (!ecrire_table(chemin, TABLE_ESPERANCES, esperances, NOMBRE_ETATS, sizeof(double))) {
+        fprintf(stderr, "Impossible d'écrire %s\n", chemin);
+        free(esperances);
+        return EXIT_FAILURE;
+    }
+    printf("Table enregistrée : %s\n", chemin);
+
+    free(esperances);
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @fn int mode_resoudre_seuils(int argc, char *argv[])
+ * 
+ * @brief Cette fonction calcule pour chaque état la plus grande probabilité d'atteindre chaque score et enregistre
+ * la table des seuils
+ * 
+ * @param argc Le nombre d'arguments
+ * @param argv Les arguments : resoudre-seuils [fichier des seuils] [nombre de threads]
+ * @return int le code de retour du programme
+ * 
+ * La table sert à la stratégie seuil-N, qui joue chaque partie pour finir avec au moins N points
+ */
+int mode_resoudre_seuils(int argc, char *argv[]) {
+    t_probabilites *vecteurs;
+    const float *depart;
+    const char *chemin;
+    uint32_t blocs;
+    int nombre_threads;
+    double debut;
+    double duree;
+
+    chemin = argc > 2 ? argv[2] : FICHIER_SEUILS;
+    nombre_threads = argc > 3 ? atoi(argv[3]) : sysconf(_SC_NPROCESSORS_ONLN);
+    if (nombre_threads <= 0) {
+        nombre_threads = 1;
+    }
+
+    blocs = initialiser_vecteurs();
+    vecteurs = aligned_alloc(sizeof(t_probabilites), (size_t) blocs * sizeof(t_probabilites));
+
+    debut = secondes_ecoulees();
+    calculer_distributions(vecteurs, NULL, nombre_threads);
+    duree = secondes_ecoulees() - debut;
+
+    depart = (const float *) (vecteurs + DEBUT_VECTEURS[INDICE_ETAT(0, 0)]);
+    printf("Probabilités      : %llu\n", (unsigned long long) blocs * PROBABILITES_PAR_VECTEUR);
+    printf("Threads           : %d\n", nombre_threads);
+    printf("Durée             : %.3f s\n", duree);
+    for (int seuil = 150; seuil <= 350; seuil = seuil + 25) {
+        printf("Au moins %3d      : %.6f\n", seuil, depart[seuil]);
+    }
+
+    if (!ecrire_table(chemin, TABLE_SEUILS, vecteurs, (uint64_t) blocs * PROBABILITES_PAR_VECTEUR, sizeof(float))) {
+        fprintf(stderr, "Impossible d'écrire %s\n", chemin);
+        free(vecteurs);
+        return EXIT_FAILURE;
+    }
+    printf("Table enregistrée : %s\n", chemin);
+
+    free(vecteurs);
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @fn int mode_distribution(int argc, char *argv[])
+ * 
+ * @brief Cette fonction calcule la distribution exacte du score final de la stratégie optimale
+ * 
+ * @param argc Le nombre d'arguments
+ * @param argv Les arguments : distribution [fichier des espérances] [nombre de threads] [fichier des seuils]
+ * @return int le code de retour du programme
+ * 
+ * Affiche la moyenne, l'écart type et les centiles du score final, puis la probabilité de finir avec au moins
+ * chaque score, comparée quand la table des seuils est disponible à la plus grande probabilité possible
+ */
+int mode_distribution(int argc, char *argv[]) {
+    t_table_projetee table_esperances;
+    t_table_projetee table_seuils;
+    t_probabilites *vecteurs;
+    const double *esperances;
+    const float *seuils;
+    const float *distribution;
+    double au_moins[SCORE_MAXIMAL + 2];
+    double moyenne;
+    double carres;
+    uint32_t blocs;
+    int nombre_threads;
+    int k;
+    double debut;
+    double duree;
+
+    esperances = charger_esperances(argc > 2 ? argv[2] : FICHIER_ESPERANCES, &table_esperances);
+    if (esperances == NULL) {
+        fprintf(stderr, "Impossible de lire la table des espérances, lancez d'abord le mode resoudre\n");
+        return EXIT_FAILURE;
+    }
+    nombre_threads = argc > 3 ? atoi(argv[3]) : sysconf(_SC_NPROCESSORS_ONLN);
+    if (nombre_threads <= 0) {
+        nombre_threads = 1;
+    }
+
+    blocs = initialiser_vecteurs();
+    vecteurs = aligned_alloc(sizeof(t_probabilites), (size_t) blocs * sizeof(t_probabilites));
+
+    debut = secondes_ecoulees();
+    calculer_distributions(vecteurs, esperances, nombre_threads);
+    duree = secondes_ecoulees() - debut;
+
+    distribution = (const float *) (vecteurs + DEBUT_VECTEURS[INDICE_ETAT(0, 0)]);
+    moyenne = 0.0;
+    carres = 0.0;
+    au_moins[SCORE_MAXIMAL + 1] = 0.0;
+    for (int score = SCORE_MAXIMAL; score >= 0; score--) {
+        moyenne = moyenne + score * (double) distribution[score];
+        carres = carres + (double) score * score * distribution[score];
+        au_moins[score] = au_moins[score + 1] + distribution[score];
+    }
+
+    printf("Durée             : %.3f s\n", duree);
+    printf("Probabilité totale: %.6f\n", au_moins[0]);
+    printf("Score moyen       : %.4f\n", moyenne);
+    printf("Écart type        : %.4f\n", sqrt(carres - moyenne * moyenne));
+    printf("Centiles          :");
+    k = 0;
+    for (int score = 0; score <= SCORE_MAXIMAL && k < 9; score++) {
+        while (k < 9 && au_moins[0] - au_moins[score + 1] >= CENTILES_RAPPORT[k] / 100.0) {
+            printf(" %d:%d", CENTILES_RAPPORT[k], score);
+            k = k + 1;
+        }
+    }
+    printf("\n");
+
+    seuils = charger_seuils(argc > 4 ? argv[4] : FICHIER_SEUILS, &table_seuils);
+    printf("Au moins    optimal%s\n", seuils != NULL ? "    meilleure" : "");
+    for (int seuil = 150; seuil <= 350; seuil = seuil + 25) {
+        printf("%8d   %.6f", seuil, au_moins[seuil]);
+        if (seuils != NULL) {
+            printf("     %.6f", seuils[DEBUT_VECTEURS[INDICE_ETAT(0, 0)] * PROBABILITES_PAR_VECTEUR + seuil]);
+        }
+        printf("\n");
+    }
+
+    if (seuils != NULL) {
+        liberer_table(&table_seuils);
+    }
+    liberer_table(&table_esperances);
+    free(vecteurs);
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @fn int mode_finales(int argc, char *argv[])
+ * 
+ * @brief Cette fonction calcule et enregistre les tables des finales à deux joueurs
+ * 
+ * @param argc Le nombre d'arguments
+ * @param argv Les arguments : finales [combinaisons libres] [fichier] [nombre de threads]
+ * @return int le code de retour du programme
+ * 
+ * Les tables couvrent les fins de partie où chaque joueur a au plus le nombre donné de combinaisons libres, 2 par
+ * défaut
+ */
+int mode_finales(int argc, char *argv[]) {
+    t_finales finales;
+    uint16_t *donnees;
+    uint64_t nombre;
+    const char *chemin;
+    int libres;
+    int nombre_threads;
+    double debut;
+    double duree;
+
+    libres = argc > 2 ? atoi(argv[2]) : 2;
+    if (libres < 1 || libres > LIBRES_FINALES_MAX) {
+        fprintf(stderr, "Nombre de combinaisons libres invalide : %s (de 1 à %d)\n", argv[2], LIBRES_FINALES_MAX);
+        return EXIT_FAILURE;
+    }
+    chemin = argc > 3 ? argv[3] : FICHIER_FINALES;
+    nombre_threads = argc > 4 ? atoi(argv[4]) : sysconf(_SC_NPROCESSORS_ONLN);
+    if (nombre_threads <= 0) {
+        nombre_threads = 1;
+    }
+
+    initialiser_vecteurs();
+    initialiser_classes_finales();
+
+    debut = secondes_ecoulees();
+    if (!calculer_finales(&finales, libres, nombre_threads, true)) {
+        fprintf(stderr, "Mémoire insuffisante pour les finales de %d combinaisons libres\n", libres);
+        return EXIT_FAILURE;
+    }
+    duree = secondes_ecoulees() - debut;
+
+    nombre = assembler_finales(&finales, &donnees);
+    liberer_finales(&finales);
+    printf("Threads           : %d\n", nombre_threads);
+    printf("Durée             : %.3f s\n", duree);
+    printf("Taille            : %.1f Mo\n", nombre * sizeof(uint16_t) / 1e6);
+
+    if (nombre == 0 || !ecrire_table(chemin, TABLE_FINALES, donnees, nombre, sizeof(uint16_t))) {
+        fprintf(stderr, "Impossible d'écrire %s\n", chemin);
+        free(donnees);
+        return EXIT_FAILURE;
+    }
+    printf("Table enregistrée : %s\n", chemin);
+
+    free(donnees);
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @fn int mode_finale(int argc, char *argv[])
+ * 
+ * @brief Cette fonction donne les décisions qui maximisent la probabilité de gain dans une finale à deux joueurs
+ * 
+ * @param argc Le nombre d'arguments
+ * @param argv Les arguments : finale d1 ... dNOMBRE_DES relances [13 cases du joueur] [13 cases de l'adversaire]
+ * @return int le code de retour du programme
+ * 
+ * Le joueur a autant de combinaisons libres que son adversaire s'il joue en premier, une de plus sinon. Avec des
+ * relances, affiche la probabilité de gain de chaque relance, sinon celle de chaque combinaison libre.
+ */
+int mode_finale(int argc, char *argv[]) {
+    t_table_projetee table;
+    t_finales finales;
+    t_valeurs_tour *valeurs;
+    t_conseil conseils[NOMBRE_MASQUES];
+    t_etat_joueur etat;
+    t_etat_joueur etat_adversaire;
+    t_score scores;
+    t_score scores_adversaire;
+    t_des des;
+    int relances_restantes;
+    int masque;
+    int masque_adversaire;
+    int besoin;
+    int besoin_adversaire;
+    int tours;
+    int ecart;
+
+    if (argc < 29 + NOMBRE_DES) {
+        fprintf(stderr, "Utilisation : %s finale " TEXTE_DES " relances [13 cases du joueur] "
+                        "[13 cases de l'adversaire]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    for (int i = 0; i < NOMBRE_DES; i++) {
+        des[i] = atoi(argv[2 + i]);
+        if (des[i] < 1 || des[i] > NOMBRE_FACES) {
+            fprintf(stderr, "Dé invalide : %s\n", argv[2 + i]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    relances_restantes = atoi(argv[2 + NOMBRE_DES]);
+    if (relances_restantes < 0 || relances_restantes > NOMBRE_RELANCES) {
+        fprintf(stderr, "Nombre de relances invalide : %s\n", argv[2 + NOMBRE_DES]);
+        return EXIT_FAILURE;
+    }
+
+    for (int i = 0; i < 13; i++) {
+        scores[i] = atoi(argv[3 + NOMBRE_DES + i]);
+        scores_adversaire[i] = atoi(argv[16 + NOMBRE_DES + i]);
+    }
+
+    if (!charger_finales(FICHIER_FINALES, &table, &finales)) {
+        fprintf(stderr, "Impossible de lire les tables des finales, lancez d'abord le mode finales\n");
+        return EXIT_FAILURE;
+    }
+
+    etat = resumer_feuille(scores);
+    etat_adversaire = resumer_feuille(scores_adversaire);
+    masque = ETAT_MASQUE(etat);
+    masque_adversaire = ETAT_MASQUE(etat_adversaire);
+    tours = 26 - __builtin_popcount(masque) - __builtin_popcount(masque_adversaire);
+    if (13 - __builtin_popcount(masque) != (tours + 1) / 2 || tours < 1) {
+        fprintf(stderr, "Le joueur doit avoir autant de combinaisons libres que son adversaire, ou une de plus\n");
+        liberer_table(&table);
+        return EXIT_FAILURE;
+    }
+    if (tours > 2 * finales.libres) {
+        fprintf(stderr, "Les tables ne couvrent que les finales d'au plus %d combinaisons libres par joueur\n",
+                finales.libres);
+        liberer_table(&table);
+        return EXIT_FAILURE;
+    }
+
+    besoin = besoin_feuille(etat);
+    besoin_adversaire = besoin_feuille(etat_adversaire);
+    ecart = ETAT_TOTAL(etat) - ETAT_TOTAL(etat_adversaire);
+
+    valeurs = malloc(sizeof(t_valeurs_tour));
+    if (valeurs == NULL) {
+        fprintf(stderr, "Mémoire insuffisante pour évaluer la finale\n");
+        liberer_table(&table);
+        return EXIT_FAILURE;
+    }
+    for (int m = 0; m < NOMBRE_MAINS; m++) {
+        valeurs->mains[0][m] = 0.0;
+        for (int c = 0; c < 13; c++) {
+            if (!(masque & (1 << c))) {
+                double probabilite;
+
+                probabilite = probabilite_validation_finale(&finales, tours, masque, besoin, masque_adversaire,
+                                                            besoin_adversaire, ecart, c, TABLE_POINTS[m].points[c]);
+                if (probabilite > valeurs->mains[0][m]) {
+                    valeurs->mains[0][m] = probabilite;
+                }
+            }
+        }
+    }
+    propager_valeurs_tour(valeurs);
+
+    printf("Écart             : %+d\n", ecart);
+    printf("Gain avant lancer : %.4f\n", esperance_tour(valeurs));
+
+    if (relances_restantes > 0) {
+        classer_conseils(valeurs, des, relances_restantes, 0.0, conseils);
+        printf("Relances (probabilité de gain) :\n");
+        for (int i = 0; i < NOMBRE_MASQUES; i++) {
+            if (conseils[i].masque_relance == 0) {
+                printf(" - ne pas relancer : %.4f\n", conseils[i].esperance);
+            }
+            else {
+                printf(" - relancer les dés");
+                for (int j = 0; j < NOMBRE_DES; j++) {
+                    if (conseils[i].masque_relance & (1 << j)) {
+                        printf(" %d", j + 1);
+                    }
+                }
+                printf(" : %.4f\n", conseils[i].esperance);
+            }
+        }
+    }
+    else {
+        printf("Combinaisons (probabilité de gain) :\n");
+        for (int c = 0; c < 13; c++) {
+            if (!(masque & (1 << c))) {
+                printf(" - %-*s : %.4f\n", largeur_champ(NOMS_COMBINAISONS[c], 12), NOMS_COMBINAISONS[c],
+                       probabilite_validation_finale(&finales, tours, masque, besoin, masque_adversaire,
+                                                     besoin_adversaire, ecart, c, compter_points(c, des)));
+            }
+        }
+    }
+
+    free(valeurs);
+    liberer_table(&table);
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @fn int mode_verifier(int argc, char *argv[])
+ * 
+ * @brief Cette fonction vérifie l'intégrité complète d'une table des espérances enregistrée
+ * 
+ * @param argc Le nombre d'arguments
+ * @param argv Les arguments : verifier [fichier des espérances]
+ * @return int le code de retour du programme
+ */
+int mode_verifier(int argc, char *argv[]) {
+    t_table_projetee table;
+    const char *chemin;
+    bool intacte;
+
+    chemin = argc > 2 ? argv[2] : FICHIER_ESPERANCES;
+
+    if (!projeter_table(chemin, TABLE_ESPERANCES, sizeof(double), &table)) {
+        fprintf(stderr, "%s : table absente ou entête invalide\n", chemin);
+        return EXIT_FAILURE;
+    }
+
+    intacte = verifier_table(&table);
+    printf("%s : version %u, %llu valeurs, %s\n", chemin, table.entete->version,
+           (unsigned long long) table.entete->nombre_valeurs, intacte ? "intacte" : "corrompue");
+
+    liberer_table(&table);
+    return intacte ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**
+ * @fn int mode_conseiller(int argc, char *argv[])
+ * 
+ * @brief Cette fonction affiche le classement des relances pour des dés et une feuille donnés
+ * 
+ * @param argc Le nombre d'arguments
+ * @param argv Les arguments : conseiller d1 ... dNOMBRE_DES relances [13 cases de la feuille, -1 pour une case vide]
+ * @return int le code de retour du programme
+ */
+int mode_conseiller(int argc, char *argv[]) {
+    t_table_projetee esperances;
+    t_contexte_optimal *contexte;
+    t_conseil conseils[NOMBRE_MASQUES];
+    t_score scores;
+    t_des des;
+    int relances_restantes;
+
+    if (argc < 3 + NOMBRE_DES) {
+        fprintf(stderr, "Utilisation : %s conseiller " TEXTE_DES " relances [13 cases de la feuille]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    for (int i = 0; i < NOMBRE_DES; i++) {
+        des[i] = atoi(argv[2 + i]);
+        if (des[i] < 1 || des[i] > NOMBRE_FACES) {
+            fprintf(stderr, "Dé invalide : %s\n", argv[2 + i]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    relances_restantes = atoi(argv[2 + NOMBRE_DES]);
+    if (relances_restantes < 1 || relances_restantes > NOMBRE_RELANCES) {
+        fprintf(stderr, "Nombre de relances invalide : %s\n", argv[2 + NOMBRE_DES]);
+        return EXIT_FAILURE;
+    }
+
+    for (int i = 0; i < 13; i++) {
+        scores[i] = argc > 3 + NOMBRE_DES + i ? atoi(argv[3 + NOMBRE_DES + i]) : -1;
+        if (scores[i] < -1 || scores[i] > POINTS_COMBINAISON_MAX) {
+            fprintf(stderr, "Case invalide : %s (-1 si vide, sinon de 0 à %d)\n", argv[3 + NOMBRE_DES + i],
+                    POINTS_COMBINAISON_MAX);
+            return EXIT_FAILURE;
+        }
+    }
+    if (ETAT_MASQUE(resumer_feuille(scores)) == 0x1FFF) {
+        fprintf(stderr, "La feuille est pleine : laissez au moins une case à -1\n");
+        return EXIT_FAILURE;
+    }
+
+    if (!projeter_table(FICHIER_ESPERANCES, TABLE_ESPERANCES, sizeof(double), &esperances)
+        || esperances.entete->nombre_valeurs != NOMBRE_ETATS) {
+        fprintf(stderr, "Impossible de lire la table des espérances, lancez d'abord le mode resoudre\n");
+        return EXIT_FAILURE;
+    }
+
+    contexte = malloc(sizeof(t_contexte_optimal));
+    if (contexte == NULL) {
+        fprintf(stderr, "Mémoire insuffisante pour conseiller la relance\n");
+        liberer_table(&esperances);
+        return EXIT_FAILURE;
+    }
+    contexte->esperances = esperances.valeurs;
+    contexte->etat = -1;
+
+    afficher_conseils(conseils, conseiller_relance(contexte, des, scores, relances_restantes, conseils));
+
+    free(contexte);
+    liberer_table(&esperances);
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @fn int mode_probabilites(int argc, char *argv[])
+ * 
+ * @brief Cette fonction affiche la probabilité exacte de réaliser chaque combinaison avant la fin du tour
+ * 
+ * @param argc Le nombre d'arguments
+ * @param argv Les arguments : probabilites d1 ... dNOMBRE_DES gardés relances [combinaison visée]
+ * @return int le code de retour du programme
+ * 
+ * Les dés gardés sont donnés par leurs faces, par exemple 345, ou - pour tout relancer. Si une combinaison est
+ * visée, affiche aussi les mains les plus probables à la fin du tour en la visant à chaque relance
+ */
+int mode_probabilites(int argc, char *argv[]) {
+    double probabilites[13];
+    double distribution[NOMBRE_MAINS];
+    char texte[4 * NOMBRE_DES];
+    t_des des;
+    int masque;
+    int relances;
+    int objectif;
+
+    if (argc < 4 + NOMBRE_DES) {
+        fprintf(stderr, "Utilisation : %s probabilites " TEXTE_DES " gardés relances [combinaison]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    for (int i = 0; i < NOMBRE_DES; i++) {
+        des[i] = atoi(argv[2 + i]);
+        if (des[i] < 1 || des[i] > NOMBRE_FACES) {
+            fprintf(stderr, "Dé invalide : %s\n", argv[2 + i]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    masque = 0;
+    for (const char *face = argv[2 + NOMBRE_DES]; strcmp(argv[2 + NOMBRE_DES], "-") != 0 && *face != '\0'; face++) {
+        int i;
+
+        i = 0;
+        while (i < NOMBRE_DES && ((masque & (1 << i)) || des[i] != *face - '0')) {
+            i = i + 1;
+        }
+        if (i == NOMBRE_DES) {
+            fprintf(stderr, "Dé gardé absent du lancer : %c\n", *face);
+            return EXIT_FAILURE;
+        }
+        masque = masque | (1 << i);
+    }
+
+    relances = atoi(argv[3 + NOMBRE_DES]);
+    if (relances < 0 || relances > NOMBRE_RELANCES) {
+        fprintf(stderr, "Nombre de relances invalide : %s\n", argv[3 + NOMBRE_DES]);
+        return EXIT_FAILURE;
+    }
+
+    objectif = -1;
+    if (argc > 4 + NOMBRE_DES) {
+        objectif = chercher_combinaison(argv[4 + NOMBRE_DES]);
+        if (objectif == -1) {
+            fprintf(stderr, "Combinaison inconnue : %s\n", argv[4 + NOMBRE_DES]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    probabilites_combinaisons(des, masque, relances, probabilites);
+    for (int c = 0; c < 13; c++) {
+        printf("%-*s : %7.3f %%\n", largeur_champ(NOMS_COMBINAISONS[c], 12), NOMS_COMBINAISONS[c],
+               100 * probabilites[c]);
+    }
+
+    if (objectif != -1) {
+        distribuer_mains(des, masque, relances, objectif, distribution);
+        printf("\nMains les plus probables en visant %s :\n", NOMS_COMBINAISONS[objectif]);
+        for (int k = 0; k < 10; k++) {
+            int meilleure;
+
+            meilleure = 0;
+            for (int m = 1; m < NOMBRE_MAINS; m++) {
+                if (distribution[m] > distribution[meilleure]) {
+                    meilleure = m;
+                }
+            }
+            if (distribution[meilleure] <= 0.0) {
+                break;
+            }
+
+            formater_des(texte, sizeof(texte), MAINS[meilleure]);
+            printf("  %s : %7.3f %%%s\n", texte, 100 * distribution[meilleure],
+                   (TABLE_POINTS[meilleure].combinaisons & (1 << objectif)) ? " *" : "");
+            distribution[meilleure] = -distribution[meilleure];
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @fn double mesurer_points_lot(void (*version)(t_lot_mains *lot, size_t debut), t_lot_mains *lot, int repetitions)
+ * 
+ * @brief Cette fonction mesure le débit d'une version du calcul par lots
+ * 
+ * @param version La version à mesurer
+ * @param lot Le lot de mains
+ * @param repetitions Le nombre de passages sur le lot
+ * @return double le nombre de mains calculées par seconde
+ */
+double mesurer_points_lot(void (*version)(t_lot_mains *lot, size_t debut), t_lot_mains *lot, int repetitions) {
+    double debut;
+
+    debut = secondes_ecoulees();
+    for (int r = 0; r < repetitions; r++) {
+        version(lot, 0);
+    }
+
+    return (double) lot->nombre * repetitions / (secondes_ecoulees() - debut);
+}
+
+/**
+ * @fn int mode_mesurer_points(int argc, char *argv[])
+ * 
+ * @brief Cette fonction compare le débit du calcul des points main par main et par lots
+ * 
+ * @param argc Le nombre d'arguments
+ * @param argv Les arguments : mesurer-points [nombre de mains] [graine]
+ * @return int le code de retour du programme
+ * 
+ * Consiste à tirer un lot de mains au hasard, à vérifier que chaque version du calcul par lots donne les mêmes
+ * points que compter_points, puis à mesurer le nombre de mains calculées par seconde par chaque version
+ */
+int mode_mesurer_points(int argc, char *argv[]) {
+    t_lot_mains lot;
+    t_generateur generateur;
+    uint8_t *memoire;
+    long nombre;
+    int repetitions;
+    double debut;
+    double debit;
+    double debit_reference;
+    volatile int puits;
+    struct {
+        const char *nom;
+        void (*version)(t_lot_mains *lot, size_t debut);
+    } versions[] = {
+        {"scalaire", points_lot_scalaire},
+#if defined(__x86_64__) || defined(__i386__)
+        {"sse2", points_lot_sse2},
+        {"avx2", points_lot_avx2},
+#endif
+    };
+
+    nombre = argc > 2 ? atol(argv[2]) : 1000000;
+    initialiser_generateur(&generateur, argc > 3 ? strtoull(argv[3], NULL, 10) : (uint64_t) time(NULL));
+    if (nombre <= 0) {
+        fprintf(stderr, "Nombre de mains invalide : %s\n", argv[2]);
+        return EXIT_FAILURE;
+    }
+
+    memoire = (size_t) nombre <= SIZE_MAX / (NOMBRE_DES + 13) ? malloc((size_t) nombre * (NOMBRE_DES + 13)) : NULL;
+    if (memoire == NULL) {
+        fprintf(stderr, "Nombre de mains invalide : %s (mémoire insuffisante)\n", argv[2]);
+        return EXIT_FAILURE;
+    }
+    lot.nombre = nombre;
+    for (int i = 0; i < NOMBRE_DES; i++) {
+        lot.des[i] = memoire + i * nombre;
+        tirer_faces(&generateur, lot.des[i], nombre);
+    }
+    for (int c = 0; c < 13; c++) {
+        lot.points[c] = memoire + (NOMBRE_DES + c) * nombre;
+    }
+
+    repetitions = 1 + 100000000 / nombre;
+    puits = 0;
+
+    debut = secondes_ecoulees();
+    for (long k = 0; k < nombre; k++) {
+        t_des des;
+
+        for (int i = 0; i < NOMBRE_DES; i++) {
+            des[i] = lot.des[i][k];
+        }
+        for (int c = 0; c < 13; c++) {
+            puits = puits + compter_points(c, des);
+        }
+    }
+    debit_reference = nombre / (secondes_ecoulees() - debut);
+    printf("%-20s : %8.2f millions de mains/s\n", "compter_points", debit_reference / 1e6);
+
+    for (size_t v = 0; v < sizeof(versions) / sizeof(versions[0]); v++) {
+#if defined(__x86_64__) || defined(__i386__)
+        if (versions[v].version == points_lot_avx2 && !__builtin_cpu_supports("avx2")) {
+            continue;
+        }
+#endif
+        memset(memoire + NOMBRE_DES * nombre, 0, 13 * nombre);
+        versions[v].version(&lot, 0);
+
+        for (long k = 0; k < nombre; k++) {
+            t_des des;
+
+            for (int i = 0; i < NOMBRE_DES; i++) {
+                des[i] = lot.des[i][k];
+            }
+            for (int c = 0; c < 13; c++) {
+                if (lot.points[c][k] != compter_points(c, des)) {
+                    fprintf(stderr, "%s : écart sur la main %ld, combinaison %s\n",
+                            versions[v].nom, k, NOMS_COMBINAISONS[c]);
+                    free(memoire);
+                    return EXIT_FAILURE;
+                }
+            }
+        }
+
+        debit = mesurer_points_lot(versions[v].version, &lot, repetitions);
+        printf("%-20s : %8.2f millions de mains/s (x%.1f)\n", versions[v].nom, debit / 1e6, debit / debit_reference);
+    }
+
+    printf("Version choisie      : %s\n", choisir_points_lot());
+
+    free(memoire);
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @fn int mode_mesurer_regles(int argc, char *argv[])
+ * 
+ * @brief Cette fonction mesure le coût de chaque fonction des règles, en nanosecondes et en cycles par opération
+ * 
+ * @param argc Le nombre d'arguments
+ * @param argv Les arguments : mesurer-regles [lancers aléatoires] [graine] [fonction]
+ * @return int le code de retour du programme
+ * 
+ * Chaque fonction est mesurée sur les 7776 lancers possibles, dans l'ordre de code_lancer, puis sur des lancers
+ * tirés au hasard, dont l'ordre ne laisse rien deviner aux prédicteurs de branchement. Les cycles sont ceux du
+ * compteur d'horodatage, qui avance à fréquence fixe quelle que soit la fréquence du processeur
+ */
+int mode_mesurer_regles(int argc, char *argv[]) {
+    t_generateur generateur;
+    t_des *exhaustifs;
+    t_des *aleatoires;
+    t_mesure_regles mesure;
+    long nombre;
+    const char *filtre;
+    bool trouve;
+    volatile long puits;
+    struct {
+        const char *nom;
+        t_des *lancers;
+        long nombre;
+    } series[2];
+
+    nombre = argc > 2 ? atol(argv[2]) : 65536;
+    initialiser_generateur(&generateur, argc > 3 ? strtoull(argv[3], NULL, 10) : (uint64_t) time(NULL));
+    filtre = argc > 4 ? argv[4] : NULL;
+    if (nombre <= 0) {
+        fprintf(stderr, "Nombre de lancers invalide : %s\n", argv[2]);
+        return EXIT_FAILURE;
+    }
+
+    exhaustifs = malloc(NOMBRE_LANCERS * sizeof(t_des));
+    aleatoires = (size_t) nombre <= SIZE_MAX / sizeof(t_des) ? malloc(nombre * sizeof(t_des)) : NULL;
+    if (exhaustifs == NULL || aleatoires == NULL) {
+        fprintf(stderr, "Nombre de lancers invalide : %s (mémoire insuffisante)\n", argv[2]);
+        free(aleatoires);
+        free(exhaustifs);
+        return EXIT_FAILURE;
+    }
+    for (int code = 0; code < NOMBRE_LANCERS; code++) {
+        decoder_lancer(code, exhaustifs[code]);
+    }
+    for (long k = 0; k < nombre; k++) {
+        lancer_des(NOMBRE_DES, aleatoires[k], &generateur);
+    }
+    series[0].nom = "exhaustifs";
+    series[0].lancers = exhaustifs;
+    series[0].nombre = NOMBRE_LANCERS;
+    series[1].nom = "au hasard";
+    series[1].lancers = aleatoires;
+    series[1].nombre = nombre;
+
+    printf("%-24s %-12s %9s %9s %10s %10s\n", "Fonction", "Lancers", "ns/op", "min ns/op", "cycles/op", "dispersion");
+    puits = 0;
+    trouve = false;
+    for (size_t n = 0; n < sizeof(NOYAUX_REGLES) / sizeof(NOYAUX_REGLES[0]); n++) {
+        if (filtre != NULL && strcmp(filtre, NOYAUX_REGLES[n].nom) != 0) {
+            continue;
+        }
+        trouve = true;
+
+        for (int s = 0; s < 2; s++) {
+            puits = puits + mesurer_noyau(&NOYAUX_REGLES[n], series[s].lancers, series[s].nombre, &generateur,
+                                          &mesure);
+            printf("%-24s %-12s %9.2f %9.2f %10.1f %9.1f %%\n", NOYAUX_REGLES[n].nom, series[s].nom,
+                   mesure.nanosecondes, mesure.nanosecondes_minimum, mesure.cycles, 100 * mesure.dispersion);
+            fflush(stdout);
+        }
+    }
+
+    free(aleatoires);
+    free(exhaustifs);
+    if (!trouve) {
+        fprintf(stderr, "Fonction inconnue : %s\n", filtre);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @fn int executer_mode(int argc, char *argv[])
+ * 
+ * @brief Cette fonction exécute le mode demandé sur la ligne de commande à la place de la partie interactive
+ * 
+ * @param argc Le nombre d'arguments
+ * @param argv Les arguments, le premier désigne le mode
+ * @return int le code de retour du programme
+ */
+int executer_mode(int argc, char *argv[]) {
+    if (strcmp(argv[1], "simuler") == 0) {
+        return mode_simuler(argc, argv);
+    }
+    if (strcmp(argv[1], "statistiques") == 0) {
+        return mode_statistiques(argc, argv);
+    }
+    if (strcmp(argv[1], "repartir") == 0) {
+        return mode_repartir(argc, argv);
+    }
+    if (strcmp(argv[1], "resoudre") == 0) {
+        return mode_resoudre(argc, argv);
+    }
+    if (strcmp(argv[1], "resoudre-seuils") == 0) {
+        return mode_resoudre_seuils(argc, argv);
+    }
+    if (strcmp(argv[1], "distribution") == 0) {
+        return mode_distribution(argc, argv);
+    }
+    if (strcmp(argv[1], "finales") == 0) {
+        return mode_finales(argc, argv);
+    }
+    if (strcmp(argv[1], "finale") == 0) {
+        return mode_finale(argc, argv);
+    }
+    if (strcmp(argv[1], "servir") == 0) {
+        return mode_servir(argc, argv);
+    }
+    if (strcmp(argv[1], "verifier") == 0) {
+        return mode_verifier(argc, argv);
+    }
+    if (strcmp(argv[1], "conseiller") == 0) {
+        return mode_conseiller(argc, argv);
+    }
+    if (strcmp(argv[1], "probabilites") == 0) {
+        return mode_probabilites(argc, argv);
+    }
+    if (strcmp(argv[1], "mesurer-points") == 0) {
+        return mode_mesurer_points(argc, argv);
+    }
+    if (strcmp(argv[1], "mesurer-regles") == 0) {
+        return mode_mesurer_regles(argc, argv);
+    }
+    if (strcmp(argv[1], "tournoi") == 0) {
+        return mode_tournoi(argc, argv);
+    }
+    if (strcmp(argv[1], "tablee") == 0) {
+        return mode_tablee(argc, argv);
+    }
+    if (strcmp(argv[1], "script") == 0) {
+        return mode_script(argc, argv);
+    }
+    if (strcmp(argv[1], "enregistrer") == 0) {
+        return mode_enregistrer(argc, argv);
+    }
+    if (strcmp(argv[1], "journaliser") == 0) {
+        return mode_journaliser(argc, argv);
+    }
+    if (strcmp(argv[1], "relire") == 0) {
+        return mode_relire(argc, argv);
+    }
+    if (strcmp(argv[1], "auditer") == 0) {
+        return mode_auditer(argc, argv);
+    }
+
+    fprintf(stderr, "Mode inconnu : %s\n"
+                    "Utilisation : %s [jouer [joueurs] [ecran|texte]]\n"
+                    "              %s [simuler [parties] [graine] [glouton|sans-relance|optimal|seuil-N|memo-nom|module.so] [fichier]]\n"
+                    "              %s [statistiques [parties] [graine] [stratégie] [threads] [json|csv] [fichier|-]]\n"
+                    "              %s [repartir [parties] [graine] [stratégie] [processus] [threads] [dossier|-] [json|csv] [fichier|-]]\n"
+                    "              %s [resoudre [fichier] [threads]]\n"
+                    "              %s [resoudre-seuils [fichier] [threads]]\n"
+                    "              %s [distribution [fichier des espérances] [threads] [fichier des seuils]]\n"
+                    "              %s [finales [combinaisons libres] [fichier] [threads]]\n"
+                    "              %s [finale " TEXTE_DES " relances feuille feuille-adverse]\n"
+                    "              %s [verifier [fichier]]\n"
+                    "              %s [conseiller " TEXTE_DES " relances [feuille]]\n"
+                    "              %s [probabilites " TEXTE_DES " gardés|- relances [combinaison]]\n"
+                    "              %s [mesurer-points [mains] [graine]]\n"
+                    "              %s [mesurer-regles [lancers] [graine] [fonction]]\n"
+                    "              %s [tournoi [parties] [graine] [ronde|suisse] [threads] [rondes]]\n"
+                    "              %s [tablee [joueurs] [parties] [graine] [stratégie,stratégie...]]\n"
+                    "              %s [script [fichier|-] [verbeux]]\n"
+                    "              %s [enregistrer [parties] [graine] [stratégie] [joueurs]]\n"
+                    "              %s [journaliser [parties] [graine] [stratégie] [joueurs] [fichier|-]]\n"
+                    "              %s [relire [fichier] [sans-controle]]\n"
+                    "              %s [auditer [fichier] [threads] [sans-controle]]\n"
+                    "              %s [servir [socket] [graine]]\n",
+                    argv[1], argv[0], argv[0], argv[0], argv[0], argv[0], argv[0], argv[0], argv[0], argv[0], argv[0],
+                    argv[0], argv[0], argv[0], argv[0], argv[0], argv[0], argv[0], argv[0], argv[0], argv[0], argv[0],
+                    argv[0]);
+    return EXIT_FAILURE;
+}
+
+/*********************************
+ *      PROGRAMME PRINCIPAL      *
+ *********************************/
+
+int main(int argc, char *argv[]) {
+    t_partie partie;
+    char (*joueurs)[50];
+    int *cases;
+    t_etat_joueur *etats;
+    int *totaux;
+    t_score scores;
+    int nombre_joueurs;
+    int combinaison;
+    int points;
+    bool validation_lancer;
+    t_table_projetee esperances;
+    t_contexte_optimal *conseiller;
+    t_conseil conseils[NOMBRE_MASQUES];
+    t_ecran ecran;
+    bool plein_ecran;
+
+    initialiser_regles();
+
+    if (argc > 1 && strcmp(argv[1], "jouer") != 0) {
+        return executer_mode(argc, argv);
+    }
+
+    nombre_joueurs = argc > 2 ? atoi(argv[2]) : NOMBRE_JOUEURS;
+    if (nombre_joueurs <= 0) {
+        fprintf(stderr, "Nombre de joueurs invalide : %s\n", argv[2]);
+        return EXIT_FAILURE;
+    }
+    joueurs = malloc(nombre_joueurs * sizeof(*joueurs));
+    cases = malloc(TAILLE_FEUILLES(nombre_joueurs) * sizeof(int));
+    etats = malloc(nombre_joueurs * sizeof(t_etat_joueur));
+    totaux = malloc(nombre_joueurs * sizeof(int));
+
+    plein_ecran = argc > 3 ? strcmp(argv[3], "ecran") == 0 : isatty(STDOUT_FILENO);
+    if (plein_ecran) {
+        creer_ecran(&ecran, LIGNES_PARTIE, colonnes_partie(nombre_joueurs));
+    }
+
+    initialiser_generateur(&partie.generateur, ((uint64_t) time(NULL) << 20) ^ getpid());
+    initialiser_partie(&partie, nombre_joueurs, cases, etats);
+
+    conseiller = NULL;
+    if (projeter_table(FICHIER_ESPERANCES, TABLE_ESPERANCES, sizeof(double), &esperances)
+        && esperances.entete->nombre_valeurs == NOMBRE_ETATS) {
+        conseiller = malloc(sizeof(t_contexte_optimal));
+        conseiller->esperances = esperances.valeurs;
+        conseiller->etat = -1;
+    }
+
+    for (int j = 0; j < nombre_joueurs; j++) {
+        char message[50];
+
+        sprintf(message, "Entrez le nom du joueur %d\n", j + 1);
+        entrer_chaine(message, joueurs[j], sizeof(joueurs[j]));
+    }
+
+    while (!partie_terminee(&partie)) {
+        int i;
+
+        i = partie.joueur;
+        lire_feuille(&partie.feuilles, i, scores);
+        if (plein_ecran) {
+            commencer_tour(&partie);
+            dessiner_partie(&ecran, &partie, joueurs);
+            rafraichir_ecran(&ecran);
+        }
+        else {
+            afficher_scores(scores, partie.feuilles.etats[i], joueurs[i]);
+            commencer_tour(&partie);
+            afficher_des(partie.des);
+        }
+
+        do {
+            if (conseiller != NULL) {
+                conseiller_relance(conseiller, partie.des, scores, partie.relances_restantes, conseils);
+                afficher_conseils(conseils, 3);
+            }
+
+            entrer_booleen("Voulez vous relancer les dés ?\n", &validation_lancer);
+
+            if (validation_lancer) {
+                t_des des_a_relancer;
+                int masque;
+
+                masque = 0;
+
+                entrer_suite("Entrez le numéro du dé à relancer (de 1 à " TEXTE_NOMBRE_DES
+                             ", bornes incluses, ou 0 pour arrêter)\n", des_a_relancer);
+
+                for (int j = 0; j < NOMBRE_DES; j++){
+                    if (des_a_relancer[j] != -1) {
+                        masque = masque | (1 << des_a_relancer[j]);
+                    }
+                }
+
+                relancer_tour(&partie, masque);
+                if (plein_ecran) {
+                    dessiner_partie(&ecran, &partie, joueurs);
+                    rafraichir_ecran(&ecran);
+                }
+                else {
+                    printf("Voici les résultats du lancer de dés :\n");
+                    afficher_des(partie.des);
+                }
+            }
+        }
+        while ((partie.relances_restantes > 0) && (validation_lancer == true));
+
+        combinaisons_disponibles(partie.des, scores);
+        combinaison = entrer_combinaison(scores);
+        points = valider_combinaison(&partie, combinaison);
+
+        if (plein_ecran) {
+            dessiner_partie(&ecran, &partie, joueurs);
+            rafraichir_ecran(&ecran);
+        }
+        else {
+            printf("points: %d\n", points);
+            lire_feuille(&partie.feuilles, i, scores);
+            afficher_scores(scores, partie.feuilles.etats[i], joueurs[i]);
+        }
+    }
+
+    printf("\nLe gagnant est : %s ! Félicitations\n", joueurs[trouver_vainqueurs(&partie.feuilles, totaux)]);
+
+    if (conseiller != NULL) {
+        free(conseiller);
+        liberer_table(&esperances);
+    }
+    if (plein_ecran) {
+        liberer_ecran(&ecran);
+    }
+    free(totaux);
+    free(etats);
+    free(cases);
+    free(joueurs);
+
+    return EXIT_SUCCESS;
+}
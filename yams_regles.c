@@ -0,0 +1,1725 @@
+/**
+ * @file yams_regles.c
+ * @author LAMBERT Chloé
+ * @brief Bibliothèque des règles du YAMS, sans entrée / sortie ni état global modifiable
+ * @version 0.1
+ * @date 2021-11-28
+ * 
+ * @copyright Copyright (c) 2021
+ *
+ * Voir yams_regles.h
+ * 
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "yams_regles.h"
+
+/**
+ * @brief Représente les 13 combinaisons possibles du jeu
+ * 
+ * Ce tableau permet de stocker les 13 combinaisons jouables associées à leur noms
+ * 
+ */
+const char NOMS_COMBINAISONS[13][13] = {
+    "Total de 1", "Total de 2", "Total de 3", 
+    "Total de 4", "Total de 5", "Total de 6", 
+    "Brelan", "Carré", "Full House", 
+    "Petite suite", "Grande suite", "Yams", 
+    "Chance"
+};
+
+/*********************************
+ *       GÉNÉRATEUR DE DÉS       *
+ *********************************/
+
+/**
+ * @fn void initialiser_generateur(t_generateur *generateur, uint64_t graine)
+ * 
+ * @brief Cette procédure initialise un générateur à partir d'une graine
+ * 
+ * @param generateur Le générateur
+ * @param graine La graine, deux générateurs de même graine tirent les mêmes dés
+ * 
+ * Consiste à dériver les 4 mots de l'état de la graine avec splitmix64, qui ne donne jamais un état nul
+ */
+void initialiser_generateur(t_generateur *generateur, uint64_t graine) {
+    for (int i = 0; i < 4; i++) {
+        uint64_t z;
+
+        graine = graine + 0x9E3779B97F4A7C15ULL;
+        z = graine;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        generateur->etat[i] = z ^ (z >> 31);
+    }
+
+    generateur->nombre_reserve = 0;
+}
+
+/**
+ * @fn uint64_t tirer_64(t_generateur *generateur)
+ * 
+ * @brief Cette fonction tire 64 bits aléatoires
+ * 
+ * @param generateur Le générateur
+ * @return uint64_t le tirage suivant de xoshiro256**
+ */
+uint64_t tirer_64(t_generateur *generateur) {
+    uint64_t *etat;
+    uint64_t resultat;
+    uint64_t decale;
+
+    etat = generateur->etat;
+    resultat = etat[1] * 5;
+    resultat = ((resultat << 7) | (resultat >> 57)) * 9;
+    decale = etat[1] << 17;
+
+    etat[2] = etat[2] ^ etat[0];
+    etat[3] = etat[3] ^ etat[1];
+    etat[1] = etat[1] ^ etat[2];
+    etat[0] = etat[0] ^ etat[3];
+    etat[2] = etat[2] ^ decale;
+    etat[3] = (etat[3] << 45) | (etat[3] >> 19);
+
+    return resultat;
+}
+
+/**
+ * @fn void sauter_generateur(t_generateur *generateur)
+ * 
+ * @brief Cette procédure avance le générateur de 2 puissance 128 tirages
+ * 
+ * @param generateur Le générateur
+ * 
+ * Des sauts successifs depuis une même graine donnent des flux indépendants, qui ne se recouvrent pas avant
+ * 2 puissance 128 tirages, un par thread ou par bloc de parties. La réserve de faces est vidée.
+ */
+void sauter_generateur(t_generateur *generateur) {
+    const uint64_t SAUT[4] = {
+        0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL, 0xA9582618E03FC9AAULL, 0x39ABDC4529B1661CULL
+    };
+    uint64_t nouvel_etat[4] = {0, 0, 0, 0};
+
+    for (int i = 0; i < 4; i++) {
+        for (int b = 0; b < 64; b++) {
+            if (SAUT[i] & (1ULL << b)) {
+                for (int j = 0; j < 4; j++) {
+                    nouvel_etat[j] = nouvel_etat[j] ^ generateur->etat[j];
+                }
+            }
+            tirer_64(generateur);
+        }
+    }
+
+    for (int j = 0; j < 4; j++) {
+        generateur->etat[j] = nouvel_etat[j];
+    }
+    generateur->nombre_reserve = 0;
+}
+
+/**
+ * @fn void initialiser_flux(t_generateur *generateur, uint64_t graine, long flux)
+ * 
+ * @brief Cette procédure initialise le générateur du flux numéro flux d'une graine
+ * 
+ * @param generateur Le générateur
+ * @param graine La graine commune à tous les flux
+ * @param flux Le numéro du flux, le flux 0 étant le générateur initialisé par la graine
+ * 
+ * Le coût est proportionnel au numéro du flux, pour parcourir beaucoup de flux il vaut mieux sauter d'un flux
+ * au suivant avec sauter_generateur
+ */
+void initialiser_flux(t_generateur *generateur, uint64_t graine, long flux) {
+    initialiser_generateur(generateur, graine);
+
+    for (long i = 0; i < flux; i++) {
+        sauter_generateur(generateur);
+    }
+}
+
+/**
+ * @fn void remplir_reserve(t_generateur *generateur)
+ * 
+ * @brief Cette procédure remplit la réserve de faces du générateur à partir d'un tirage de 64 bits
+ * 
+ * @param generateur Le générateur, dont la réserve est vide
+ * 
+ * Chaque moitié de 32 bits inférieure au plus grand multiple de NOMBRE_FACES puissance 10 donne 10 faces sans
+ * aucun biais, ses chiffres en base NOMBRE_FACES étant équiprobables. Les autres moitiés sont rejetées, 4 sur 10000
+ * avec 6 faces (71 fois 6 puissance 10), aucune avec 8 faces.
+ */
+void remplir_reserve(t_generateur *generateur) {
+    const uint64_t tirages = PUISSANCE((uint64_t) NOMBRE_FACES, FACES_PAR_TIRAGE);
+    const uint64_t limite = (((uint64_t) 1 << 32) / tirages) * tirages;
+
+    while (generateur->nombre_reserve == 0) {
+        uint64_t tirage;
+
+        tirage = tirer_64(generateur);
+
+        for (int moitie = 0; moitie < 2; moitie++) {
+            uint32_t valeur;
+
+            valeur = (uint32_t) (tirage >> (32 * moitie));
+            if (valeur < limite) {
+                valeur = valeur % tirages;
+                DEROULER
+                for (int i = 0; i < FACES_PAR_TIRAGE; i++) {
+                    generateur->reserve[generateur->nombre_reserve] = valeur % NOMBRE_FACES + 1;
+                    generateur->nombre_reserve = generateur->nombre_reserve + 1;
+                    valeur = valeur / NOMBRE_FACES;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @fn int tirer_face(t_generateur *generateur)
+ * 
+ * @brief Cette fonction tire la face d'un dé
+ * 
+ * @param generateur Le générateur
+ * @return int une face de 1 à NOMBRE_FACES, toutes équiprobables
+ */
+int tirer_face(t_generateur *generateur) {
+    if (generateur->nombre_reserve == 0) {
+        remplir_reserve(generateur);
+    }
+
+    generateur->nombre_reserve = generateur->nombre_reserve - 1;
+    return generateur->reserve[generateur->nombre_reserve];
+}
+
+/**
+ * @fn void tirer_faces(t_generateur *generateur, uint8_t *faces, size_t nombre)
+ * 
+ * @brief Cette procédure tire les faces d'un grand nombre de dés d'un coup
+ * 
+ * @param generateur Le générateur
+ * @param faces Les faces tirées, de 1 à NOMBRE_FACES
+ * @param nombre Le nombre de faces à tirer
+ */
+void tirer_faces(t_generateur *generateur, uint8_t *faces, size_t nombre) {
+    for (size_t i = 0; i < nombre; i++) {
+        if (generateur->nombre_reserve == 0) {
+            remplir_reserve(generateur);
+        }
+
+        generateur->nombre_reserve = generateur->nombre_reserve - 1;
+        faces[i] = generateur->reserve[generateur->nombre_reserve];
+    }
+}
+
+/*********************************
+ *        RÈGLES DU JEU          *
+ *********************************/
+
+/**
+ * @fn void compter_des(t_des des, int occurences[NOMBRE_FACES])
+ * 
+ * @brief Cette procédure va compter les occurences des faces des dés pour déterminer les combinaisons
+ * 
+ * @param des Les 5 dés lancés par le joueur
+ * @param occurences Le nombre de dés de chaque face
+ * 
+ * Consiste à compter les occurences des faces des dés de chaques lancer pour déterminer quelles combinaisons ont été réalisées
+ */
+void compter_des(t_des des, int occurences[NOMBRE_FACES]) {
+    DEROULER
+    for (int i = 0; i < NOMBRE_FACES; i++) {
+        occurences[i] = 0;
+    }
+
+    DEROULER
+    for (int i = 0; i < NOMBRE_DES; i++) {
+        occurences[des[i] -1] = occurences[des[i] - 1] + 1;
+    }
+}
+
+/**
+ * @fn void trier_des(t_des des, t_des resultat)
+ * 
+ * @brief Cette procédure trie les dés
+ * 
+ * @param des Les 5 dés lancés par le joueur
+ * @param resultat Le résultat, les dés triés
+ * 
+ * 
+ */
+void trier_des(t_des des, t_des resultat) {
+    int temp;
+
+    for(int i = 0; i < NOMBRE_DES; i++) {
+        resultat[i] = des[i];
+    }
+
+    for (int i = 0; i < NOMBRE_DES; i++) {
+        for (int j = 1; j < NOMBRE_DES; j++) {
+            if (resultat[j - 1] > resultat[j]) {
+                temp = resultat[j - 1];
+                resultat[j - 1] = resultat[j];
+                resultat[j] = temp;
+            }
+        }
+    }
+}
+
+/**
+ * @fn bool full_house(t_des des)
+ * 
+ * @brief Cette fonction détermine si la combinaison effectuée par le joueur est un Full House
+ * 
+ * @param des Les 5 dés lancés par le joueur
+ * @return true si la combinaison est un Full House
+ * @return false dans les autres cas
+ * 
+ * Consiste à déterminer si la combinaison réalisée après le lancer du joueur est un Full House
+ * C'est à dire une Paire + un Brelan
+ */
+bool full_house(t_des des) {
+    bool pair;
+    bool brelan;
+    int occurences[NOMBRE_FACES];
+
+    pair = false;
+    brelan = false;
+
+    compter_des(des, occurences);
+    for (int i = 0; i < NOMBRE_FACES; i++) {
+
+        if (occurences[i] == 3) {
+            brelan = true;
+        }
+        else if (occurences[i] == 2) {
+            pair = true;
+        }
+    }
+
+    return pair && brelan;
+}
+
+/**
+ * @fn bool brelan(t_des des)
+ * 
+ * @brief Cette fonction détermine si la combinaison effectuée par le joueur est un Brelan
+ * 
+ * @param des Les 5 dés lancés par le joueur
+ * @return true si la combinaison est un Brelan
+ * @return false dans les autres cas
+ * 
+ * Consiste à déterminer si la combinaison réalisée après le lancer du joueur est un Brelan
+ * C'est à dire 3 dés identiques
+ */
+bool brelan(t_des des) {
+    bool resultat;
+    int occurences[NOMBRE_FACES];
+
+    resultat = false;
+
+    compter_des(des, occurences);
+    for (int i = 0; i < NOMBRE_FACES; i++) {
+        if (occurences[i] >= 3) {
+            resultat = true;
+        }
+    }
+
+    return resultat;
+}
+
+/**
+ * @fn bool carre(t_des des)
+ * 
+ * @brief Cette fonction détermine si la combinaison effectuée par le joueur est un Carré
+ * 
+ * @param des Les 5 dés lancés par le joueur
+ * @return true si la combinaison est un Carré
+ * @return false dans les autres cas
+ * 
+ * Consiste à déterminer si la combinaison réalisée après le lancer du joueur est un Carré
+ * C'est à dire 4 dés identiques
+ */
+bool carre(t_des des) {
+    bool resultat;
+    int occurences[NOMBRE_FACES];
+
+    resultat = false;
+
+    compter_des(des, occurences);
+    for (int i = 0; i < NOMBRE_FACES; i++) {
+        if (occurences[i] >= 4) {
+            resultat = true;
+        }
+    }
+
+    return resultat;
+}
+
+/**
+ * @fn bool petite_suite(t_des des)
+ * 
+ * @brief Cette fonction détermine si la combinaison effectuée par le joueur est une Petite Suite
+ * 
+ * @param des Les 5 dés lancés par le joueur
+ * @return true si la combinaison est une Petite Suite
+ * @return false dans les autres cas
+ * 
+ * Consiste à déterminer si la combinaison réalisée après le lancer du joueur est une Petite Suite
+ * C'est à dire LONGUEUR_PETITE_SUITE (4) dés dont la valeur se suit
+ */
+bool petite_suite(t_des des) {
+    bool resultat;
+    int occurences[NOMBRE_FACES];
+
+    compter_des(des, occurences);
+
+    for (int i = 0; i <= NOMBRE_FACES - LONGUEUR_PETITE_SUITE; i++) {
+        resultat = true;
+        for (int j = i; j < i + LONGUEUR_PETITE_SUITE; j++) {
+            if (occurences[j] == 0) {
+                resultat = false;
+            }
+        }
+
+        if (resultat) {
+            break;
+        }
+    }
+
+    return resultat;
+}
+
+/**
+ * @fn bool grande_suite(t_des des)
+ * 
+ * @brief Cette fonction détermine si la combinaison effectuée par le joueur est une Grande Suite
+ * 
+ * @param des Les 5 dés lancés par le joueur
+ * @return true si la combinaison est une Grande Suite
+ * @return false dans les autres cas
+ * 
+ * Consiste à déterminer si la combinaison réalisée après le lancer du joueur est une Grande Suite
+ * C'est à dire LONGUEUR_GRANDE_SUITE (5) dés dont la valeur se suit
+ */
+bool grande_suite(t_des des) {
+    bool resultat;
+    int occurences[NOMBRE_FACES];
+
+    compter_des(des, occurences);
+
+    for (int i = 0; i <= NOMBRE_FACES - LONGUEUR_GRANDE_SUITE; i++) {
+        resultat = true;
+        for (int j = i; j < i + LONGUEUR_GRANDE_SUITE; j++) {
+            if (occurences[j] == 0) {
+                resultat = false;
+            }
+        }
+
+        if (resultat) {
+            break;
+        }
+    }
+
+    return resultat;
+}
+
+/**
+ * @fn bool yams(t_des des)
+ * 
+ * @brief Cette fonction détermine si la combinaison effectuée par le joueur est un Yams
+ * 
+ * @param des Les 5 dés lancés par le joueur
+ * @return true si la combinaison est un Yams
+ * @return false dans les autres cas
+ * 
+ * Consiste à déterminer si la combinaison réalisée après le lancer du joueur est un Yams
+ * C'est à dire NOMBRE_DES dés de la même valeur
+ */
+bool yams(t_des des) {
+    bool resultat;
+    int occurences[NOMBRE_FACES];
+
+    resultat = false;
+
+    compter_des(des, occurences);
+    for (int i = 0; i < NOMBRE_FACES; i++) {
+        if (occurences[i] == NOMBRE_DES) {
+            resultat = true;
+        }
+    }
+
+    return resultat;
+}
+
+/**
+ * @fn int compter_points(int combinaison, t_des des)
+ * 
+ * @brief Cette fonction sert à compter les points que le joueur à fait avec son lancer
+ * 
+ * @param combinaison Le numéro, ou indice de la combinaison dans le tableau
+ * @param des Les 5 dés lancés par le joueur
+ * @return int le score obtenu
+ * 
+ * Consiste à compter les points marqués par le joueur avec son lance en fonction des combinaisons réalisées s'il y en a 
+ * ou sinon par les points indiqués sur les dés
+ */
+int compter_points(int combinaison, t_des des) {
+    int occurences[NOMBRE_FACES];
+    int resultat;
+
+    compter_des(des, occurences);
+    resultat = 0;
+
+    switch (combinaison) {
+    case 0 :
+    case 1 :
+    case 2 :
+    case 3 :
+    case 4 :
+    case 5 :
+        resultat = occurences[combinaison] * (combinaison + 1);
+        break;
+
+    case 6 :
+        if (brelan(des)) {
+            for (int i = 0; i < NOMBRE_DES; i++) {
+                if(occurences[des[i] - 1] >= 3) {
+                    resultat = resultat + des[i];
+                }
+            }
+        }
+        break;
+
+    case 7 :
+        if (carre(des)) {
+            for (int i = 0; i < NOMBRE_DES; i++) {
+                if(occurences[des[i] - 1] >= 4) {
+                    resultat = resultat + des[i];
+                }
+            }
+        }
+        
+        break;
+
+    case 8 :
+        if (full_house(des)) {
+            resultat = POINTS_FULL;
+        }
+        break;
+    
+    case 9 :
+        if (petite_suite(des)) {
+            resultat = POINTS_PETITE_SUITE;
+        }
+        break;
+
+    case 10 :
+        if (grande_suite(des)) {
+            resultat = POINTS_GRANDE_SUITE;
+        }
+        break;
+
+    case 11 :
+        if (yams(des)) {
+            resultat = POINTS_YAMS;
+        }
+        break;
+
+    case 12 :
+        for (int i = 0; i < NOMBRE_DES; i++) {
+            resultat = resultat + des[i];
+        }
+        break;
+
+    default:
+        break;
+    }
+
+    return resultat;
+}
+
+/**
+ * @fn void initialiser_feuilles(t_feuilles *feuilles, int nombre_joueurs, int *cases, t_etat_joueur *etats)
+ * 
+ * @brief Cette procédure prépare les feuilles de score vides d'une partie
+ * 
+ * @param feuilles Les feuilles de score
+ * @param nombre_joueurs Le nombre de joueurs
+ * @param cases La mémoire des cases, TAILLE_FEUILLES(nombre_joueurs) entiers
+ * @param etats La mémoire des états résumés, nombre_joueurs états
+ */
+void initialiser_feuilles(t_feuilles *feuilles, int nombre_joueurs, int *cases, t_etat_joueur *etats) {
+    feuilles->nombre_joueurs = nombre_joueurs;
+    feuilles->etats = etats;
+
+    for (int j = 0; j < nombre_joueurs; j++) {
+        etats[j] = 0;
+    }
+
+    for (int c = 0; c < 13; c++) {
+        feuilles->cases[c] = cases + (size_t) c * nombre_joueurs;
+    }
+    for (size_t i = 0; i < TAILLE_FEUILLES(nombre_joueurs); i++) {
+        cases[i] = -1;
+    }
+}
+
+/**
+ * @fn void lire_feuille(const t_feuilles *feuilles, int joueur, t_score feuille)
+ * 
+ * @brief Cette procédure copie la feuille de score d'un joueur
+ * 
+ * @param feuilles Les feuilles de score
+ * @param joueur L'indice du joueur
+ * @param feuille La feuille du joueur, au format t_score attendu par les règles et les stratégies
+ */
+void lire_feuille(const t_feuilles *feuilles, int joueur, t_score feuille) {
+    for (int c = 0; c < 13; c++) {
+        feuille[c] = feuilles->cases[c][joueur];
+    }
+}
+
+/**
+ * @fn void calculer_totaux(const t_feuilles *feuilles, int *totaux)
+ * 
+ * @brief Cette procédure donne le total de chaque joueur, bonus compris
+ * 
+ * @param feuilles Les feuilles de score
+ * @param totaux Le total de chaque joueur, nombre_joueurs entiers
+ * 
+ * Les totaux sont lus dans les états résumés, tenus à jour case par case : aucune feuille n'est relue
+ */
+void calculer_totaux(const t_feuilles *feuilles, int *totaux) {
+    for (int j = 0; j < feuilles->nombre_joueurs; j++) {
+        totaux[j] = ETAT_TOTAL(feuilles->etats[j]);
+    }
+}
+
+/**
+ * @fn int trouver_vainqueurs(const t_feuilles *feuilles, int *totaux)
+ * 
+ * @brief Cette fonction détermine quel joueur a remporté la partie
+ * 
+ * @param feuilles Les feuilles de score
+ * @param totaux Reçoit le total de chaque joueur, nombre_joueurs entiers
+ * @return int l'indice du vainqueur, le premier des joueurs à égalité
+ * 
+ * Consiste à dire quel joueur a gagné la partie, celui qui a le total le plus élevé, bonus compris
+ */
+int trouver_vainqueurs(const t_feuilles *feuilles, int *totaux) {
+    int indice_vainqueurs;
+
+    calculer_totaux(feuilles, totaux);
+
+    indice_vainqueurs = 0;
+    for (int j = 1; j < feuilles->nombre_joueurs; j++) {
+        if (totaux[j] > totaux[indice_vainqueurs]) {
+            indice_vainqueurs = j;
+        }
+    }
+
+    return indice_vainqueurs;
+}
+
+/**
+ * @fn t_etat_joueur ajouter_points(t_etat_joueur etat, int combinaison, int points)
+ * 
+ * @brief Cette fonction met à jour l'état résumé d'une feuille quand une combinaison est remplie
+ * 
+ * @param etat L'état avant de remplir la combinaison, qui doit être libre
+ * @param combinaison L'indice de la combinaison
+ * @param points Les points marqués, 0 pour une combinaison barrée
+ * @return t_etat_joueur l'état une fois la combinaison remplie
+ */
+t_etat_joueur ajouter_points(t_etat_joueur etat, int combinaison, int points) {
+    int total_sup;
+
+    etat = etat | ((t_etat_joueur) 1 << (6 + combinaison));
+    if (combinaison >= 6) {
+        return etat + ((t_etat_joueur) points << 27);
+    }
+
+    total_sup = ETAT_TOTAL_SUP(etat) + points;
+    etat = etat + ((t_etat_joueur) points << 19);
+    return (etat & ~(t_etat_joueur) 63) | (total_sup > 63 ? 63 : total_sup);
+}
+
+/**
+ * @fn t_etat_joueur resumer_feuille(t_score scores)
+ * 
+ * @brief Cette fonction calcule l'état résumé d'une feuille de score complète
+ * 
+ * @param scores La feuille de score
+ * @return t_etat_joueur l'état résumé de la feuille
+ * 
+ * Ne sert que lorsque seule la feuille est connue, les parties tiennent l'état à jour avec ajouter_points
+ */
+t_etat_joueur resumer_feuille(t_score scores) {
+    t_etat_joueur etat;
+
+    etat = 0;
+    for (int i = 0; i < 13; i++) {
+        if (scores[i] != -1) {
+            etat = ajouter_points(etat, i, scores[i]);
+        }
+    }
+
+    return etat;
+}
+
+/**
+ * @fn uint64_t hacher_etat(t_etat_joueur etat)
+ * 
+ * @brief Cette fonction calcule le hachage d'un état résumé, pour les tables de hachage et les caches
+ * 
+ * @param etat L'état résumé
+ * @return uint64_t le hachage, dont tous les bits dépendent de tous les bits de l'état
+ * 
+ * Utilise la fonction de mélange finale de splitmix64
+ */
+uint64_t hacher_etat(t_etat_joueur etat) {
+    etat = (etat ^ (etat >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    etat = (etat ^ (etat >> 27)) * 0x94D049BB133111EBULL;
+    return etat ^ (etat >> 31);
+}
+
+/**
+ * @fn void entrer_points(t_score scores, t_etat_joueur *etat, int combinaison, int points)
+ * 
+ * @brief Cette procédure sert à entrer les points marqués dans la feuille de score
+ * 
+ * @param scores La feuille de score
+ * @param etat L'état résumé de la feuille, mis à jour
+ * @param combinaison L'indice de la combinaison dans le tableau
+ * @param points Points marqués par le joueur
+ * 
+ * Consiste à entrer le score marqué par le joueur dans le tableau/feuille de score
+ */
+void entrer_points(t_score scores, t_etat_joueur *etat, int combinaison, int points) {
+    scores[combinaison] = points;
+    *etat = ajouter_points(*etat, combinaison, points);
+}
+
+/**
+ * @fn void combinaisons_possibles(t_des des, int combinaisons[13], int *nombre_combinaisons)
+ * 
+ * @brief Cette procédure détermine quelles combinaisons sont possibles à marquer par le joueur en fonction de son lancer
+ * 
+ * @param des Les 5 dés lancés par le joueur
+ * @param combinaisons Les 13 combinaisons possibles
+ * @param nombre_combinaisons Le nombre de combinaisons possibles
+ * 
+ * Consiste à déterminer quelles combinaisons sont possibles à valider par le joueur, 
+ * en effet le résultat d'un lancer peut correspondre à plusieurs combinaisons, ce sont ces 
+ * combinaisons qui seront indiquées
+ */
+void combinaisons_possibles(t_des des, int combinaisons[13], int *nombre_combinaisons) {
+    int occurences[NOMBRE_FACES];
+
+    *nombre_combinaisons = 0;
+    combinaisons[*nombre_combinaisons] = 12;
+    *nombre_combinaisons = 1;
+
+    if(brelan(des)) {
+        combinaisons[*nombre_combinaisons] = 6;
+        *nombre_combinaisons = *nombre_combinaisons +1;
+    }
+
+    if (carre(des)) {
+        combinaisons[*nombre_combinaisons] = 7;
+        *nombre_combinaisons = *nombre_combinaisons + 1;
+    }
+
+    if (full_house(des)) {
+        combinaisons[*nombre_combinaisons] = 8;
+        *nombre_combinaisons = *nombre_combinaisons + 1;
+    }
+
+    if (petite_suite(des)) {
+        combinaisons[*nombre_combinaisons] = 9;
+        *nombre_combinaisons = *nombre_combinaisons + 1;
+    }
+
+    if (grande_suite(des)) {
+        combinaisons[*nombre_combinaisons] = 10;
+        *nombre_combinaisons = *nombre_combinaisons + 1;
+    }
+
+    if (yams(des)) {
+        combinaisons[*nombre_combinaisons] = 11;
+        *nombre_combinaisons = *nombre_combinaisons + 1;
+    }
+
+    compter_des(des, occurences);
+
+    for(int i = 0; i < 6; i++) {
+        if(occurences[i] >= 1) {
+            combinaisons[*nombre_combinaisons] = i;
+            *nombre_combinaisons = *nombre_combinaisons + 1;
+        }
+    }
+}
+
+/**
+ * @fn void lancer_des(int nombre, t_des des, t_generateur *generateur)
+ * 
+ * @brief Cette procédure sert à lancer les dés
+ * 
+ * @param nombre Le nombre de dés qui est à lancer, il peut être de 5 ou moins si le joueur décide de relancer certains dés
+ * @param des Les 5 dés à lancer
+ * @param generateur Le générateur de dés
+ * 
+ * Consiste à lancer les dés d'un joueur
+ */
+void lancer_des(int nombre, t_des des, t_generateur *generateur) {
+    for (int i = 0; i < NOMBRE_DES; i++) {
+        des[i] = -1;
+    }
+    for (int i = 0; i < nombre; i++) {
+        des[i] = tirer_face(generateur);
+    }
+}
+
+/**
+ * @fn int calculer_total(t_score scores)
+ * 
+ * @brief Cette fonction calcule le total d'une feuille de score, bonus compris
+ * 
+ * @param scores La feuille de score
+ * @return int le total des cases remplies, plus 35 points de bonus si la partie supérieure dépasse 62
+ * 
+ * Reprend les règles de calcul de afficher_scores sans rien afficher, les cases vides (-1) comptant pour 0
+ */
+int calculer_total(t_score scores) {
+    int total_sup;
+    int total_inf;
+
+    total_sup = 0;
+    total_inf = 0;
+
+    for (int i = 0; i < 6; i++) {
+        if (scores[i] != -1) {
+            total_sup = total_sup + scores[i];
+        }
+    }
+
+    for (int i = 6; i < 13; i++) {
+        if (scores[i] != -1) {
+            total_inf = total_inf + scores[i];
+        }
+    }
+
+    if (total_sup > 62) {
+        total_sup = total_sup + 35;
+    }
+
+    return total_sup + total_inf;
+}
+
+/**
+ * @fn void relancer_des(int masque, t_des des, t_generateur *generateur)
+ * 
+ * @brief Cette procédure relance les dés désignés par un masque
+ * 
+ * @param masque Le masque des dés à relancer, le bit i désigne le dé i
+ * @param des Les 5 dés du joueur, modifiés sur place
+ * @param generateur Le générateur de dés
+ */
+void relancer_des(int masque, t_des des, t_generateur *generateur) {
+    for (int i = 0; i < NOMBRE_DES; i++) {
+        if (masque & (1 << i)) {
+            des[i] = tirer_face(generateur);
+        }
+    }
+}
+
+/*********************************
+ *       TABLE DES POINTS        *
+ *********************************/
+
+/**
+ * @brief Les NOMBRE_MAINS mains possibles (252 au jeu classique), dés triés par ordre croissant, dans l'ordre
+ * lexicographique
+ * 
+ */
+t_des MAINS[NOMBRE_MAINS];
+
+/**
+ * @brief Le nombre de lancers ordonnés qui donnent chaque main, sur les NOMBRE_LANCERS lancers possibles
+ * 
+ */
+int LANCERS_PAR_MAIN[NOMBRE_MAINS];
+
+/**
+ * @brief L'indice de la main correspondant à chaque lancer ordonné, voir code_lancer
+ * 
+ */
+uint16_t INDICE_PAR_LANCER[NOMBRE_LANCERS];
+
+/**
+ * @brief Les points des 13 combinaisons et le masque des combinaisons réalisées, pour chaque main
+ * 
+ */
+t_ligne_points TABLE_POINTS[NOMBRE_MAINS];
+
+/**
+ * @fn int code_lancer(t_des des)
+ * 
+ * @brief Cette fonction code un lancer ordonné des dés en un entier de 0 à NOMBRE_LANCERS - 1
+ * 
+ * @param des Les 5 dés lancés par le joueur
+ * @return int le code du lancer, les dés étant lus comme les chiffres d'un nombre en base NOMBRE_FACES
+ */
+int code_lancer(t_des des) {
+    int code;
+
+    code = 0;
+    DEROULER
+    for (int i = 0; i < NOMBRE_DES; i++) {
+        code = code * NOMBRE_FACES + des[i] - 1;
+    }
+
+    return code;
+}
+
+/**
+ * @fn int indice_main(t_des des)
+ * 
+ * @brief Cette fonction donne l'indice de la main correspondant aux dés, quel que soit leur ordre
+ * 
+ * @param des Les 5 dés lancés par le joueur
+ * @return int l'indice de la main, de 0 à NOMBRE_MAINS - 1, dans MAINS et TABLE_POINTS
+ */
+int indice_main(t_des des) {
+    return INDICE_PAR_LANCER[code_lancer(des)];
+}
+
+/**
+ * @fn void initialiser_table_points(void)
+ * 
+ * @brief Cette procédure construit la table des points une fois pour toutes au démarrage du programme
+ * 
+ * Consiste à énumérer les mains, à associer chacun des lancers ordonnés à sa main, puis à remplir
+ * la table à partir de compter_points et combinaisons_possibles, qui restent la référence des règles.
+ * Elle doit être appelée avant tout usage de indice_main ou de TABLE_POINTS.
+ */
+void initialiser_table_points(void) {
+    int combinaisons[13];
+    int nombre_combinaisons;
+    t_des des;
+    t_des des_tries;
+
+    for (int i = 0; i < NOMBRE_DES; i++) {
+        des[i] = 1;
+    }
+
+    for (int m = 0; m < NOMBRE_MAINS; m++) {
+        int i;
+
+        for (i = 0; i < NOMBRE_DES; i++) {
+            MAINS[m][i] = des[i];
+        }
+        INDICE_PAR_LANCER[code_lancer(des)] = m;
+        LANCERS_PAR_MAIN[m] = 0;
+
+        i = NOMBRE_DES - 1;
+        while (i > 0 && des[i] == NOMBRE_FACES) {
+            i = i - 1;
+        }
+        des[i] = des[i] + 1;
+        for (int j = i + 1; j < NOMBRE_DES; j++) {
+            des[j] = des[i];
+        }
+    }
+
+    for (int code = 0; code < NOMBRE_LANCERS; code++) {
+        int reste;
+        int indice;
+
+        reste = code;
+        for (int i = NOMBRE_DES - 1; i >= 0; i--) {
+            des[i] = reste % NOMBRE_FACES + 1;
+            reste = reste / NOMBRE_FACES;
+        }
+
+        trier_des(des, des_tries);
+        indice = INDICE_PAR_LANCER[code_lancer(des_tries)];
+
+        INDICE_PAR_LANCER[code] = indice;
+        LANCERS_PAR_MAIN[indice] = LANCERS_PAR_MAIN[indice] + 1;
+    }
+
+    for (int m = 0; m < NOMBRE_MAINS; m++) {
+        for (int c = 0; c < 13; c++) {
+            TABLE_POINTS[m].points[c] = compter_points(c, MAINS[m]);
+        }
+
+        combinaisons_possibles(MAINS[m], combinaisons, &nombre_combinaisons);
+        TABLE_POINTS[m].nombre_combinaisons = nombre_combinaisons;
+        TABLE_POINTS[m].combinaisons = 0;
+        for (int i = 0; i < nombre_combinaisons; i++) {
+            TABLE_POINTS[m].combinaisons = TABLE_POINTS[m].combinaisons | (1 << combinaisons[i]);
+        }
+    }
+}
+
+/**
+ * @brief Le nombre de dés de chaque face pour chacune des gardes, rangées par nombre de dés croissant
+ * 
+ */
+uint8_t GARDES[NOMBRE_GARDES][NOMBRE_FACES];
+
+/**
+ * @brief Le nombre de dés de chaque garde
+ * 
+ */
+uint8_t TAILLE_GARDE[NOMBRE_GARDES];
+
+/**
+ * @brief La garde obtenue en ajoutant un dé de chaque face à une garde, -1 si la garde compte déjà tous les dés
+ * 
+ */
+int16_t GARDE_PLUS_FACE[NOMBRE_GARDES][NOMBRE_FACES];
+
+/**
+ * @brief L'indice de la main formée par une garde de tous les dés, -1 pour les autres gardes
+ * 
+ */
+int16_t MAIN_PAR_GARDE[NOMBRE_GARDES];
+
+/**
+ * @brief Les gardes distinctes accessibles depuis chaque main, parmi les NOMBRE_MASQUES façons de garder ses dés
+ * 
+ */
+int16_t GARDES_PAR_MAIN[NOMBRE_MAINS][NOMBRE_MASQUES];
+
+/**
+ * @brief Le nombre de gardes distinctes accessibles depuis chaque main
+ * 
+ */
+uint8_t NOMBRE_GARDES_PAR_MAIN[NOMBRE_MAINS];
+
+/**
+ * @brief L'indice de la garde correspondant à chaque histogramme, voir code_histogramme, -1 s'il compte plus de
+ * NOMBRE_DES dés
+ * 
+ */
+int16_t INDICE_PAR_HISTOGRAMME[NOMBRE_HISTOGRAMMES];
+
+/**
+ * @brief La contribution d'un dé de chaque face au code d'un histogramme, voir code_histogramme
+ * 
+ * POIDS_FACE[f] vaut (NOMBRE_DES + 1) puissance f - 1, soit {0, 1, 6, 36, 216, 1296, 7776} au jeu classique
+ * 
+ */
+int POIDS_FACE[NOMBRE_FACES + 1];
+
+/**
+ * @fn int code_histogramme(t_des des, int masque)
+ * 
+ * @brief Cette fonction code l'histogramme des dés gardés en un entier de 0 à NOMBRE_HISTOGRAMMES - 1
+ * 
+ * @param des Les 5 dés du joueur
+ * @param masque Le masque des dés gardés, le bit i désigne le dé i
+ * @return int le code de l'histogramme, le nombre de dés de chaque face étant lu comme un chiffre en base
+ * NOMBRE_DES + 1
+ */
+int code_histogramme(t_des des, int masque) {
+    int code;
+
+    code = 0;
+    DEROULER
+    for (int i = 0; i < NOMBRE_DES; i++) {
+        if (masque & (1 << i)) {
+            code = code + POIDS_FACE[des[i]];
+        }
+    }
+
+    return code;
+}
+
+/**
+ * @fn void initialiser_gardes(void)
+ * 
+ * @brief Cette procédure construit les tables des gardes une fois pour toutes au démarrage du programme
+ * 
+ * Une garde est l'ensemble des dés que le joueur conserve avant de relancer les autres. Consiste à énumérer les
+ * NOMBRE_GARDES gardes par nombre de dés croissant, à relier chaque garde aux gardes plus grandes d'un dé et chaque
+ * main aux gardes qu'elle permet. Elle doit être appelée après initialiser_table_points.
+ */
+void initialiser_gardes(void) {
+    int nombre_gardes;
+
+    nombre_gardes = 0;
+
+    POIDS_FACE[0] = 0;
+    POIDS_FACE[1] = 1;
+    for (int f = 2; f <= NOMBRE_FACES; f++) {
+        POIDS_FACE[f] = (NOMBRE_DES + 1) * POIDS_FACE[f - 1];
+    }
+
+    for (int code = 0; code < NOMBRE_HISTOGRAMMES; code++) {
+        INDICE_PAR_HISTOGRAMME[code] = -1;
+    }
+
+    for (int taille = 0; taille <= NOMBRE_DES; taille++) {
+        for (int code = 0; code < NOMBRE_HISTOGRAMMES; code++) {
+            uint8_t histogramme[NOMBRE_FACES];
+            int reste;
+            int somme;
+
+            reste = code;
+            somme = 0;
+            for (int f = 0; f < NOMBRE_FACES; f++) {
+                histogramme[f] = reste % (NOMBRE_DES + 1);
+                somme = somme + reste % (NOMBRE_DES + 1);
+                reste = reste / (NOMBRE_DES + 1);
+            }
+
+            if (somme == taille) {
+                memcpy(GARDES[nombre_gardes], histogramme, sizeof(histogramme));
+                TAILLE_GARDE[nombre_gardes] = taille;
+                INDICE_PAR_HISTOGRAMME[code] = nombre_gardes;
+                nombre_gardes = nombre_gardes + 1;
+            }
+        }
+    }
+
+    for (int g = 0; g < NOMBRE_GARDES; g++) {
+        int code;
+
+        code = 0;
+        for (int f = 0; f < NOMBRE_FACES; f++) {
+            code = code + GARDES[g][f] * POIDS_FACE[f + 1];
+        }
+
+        for (int f = 0; f < NOMBRE_FACES; f++) {
+            GARDE_PLUS_FACE[g][f] = -1;
+            if (TAILLE_GARDE[g] < NOMBRE_DES) {
+                GARDE_PLUS_FACE[g][f] = INDICE_PAR_HISTOGRAMME[code + POIDS_FACE[f + 1]];
+            }
+        }
+
+        MAIN_PAR_GARDE[g] = -1;
+        if (TAILLE_GARDE[g] == NOMBRE_DES) {
+            t_des des;
+            int n;
+
+            n = 0;
+            for (int f = 0; f < NOMBRE_FACES; f++) {
+                for (int k = 0; k < GARDES[g][f]; k++) {
+                    des[n] = f + 1;
+                    n = n + 1;
+                }
+            }
+            MAIN_PAR_GARDE[g] = indice_main(des);
+        }
+    }
+
+    for (int m = 0; m < NOMBRE_MAINS; m++) {
+        NOMBRE_GARDES_PAR_MAIN[m] = 0;
+
+        for (int masque = 0; masque < NOMBRE_MASQUES; masque++) {
+            int garde;
+            bool deja_vue;
+
+            garde = INDICE_PAR_HISTOGRAMME[code_histogramme(MAINS[m], masque)];
+            deja_vue = false;
+            for (int k = 0; k < NOMBRE_GARDES_PAR_MAIN[m]; k++) {
+                if (GARDES_PAR_MAIN[m][k] == garde) {
+                    deja_vue = true;
+                }
+            }
+
+            if (!deja_vue) {
+                GARDES_PAR_MAIN[m][NOMBRE_GARDES_PAR_MAIN[m]] = garde;
+                NOMBRE_GARDES_PAR_MAIN[m] = NOMBRE_GARDES_PAR_MAIN[m] + 1;
+            }
+        }
+    }
+}
+
+/*********************************
+ *     PROBABILITÉS EXACTES      *
+ *********************************/
+
+/**
+ * @brief La position dans TRANSITIONS des transitions de chaque garde, celles de la garde g allant de
+ * DEBUT_TRANSITIONS[g] inclus à DEBUT_TRANSITIONS[g + 1] exclu
+ * 
+ */
+int32_t DEBUT_TRANSITIONS[NOMBRE_GARDES + 1];
+
+/**
+ * @brief Les mains que peut donner chaque garde quand les autres dés sont relancés, avec leur probabilité
+ * 
+ * Une garde de k dés mène à autant de mains qu'il y a de multi-ensembles de NOMBRE_DES - k dés, une garde de tous
+ * les dés à sa propre main avec une probabilité de 1. Au jeu classique, les 252 x 32 façons de garder les dés
+ * d'une main se ramènent ainsi aux 462 gardes distinctes, soit 4368 transitions au total.
+ * 
+ */
+t_transition TRANSITIONS[NOMBRE_TRANSITIONS];
+
+/**
+ * @brief La probabilité de réaliser chaque combinaison en partant d'une main, selon le nombre de relances restantes
+ * 
+ * PROBABILITES_MAIN[r][m][c] suppose que le joueur garde à chaque relance les dés qui maximisent ses chances de
+ * réaliser la combinaison c. Une combinaison est réalisée quand elle figure dans combinaisons_possibles.
+ * 
+ */
+double PROBABILITES_MAIN[NOMBRE_RELANCES + 1][NOMBRE_MAINS][13];
+
+/**
+ * @brief La probabilité de réaliser chaque combinaison en relançant les dés qui ne sont pas dans une garde, la
+ * relance comprise dans le nombre de relances restantes
+ * 
+ */
+double PROBABILITES_GARDE[NOMBRE_RELANCES + 1][NOMBRE_GARDES][13];
+
+/**
+ * @brief La garde qui maximise les chances de réaliser chaque combinaison depuis une main, selon le nombre de
+ * relances restantes, la garde de tous les dés si le joueur doit s'arrêter
+ * 
+ */
+int16_t GARDE_VISEE[NOMBRE_RELANCES + 1][NOMBRE_MAINS][13];
+
+/**
+ * @fn void initialiser_transitions(void)
+ * 
+ * @brief Cette procédure construit les transitions des gardes vers les mains une fois pour toutes au démarrage du
+ * programme
+ * 
+ * Consiste à compter, pour chaque garde, les lancers ordonnés des dés manquants qui mènent à chaque main en
+ * ajoutant les dés un par un avec GARDE_PLUS_FACE. Les probabilités sont des quotients exacts par une puissance
+ * de NOMBRE_FACES. Elle doit être appelée après initialiser_gardes.
+ */
+void initialiser_transitions(void) {
+    uint32_t nombres[NOMBRE_GARDES];
+    uint32_t suivants[NOMBRE_GARDES];
+    uint32_t denominateur;
+    int nombre_transitions;
+
+    nombre_transitions = 0;
+
+    for (int g = 0; g < NOMBRE_GARDES; g++) {
+        memset(nombres, 0, sizeof(nombres));
+        nombres[g] = 1;
+        denominateur = 1;
+
+        for (int d = TAILLE_GARDE[g]; d < NOMBRE_DES; d++) {
+            memset(suivants, 0, sizeof(suivants));
+            for (int x = 0; x < NOMBRE_GARDES; x++) {
+                if (nombres[x] > 0) {
+                    for (int f = 0; f < NOMBRE_FACES; f++) {
+                        suivants[GARDE_PLUS_FACE[x][f]] = suivants[GARDE_PLUS_FACE[x][f]] + nombres[x];
+                    }
+                }
+            }
+            memcpy(nombres, suivants, sizeof(nombres));
+            denominateur = NOMBRE_FACES * denominateur;
+        }
+
+        DEBUT_TRANSITIONS[g] = nombre_transitions;
+        for (int x = 0; x < NOMBRE_GARDES; x++) {
+            if (nombres[x] > 0) {
+                TRANSITIONS[nombre_transitions].main = MAIN_PAR_GARDE[x];
+                TRANSITIONS[nombre_transitions].probabilite = (double) nombres[x] / denominateur;
+                nombre_transitions = nombre_transitions + 1;
+            }
+        }
+    }
+    DEBUT_TRANSITIONS[NOMBRE_GARDES] = nombre_transitions;
+}
+
+/**
+ * @fn void initialiser_probabilites(void)
+ * 
+ * @brief Cette procédure calcule les probabilités de réaliser chaque combinaison depuis chaque main et chaque
+ * garde, une fois pour toutes au démarrage du programme
+ * 
+ * Programmation dynamique sur le nombre de relances restantes : sans relance, une main réalise ou non la
+ * combinaison ; une garde vaut la moyenne des mains qu'elle peut donner au niveau inférieur, pondérée par ses
+ * transitions, et une main vaut la meilleure des gardes qu'elle permet. Elle doit être appelée après
+ * initialiser_transitions.
+ */
+void initialiser_probabilites(void) {
+    for (int m = 0; m < NOMBRE_MAINS; m++) {
+        for (int c = 0; c < 13; c++) {
+            PROBABILITES_MAIN[0][m][c] = (TABLE_POINTS[m].combinaisons & (1 << c)) ? 1.0 : 0.0;
+            GARDE_VISEE[0][m][c] = INDICE_PAR_HISTOGRAMME[code_histogramme(MAINS[m], MASQUE_DES)];
+        }
+    }
+
+    for (int r = 1; r <= NOMBRE_RELANCES; r++) {
+        for (int g = 0; g < NOMBRE_GARDES; g++) {
+            for (int c = 0; c < 13; c++) {
+                PROBABILITES_GARDE[r][g][c] = 0.0;
+            }
+            for (int t = DEBUT_TRANSITIONS[g]; t < DEBUT_TRANSITIONS[g + 1]; t++) {
+                for (int c = 0; c < 13; c++) {
+                    PROBABILITES_GARDE[r][g][c] = PROBABILITES_GARDE[r][g][c]
+                                                  + TRANSITIONS[t].probabilite
+                                                    * PROBABILITES_MAIN[r - 1][TRANSITIONS[t].main][c];
+                }
+            }
+        }
+
+        for (int m = 0; m < NOMBRE_MAINS; m++) {
+            for (int c = 0; c < 13; c++) {
+                PROBABILITES_MAIN[r][m][c] = -1.0;
+                for (int k = 0; k < NOMBRE_GARDES_PAR_MAIN[m]; k++) {
+                    int garde;
+
+                    garde = GARDES_PAR_MAIN[m][k];
+                    if (PROBABILITES_GARDE[r][garde][c] > PROBABILITES_MAIN[r][m][c]) {
+                        PROBABILITES_MAIN[r][m][c] = PROBABILITES_GARDE[r][garde][c];
+                        GARDE_VISEE[r][m][c] = garde;
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @fn void probabilites_combinaisons(t_des des, int masque, int relances, double probabilites[13])
+ * 
+ * @brief Cette procédure donne la probabilité exacte de réaliser chaque combinaison avant la fin du tour
+ * 
+ * @param des Les 5 dés du joueur
+ * @param masque Le masque des dés gardés pour la prochaine relance, le bit i désigne le dé i
+ * @param relances Le nombre de relances restantes, la prochaine comprise ; 0 pour s'arrêter sur les dés
+ * @param probabilites Reçoit la probabilité de chaque combinaison, le joueur visant cette combinaison aux
+ *                     relances suivantes
+ * 
+ * Ne fait que lire les 13 probabilités de la garde dans PROBABILITES_GARDE, ce qui permet de l'appeler à chaque
+ * décision d'une simulation
+ */
+void probabilites_combinaisons(t_des des, int masque, int relances, double probabilites[13]) {
+    const double *ligne;
+
+    if (relances == 0) {
+        ligne = PROBABILITES_MAIN[0][indice_main(des)];
+    }
+    else {
+        ligne = PROBABILITES_GARDE[relances][INDICE_PAR_HISTOGRAMME[code_histogramme(des, masque)]];
+    }
+
+    for (int c = 0; c < 13; c++) {
+        probabilites[c] = ligne[c];
+    }
+}
+
+/**
+ * @fn void distribuer_mains(t_des des, int masque, int relances, int objectif, double distribution[NOMBRE_MAINS])
+ * 
+ * @brief Cette procédure donne la loi exacte de la main obtenue à la fin du tour
+ * 
+ * @param des Les 5 dés du joueur
+ * @param masque Le masque des dés gardés pour la prochaine relance, le bit i désigne le dé i
+ * @param relances Le nombre de relances restantes, la prochaine comprise ; 0 pour s'arrêter sur les dés
+ * @param objectif La combinaison visée aux relances suivantes, -1 pour s'arrêter après la prochaine relance
+ * @param distribution Reçoit la probabilité de chaque main, indicée comme MAINS
+ * 
+ * Consiste à partir des transitions de la garde, puis à faire suivre à chaque main la garde de GARDE_VISEE pour
+ * chaque relance restante. La somme de distribution sur les mains qui réalisent l'objectif est la probabilité
+ * donnée par probabilites_combinaisons
+ */
+void distribuer_mains(t_des des, int masque, int relances, int objectif, double distribution[NOMBRE_MAINS]) {
+    double suivante[NOMBRE_MAINS];
+    int garde;
+
+    for (int m = 0; m < NOMBRE_MAINS; m++) {
+        distribution[m] = 0.0;
+    }
+    if (relances == 0) {
+        distribution[indice_main(des)] = 1.0;
+        return;
+    }
+
+    garde = INDICE_PAR_HISTOGRAMME[code_histogramme(des, masque)];
+    for (int t = DEBUT_TRANSITIONS[garde]; t < DEBUT_TRANSITIONS[garde + 1]; t++) {
+        distribution[TRANSITIONS[t].main] = TRANSITIONS[t].probabilite;
+    }
+
+    if (objectif < 0) {
+        return;
+    }
+    for (int r = relances - 1; r >= 1; r--) {
+        for (int m = 0; m < NOMBRE_MAINS; m++) {
+            suivante[m] = 0.0;
+        }
+        for (int m = 0; m < NOMBRE_MAINS; m++) {
+            if (distribution[m] > 0.0) {
+                garde = GARDE_VISEE[r][m][objectif];
+                for (int t = DEBUT_TRANSITIONS[garde]; t < DEBUT_TRANSITIONS[garde + 1]; t++) {
+                    suivante[TRANSITIONS[t].main] = suivante[TRANSITIONS[t].main]
+                                                    + distribution[m] * TRANSITIONS[t].probabilite;
+                }
+            }
+        }
+        for (int m = 0; m < NOMBRE_MAINS; m++) {
+            distribution[m] = suivante[m];
+        }
+    }
+}
+
+/*********************************
+ *       POINTS PAR LOTS         *
+ *********************************/
+
+/**
+ * @fn void points_lot_scalaire(t_lot_mains *lot, size_t debut)
+ * 
+ * @brief Cette procédure calcule les points des 13 combinaisons d'un lot de mains, une main à la fois
+ * 
+ * @param lot Le lot de mains
+ * @param debut L'indice de la première main à traiter, les mains précédentes étant déjà calculées
+ * 
+ * C'est la version de repli, utilisable sur tous les processeurs, qui lit chaque main dans la table des points
+ */
+void points_lot_scalaire(t_lot_mains *lot, size_t debut) {
+    for (size_t k = debut; k < lot->nombre; k++) {
+        t_des des;
+        t_ligne_points *ligne;
+
+        for (int i = 0; i < NOMBRE_DES; i++) {
+            des[i] = lot->des[i][k];
+        }
+
+        ligne = &TABLE_POINTS[indice_main(des)];
+        for (int c = 0; c < 13; c++) {
+            lot->points[c][k] = ligne->points[c];
+        }
+    }
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+
+/**
+ * @brief Représente 16 octets traités ensemble, un par main, dans un registre SSE2
+ * 
+ * Avec les extensions vectorielles du compilateur, une comparaison donne -1 (tous les bits à 1) pour vrai et 0
+ * pour faux, ce qui permet de remplacer chaque condition des règles par un masque
+ * 
+ */
+typedef int8_t t_octets_sse2 __attribute__((vector_size(16)));
+
+/**
+ * @brief Représente 32 octets traités ensemble, un par main, dans un registre AVX2
+ * 
+ */
+typedef int8_t t_octets_avx2 __attribute__((vector_size(32)));
+
+/**
+ * @brief Définit une version du calcul par lots pour un type de vecteur et un jeu d'instructions
+ * 
+ * La procédure définie traite les mains par paquets de la taille du vecteur, puis termine par la version
+ * scalaire. Elle reprend les règles de compter_points sans aucun branchement : le nombre de dés de chaque face
+ * est la somme des comparaisons des dés avec cette face, et chaque combinaison se déduit de ces nombres par des
+ * masques. Les boucles sur les dés et sur les faces ont des bornes connues à la compilation et sont entièrement
+ * déroulées. Le corps est le même pour toutes les versions, seul le compilateur change d'instructions.
+ * 
+ */
+#define DEFINIR_POINTS_LOT(nom, t_octets, cible)                                                               \
+__attribute__((target(cible))) void nom(t_lot_mains *lot, size_t debut) {                                      \
+    size_t k;                                                                                                  \
+                                                                                                               \
+    for (k = debut; k + sizeof(t_octets) <= lot->nombre; k = k + sizeof(t_octets)) {                           \
+        t_octets des[NOMBRE_DES];                                                                              \
+        t_octets presentes[NOMBRE_FACES];                                                                      \
+        t_octets brelan, carre, paire, triple, tous, chance, petite, grande;                                   \
+                                                                                                               \
+        DEROULER                                                                                               \
+        for (int i = 0; i < NOMBRE_DES; i++) {                                                                 \
+            memcpy(&des[i], lot->des[i] + k, sizeof(t_octets));                                                \
+        }                                                                                                      \
+                                                                                                               \
+        chance = des[0] - des[0];                                                                              \
+        brelan = chance;                                                                                       \
+        carre = chance;                                                                                        \
+        paire = chance;                                                                                        \
+        triple = chance;                                                                                       \
+        tous = chance;                                                                                         \
+        petite = chance;                                                                                       \
+        grande = chance;                                                                                       \
+                                                                                                               \
+        DEROULER                                                                                               \
+        for (int i = 0; i < NOMBRE_DES; i++) {                                                                 \
+            chance = chance + des[i];                                                                          \
+        }                                                                                                      \
+                                                                                                               \
+        DEROULER                                                                                               \
+        for (int f = 0; f < NOMBRE_FACES; f++) {                                                               \
+            t_octets occurences;                                                                               \
+            t_octets total;                                                                                    \
+            int8_t face;                                                                                       \
+                                                                                                               \
+            face = f + 1;                                                                                      \
+            occurences = des[0] - des[0];                                                                      \
+            total = occurences;                                                                                \
+            DEROULER                                                                                           \
+            for (int i = 0; i < NOMBRE_DES; i++) {                                                             \
+                t_octets egal;                                                                                 \
+                                                                                                               \
+                egal = des[i] == face;                                                                         \
+                occurences = occurences - egal;                                                                \
+                total = total + (egal & face);                                                                 \
+            }                                                                                                  \
+                                                                                                               \
+            presentes[f] = occurences > 0;                                                                     \
+            if (f < 6) {                                                                                       \
+                memcpy(lot->points[f] + k, &total, sizeof(t_octets));                                          \
+            }                                                                                                  \
+                                                                                                               \
+            brelan = brelan + ((occurences >= 3) & total);                                                     \
+            carre = carre + ((occurences >= 4) & total);                                                       \
+            paire = paire | (occurences == 2);                                                                 \
+            triple = triple | (occurences == 3);                                                               \
+            tous = tous | (occurences == NOMBRE_DES);                                                          \
+        }                                                                                                      \
+                                                                                                               \
+        DEROULER                                                                                               \
+        for (int f = 0; f + LONGUEUR_PETITE_SUITE <= NOMBRE_FACES; f++) {                                      \
+            t_octets suite;                                                                                    \
+                                                                                                               \
+            suite = presentes[f];                                                                              \
+            DEROULER                                                                                           \
+            for (int j = f + 1; j < f + LONGUEUR_PETITE_SUITE; j++) {                                          \
+                suite = suite & presentes[j];                                                                  \
+            }                                                                                                  \
+            petite = petite | suite;                                                                           \
+        }                                                                                                      \
+                                                                                                               \
+        DEROULER                                                                                               \
+        for (int f = 0; f + LONGUEUR_GRANDE_SUITE <= NOMBRE_FACES; f++) {                                      \
+            t_octets suite;                                                                                    \
+                                                                                                               \
+            suite = presentes[f];                                                                              \
+            DEROULER                                                                                           \
+            for (int j = f + 1; j < f + LONGUEUR_GRANDE_SUITE; j++) {                                          \
+                suite = suite & presentes[j];                                                                  \
+            }                                                                                                  \
+            grande = grande | suite;                                                                           \
+        }                                                                                                      \
+                                                                                                               \
+        paire = paire & triple & (int8_t) POINTS_FULL;                                                         \
+        petite = petite & (int8_t) POINTS_PETITE_SUITE;                                                        \
+        grande = grande & (int8_t) POINTS_GRANDE_SUITE;                                                        \
+        tous = tous & (int8_t) POINTS_YAMS;                                                                    \
+                                                                                                               \
+        memcpy(lot->points[6] + k, &brelan, sizeof(t_octets));                                                 \
+        memcpy(lot->points[7] + k, &carre, sizeof(t_octets));                                                  \
+        memcpy(lot->points[8] + k, &paire, sizeof(t_octets));                                                  \
+        memcpy(lot->points[9] + k, &petite, sizeof(t_octets));                                                 \
+        memcpy(lot->points[10] + k, &grande, sizeof(t_octets));                                                \
+        memcpy(lot->points[11] + k, &tous, sizeof(t_octets));                                                  \
+        memcpy(lot->points[12] + k, &chance, sizeof(t_octets));                                                \
+    }                                                                                                          \
+                                                                                                               \
+    points_lot_scalaire(lot, k);                                                                               \
+}
+
+/**
+ * @fn void points_lot_sse2(t_lot_mains *lot, size_t debut)
+ * 
+ * @brief Cette procédure calcule les points d'un lot de mains avec les instructions SSE2, 16 mains à la fois
+ * 
+ * @param lot Le lot de mains
+ * @param debut L'indice de la première main à traiter
+ */
+DEFINIR_POINTS_LOT(points_lot_sse2, t_octets_sse2, "sse2")
+
+/**
+ * @fn void points_lot_avx2(t_lot_mains *lot, size_t debut)
+ * 
+ * @brief Cette procédure calcule les points d'un lot de mains avec les instructions AVX2, 32 mains à la fois
+ * 
+ * @param lot Le lot de mains
+ * @param debut L'indice de la première main à traiter
+ */
+DEFINIR_POINTS_LOT(points_lot_avx2, t_octets_avx2, "avx2")
+
+#endif
+
+/**
+ * @brief La version du calcul par lots choisie pour le processeur, voir choisir_points_lot
+ * 
+ */
+void (*points_lot_choisi)(t_lot_mains *lot, size_t debut) = points_lot_scalaire;
+
+/**
+ * @fn const char *choisir_points_lot(void)
+ * 
+ * @brief Cette fonction choisit la version du calcul par lots la plus rapide que le processeur sait exécuter
+ * 
+ * @return const char* le nom de la version choisie
+ * 
+ * Elle est appelée une fois au démarrage du programme, après initialiser_table_points
+ */
+const char *choisir_points_lot(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx2")) {
+        points_lot_choisi = points_lot_avx2;
+        return "avx2";
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        points_lot_choisi = points_lot_sse2;
+        return "sse2";
+    }
+#endif
+
+    points_lot_choisi = points_lot_scalaire;
+    return "scalaire";
+}
+
+/**
+ * @fn void compter_points_lot(t_lot_mains *lot)
+ * 
+ * @brief Cette procédure calcule les points des 13 combinaisons de toutes les mains d'un lot
+ * 
+ * @param lot Le lot de mains, dont les dés valent de 1 à NOMBRE_FACES
+ * 
+ * Donne les mêmes points que compter_points appelée sur chaque main et chaque combinaison
+ */
+void compter_points_lot(t_lot_mains *lot) {
+    points_lot_choisi(lot, 0);
+}
+
+/**
+ * @fn static void initialiser_tables(void)
+ * 
+ * @brief Cette procédure construit toutes les tables précalculées, voir initialiser_regles
+ */
+static void initialiser_tables(void) {
+    initialiser_table_points();
+    initialiser_gardes();
+    initialiser_transitions();
+    initialiser_probabilites();
+    choisir_points_lot();
+}
+
+/*********************************
+ *   DÉROULEMENT D'UNE PARTIE    *
+ *********************************/
+
+/**
+ * @fn void initialiser_regles(void)
+ * 
+ * @brief Cette procédure construit les tables précalculées et choisit la version du calcul par lots
+ * 
+ * Elle doit être appelée avant toute autre fonction de la bibliothèque. Elle peut être appelée par plusieurs
+ * threads à la fois : les tables ne sont construites qu'une seule fois, et tous les appels rendent la main
+ * une fois les tables prêtes.
+ */
+void initialiser_regles(void) {
+    static pthread_once_t une_fois = PTHREAD_ONCE_INIT;
+
+    pthread_once(&une_fois, initialiser_tables);
+}
+
+/**
+ * @fn void initialiser_partie(t_partie *partie, int nombre_joueurs, int *cases, t_etat_joueur *etats)
+ * 
+ * @brief Cette procédure prépare une nouvelle partie, toutes les feuilles de score étant vides
+ * 
+ * @param partie Le contexte de la partie
+ * @param nombre_joueurs Le nombre de joueurs, au moins 1
+ * @param cases La mémoire des feuilles de score, TAILLE_FEUILLES(nombre_joueurs) entiers fournis par l'appelant
+ * @param etats La mémoire des états résumés, nombre_joueurs états fournis par l'appelant
+ * 
+ * Le générateur de dés de la partie n'est pas modifié : il doit être initialisé par l'appelant, par exemple avec
+ * initialiser_generateur, et peut ainsi continuer d'une partie à la suivante
+ */
+void initialiser_partie(t_partie *partie, int nombre_joueurs, int *cases, t_etat_joueur *etats) {
+    partie->nombre_joueurs = nombre_joueurs;
+    partie->joueur = 0;
+    partie->tour = 0;
+    partie->relances_restantes = 0;
+
+    initialiser_feuilles(&partie->feuilles, nombre_joueurs, cases, etats);
+    for (int i = 0; i < NOMBRE_DES; i++) {
+        partie->des[i] = -1;
+    }
+}
+
+/**
+ * @fn void commencer_tour(t_partie *partie)
+ * 
+ * @brief Cette procédure commence le tour du joueur courant en lançant les 5 dés
+ * 
+ * @param partie Le contexte de la partie
+ */
+void commencer_tour(t_partie *partie) {
+    lancer_des(NOMBRE_DES, partie->des, &partie->generateur);
+    partie->relances_restantes = NOMBRE_RELANCES;
+}
+
+/**
+ * @fn bool relancer_tour(t_partie *partie, int masque)
+ * 
+ * @brief Cette fonction relance les dés désignés par un masque, si le joueur a encore droit à une relance
+ * 
+ * @param partie Le contexte de la partie
+ * @param masque Le masque des dés à relancer, le bit i désigne le dé i
+ * @return true si la relance a eu lieu
+ * @return false si le joueur n'avait plus de relance
+ * 
+ * Comme dans la partie interactive, une relance compte même si aucun dé n'est désigné
+ */
+bool relancer_tour(t_partie *partie, int masque) {
+    if (partie->relances_restantes <= 0) {
+        return false;
+    }
+
+    relancer_des(masque, partie->des, &partie->generateur);
+    partie->relances_restantes = partie->relances_restantes - 1;
+    return true;
+}
+
+/**
+ * @fn int valider_combinaison(t_partie *partie, int combinaison)
+ * 
+ * @brief Cette fonction marque les points des dés dans une combinaison et passe au joueur suivant
+ * 
+ * @param partie Le contexte de la partie
+ * @param combinaison L'indice de la combinaison à valider / barrer
+ * @return int les points marqués, -1 si la combinaison n'existe pas ou est déjà remplie
+ */
+int valider_combinaison(t_partie *partie, int combinaison) {
+    int points;
+
+    if (combinaison < 0 || combinaison >= 13 || partie->feuilles.cases[combinaison][partie->joueur] != -1) {
+        return -1;
+    }
+
+    points = TABLE_POINTS[indice_main(partie->des)].points[combinaison];
+    partie->feuilles.cases[combinaison][partie->joueur] = points;
+    partie->feuilles.etats[partie->joueur] = ajouter_points(partie->feuilles.etats[partie->joueur], combinaison, points);
+
+    partie->relances_restantes = 0;
+    partie->joueur = partie->joueur + 1;
+    if (partie->joueur == partie->nombre_joueurs) {
+        partie->joueur = 0;
+        partie->tour = partie->tour + 1;
+    }
+
+    return points;
+}
+
+/**
+ * @fn bool partie_terminee(t_partie *partie)
+ * 
+ * @brief Cette fonction indique si la partie est terminée
+ * 
+ * @param partie Le contexte de la partie
+ * @return true si les 13 tours ont été joués par tous les joueurs
+ * @return false sinon
+ */
+bool partie_terminee(t_partie *partie) {
+    return partie->tour >= 13;
+}
@@ -0,0 +1,416 @@
+/**
+ * @file yams_regles.h
+ * @author LAMBERT Chloé
+ * @brief Bibliothèque des règles du YAMS, sans entrée / sortie ni état global modifiable
+ * @version 0.1
+ * @date 2021-11-28
+ * 
+ * @copyright Copyright (c) 2021
+ *
+ * Cette bibliothèque regroupe les règles du jeu (combinaisons, points, vainqueur), le générateur de dés, les
+ * tables précalculées des mains et des gardes et le déroulement d'une partie dans un contexte t_partie.
+ * Les tables sont construites une fois par initialiser_regles et ne sont plus modifiées ensuite, les fonctions
+ * sont donc réentrantes et n'allouent aucune mémoire.
+ * 
+ * Compilation de la bibliothèque statique :
+ * gcc -O2 -c yams_regles.c && ar rcs libyams_regles.a yams_regles.o
+ * 
+ * Compilation d'une variante, par exemple 6 dés à 8 faces (voir VARIANTE DES RÈGLES) :
+ * gcc -O2 -DNOMBRE_DES=6 -DNOMBRE_FACES=8 -c yams_regles.c
+ * 
+ */
+#ifndef YAMS_REGLES_H
+#define YAMS_REGLES_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*********************************
+ *     VARIANTE DES RÈGLES       *
+ *********************************/
+
+/**
+ * @brief Raccourci associé au nombre de dés présents dans le jeu
+ * 
+ * Comme NOMBRE_FACES et les points des figures, il peut être changé à la compilation pour jouer une variante,
+ * par exemple le Maxi Yams à 6 dés : gcc -DNOMBRE_DES=6 ... Toutes les tailles de tables et toutes les bornes de
+ * boucles s'en déduisent à la compilation, chaque variante est donc aussi rapide que le jeu classique.
+ * Les tables et les journaux écrits par une variante ne sont pas lisibles par une autre.
+ * 
+ */
+#ifndef NOMBRE_DES
+#define NOMBRE_DES 5
+#endif
+
+/**
+ * @brief Raccourci associé au nombre de faces de chaque dé, numérotées de 1 à NOMBRE_FACES
+ * 
+ * La feuille garde ses 13 combinaisons : la partie supérieure compte toujours les faces 1 à 6, les faces
+ * suivantes ne comptant que dans les figures et la chance
+ * 
+ */
+#ifndef NOMBRE_FACES
+#define NOMBRE_FACES 6
+#endif
+
+#if NOMBRE_DES < 5 || NOMBRE_DES > 7
+#error "NOMBRE_DES doit valoir de 5 à 7"
+#endif
+#if NOMBRE_FACES < 6 || NOMBRE_FACES > 8
+#error "NOMBRE_FACES doit valoir de 6 à 8"
+#endif
+
+/**
+ * @brief Raccourcis associés aux points des figures à valeur fixe
+ * 
+ */
+#ifndef POINTS_FULL
+#define POINTS_FULL 25
+#endif
+#ifndef POINTS_PETITE_SUITE
+#define POINTS_PETITE_SUITE 30
+#endif
+#ifndef POINTS_GRANDE_SUITE
+#define POINTS_GRANDE_SUITE 40
+#endif
+#ifndef POINTS_YAMS
+#define POINTS_YAMS 50
+#endif
+
+/* Les points d'une combinaison tiennent dans un octet de t_ligne_points, les totaux dans t_etat_joueur */
+#if POINTS_FULL < 0 || POINTS_PETITE_SUITE < 0 || POINTS_GRANDE_SUITE < 0 || POINTS_YAMS < 0
+#error "Les points des figures ne peuvent pas être négatifs"
+#endif
+#if POINTS_FULL > 255 || POINTS_PETITE_SUITE > 255 || POINTS_GRANDE_SUITE > 255 || POINTS_YAMS > 255 \
+    || NOMBRE_DES * NOMBRE_FACES > 255
+#error "Les points d'une combinaison doivent tenir sur 8 bits"
+#endif
+#if 21 * NOMBRE_DES > 255
+#error "Le total de la partie supérieure doit tenir sur 8 bits"
+#endif
+#if 3 * NOMBRE_DES * NOMBRE_FACES + POINTS_FULL + POINTS_PETITE_SUITE + POINTS_GRANDE_SUITE + POINTS_YAMS > 511
+#error "Le total de la partie inférieure doit tenir sur 9 bits"
+#endif
+
+/**
+ * @brief Raccourcis associés au nombre de faces qui se suivent dans une petite et dans une grande suite
+ * 
+ */
+#define LONGUEUR_PETITE_SUITE 4
+#define LONGUEUR_GRANDE_SUITE 5
+
+/**
+ * @brief Raccourci associé à la variante classique, 5 dés à 6 faces avec les points habituels
+ * 
+ */
+#define VARIANTE_CLASSIQUE (NOMBRE_DES == 5 && NOMBRE_FACES == 6 && POINTS_FULL == 25 && POINTS_PETITE_SUITE == 30 \
+                            && POINTS_GRANDE_SUITE == 40 && POINTS_YAMS == 50)
+
+/**
+ * @brief Raccourcis associés au nombre de façons de garder ses dés et au masque de tous les dés
+ * 
+ */
+#define NOMBRE_MASQUES (1 << NOMBRE_DES)
+#define MASQUE_DES (NOMBRE_MASQUES - 1)
+
+/**
+ * @brief Raccourci associé au nombre maximal de points d'une combinaison, chance ou figure la mieux payée
+ * 
+ */
+#define POINTS_COMBINAISON_MAX (NOMBRE_DES * NOMBRE_FACES > POINTS_YAMS ? NOMBRE_DES * NOMBRE_FACES : POINTS_YAMS)
+
+/**
+ * @brief Calcule à la compilation base puissance exposant, pour un exposant de 0 à 10
+ * 
+ */
+#define PUISSANCE(base, exposant) \
+    (((exposant) > 0 ? (base) : 1) * ((exposant) > 1 ? (base) : 1) * ((exposant) > 2 ? (base) : 1) \
+     * ((exposant) > 3 ? (base) : 1) * ((exposant) > 4 ? (base) : 1) * ((exposant) > 5 ? (base) : 1) \
+     * ((exposant) > 6 ? (base) : 1) * ((exposant) > 7 ? (base) : 1) * ((exposant) > 8 ? (base) : 1) \
+     * ((exposant) > 9 ? (base) : 1))
+
+/**
+ * @brief Calcule à la compilation le coefficient binomial de n et k, pour k de 0 à 7
+ * 
+ * Chaque produit partiel n (n - 1) ... (n - i + 1) / i! est entier, les divisions successives sont donc exactes
+ * 
+ */
+#define BINOMIAL(n, k) \
+    ((((((((1 * ((k) > 0 ? (n) : 1) / 1) * ((k) > 1 ? (n) - 1 : 1) / ((k) > 1 ? 2 : 1)) \
+          * ((k) > 2 ? (n) - 2 : 1) / ((k) > 2 ? 3 : 1)) * ((k) > 3 ? (n) - 3 : 1) / ((k) > 3 ? 4 : 1)) \
+        * ((k) > 4 ? (n) - 4 : 1) / ((k) > 4 ? 5 : 1)) * ((k) > 5 ? (n) - 5 : 1) / ((k) > 5 ? 6 : 1)) \
+      * ((k) > 6 ? (n) - 6 : 1) / ((k) > 6 ? 7 : 1)))
+
+/**
+ * @brief Demande au compilateur de dérouler entièrement une boucle sur les dés ou sur les faces
+ * 
+ * Le compte de #pragma GCC unroll n'est pas développé par le préprocesseur : 8 couvre toutes les variantes
+ * 
+ */
+#define DEROULER _Pragma("GCC unroll 8")
+
+/**
+ * @brief Raccourci associé au nombre de joueurs par défaut d'une partie interactive
+ * 
+ */
+#define NOMBRE_JOUEURS 2
+
+/**
+ * @brief Représente les dés que le joueur va lancer
+ * 
+ */
+typedef int t_des[NOMBRE_DES];
+
+/**
+ * @brief Représente le tableau de score
+ * 
+ * Ce tableau va permettre le stockage des scores marqués par les joueurs, à savoir les 13 combinaisons possibles
+ * 
+ */
+typedef int t_score[13];
+
+/**
+ * @brief Représente l'état résumé de la feuille d'un joueur, tenu dans un seul mot de 64 bits
+ * 
+ * Bits  0 à  5 : le total de la partie supérieure, plafonné à 63 (le bonus est acquis au-delà de 62)
+ * Bits  6 à 18 : le masque des combinaisons remplies, le bit 6 + i correspond à la combinaison i
+ * Bits 19 à 26 : le total exact de la partie supérieure, sans le bonus
+ * Bits 27 à 35 : le total de la partie inférieure
+ * 
+ * Les 19 bits de poids faible sont exactement l'indice de l'état dans la table du solveur. L'état est mis à jour
+ * à chaque case remplie par ajouter_points, sans relire la feuille, et deux états se comparent avec ==.
+ * Un état vide vaut 0.
+ * 
+ */
+typedef uint64_t t_etat_joueur;
+
+#define ETAT_SUP_PLAFONNE(etat) ((int) ((etat) & 63))
+#define ETAT_MASQUE(etat) ((int) (((etat) >> 6) & 0x1FFF))
+#define ETAT_TOTAL_SUP(etat) ((int) (((etat) >> 19) & 0xFF))
+#define ETAT_TOTAL_INF(etat) ((int) (((etat) >> 27) & 0x1FF))
+#define ETAT_BONUS(etat) (ETAT_TOTAL_SUP(etat) > 62 ? 35 : 0)
+#define ETAT_TOTAL(etat) (ETAT_TOTAL_SUP(etat) + ETAT_BONUS(etat) + ETAT_TOTAL_INF(etat))
+#define ETAT_CLE_SOLVEUR(etat) ((int) ((etat) & 0x7FFFF))
+
+/**
+ * @brief Représente les feuilles de score de tous les joueurs d'une partie, rangées par colonnes
+ * 
+ * cases[c][j] contient les points du joueur j dans la combinaison c, -1 si la case est vide. Chaque combinaison
+ * occupe un tableau contigu de nombre_joueurs cases : les totaux et la recherche du vainqueur parcourent ces
+ * tableaux d'un bout à l'autre, ce que le compilateur vectorise quel que soit le nombre de joueurs.
+ * La mémoire des cases est fournie par l'appelant, TAILLE_FEUILLES(nombre_joueurs) entiers, ainsi que celle des
+ * états résumés etats[j], un par joueur, tenus à jour à chaque case remplie.
+ * 
+ */
+typedef struct {
+    int nombre_joueurs;
+    int *cases[13];
+    t_etat_joueur *etats;
+} t_feuilles;
+
+/**
+ * @brief Raccourci associé au nombre d'entiers occupés par les feuilles de score d'une partie
+ * 
+ */
+#define TAILLE_FEUILLES(nombre_joueurs) (13 * (size_t) (nombre_joueurs))
+
+/**
+ * @brief Raccourci associé au nombre de relances autorisées après le premier lancer d'un tour
+ * 
+ */
+#define NOMBRE_RELANCES 3
+
+/**
+ * @brief Raccourci associé au nombre de mains différentes, c'est à dire de multi-ensembles de NOMBRE_DES dés,
+ * 252 pour 5 dés à 6 faces
+ * 
+ */
+#define NOMBRE_MAINS BINOMIAL(NOMBRE_DES + NOMBRE_FACES - 1, NOMBRE_DES)
+
+/**
+ * @brief Raccourci associé au nombre de lancers ordonnés des dés (7776, 6 puissance 5, pour 5 dés à 6
+ * faces)
+ * 
+ */
+#define NOMBRE_LANCERS PUISSANCE(NOMBRE_FACES, NOMBRE_DES)
+
+/**
+ * @brief Représente une ligne de la table des points, pour une main donnée
+ * 
+ * La ligne contient les points des 13 combinaisons et le masque des combinaisons réalisées par la main
+ * (le bit i correspond à la combinaison i, comme dans combinaisons_possibles). Elle occupe 16 octets,
+ * soit 4 lignes par ligne de cache.
+ * 
+ */
+typedef struct {
+    uint8_t points[13];
+    uint8_t nombre_combinaisons;
+    uint16_t combinaisons;
+} t_ligne_points;
+
+/**
+ * @brief Raccourci associé au nombre de gardes différentes, c'est à dire de multi-ensembles de 0 à NOMBRE_DES
+ * dés, 462 pour 5 dés à 6 faces
+ * 
+ */
+#define NOMBRE_GARDES BINOMIAL(NOMBRE_DES + NOMBRE_FACES, NOMBRE_DES)
+
+/**
+ * @brief Raccourci associé au nombre de transitions des gardes vers les mains, voir TRANSITIONS, 4368 pour 5 dés à
+ * 6 faces
+ * 
+ */
+#define NOMBRE_TRANSITIONS BINOMIAL(NOMBRE_DES + 2 * NOMBRE_FACES - 1, NOMBRE_DES)
+
+/**
+ * @brief Représente une transition d'une garde vers une main, quand les dés qui ne sont pas gardés sont relancés
+ * 
+ */
+typedef struct {
+    double probabilite;
+    int main;
+} t_transition;
+
+/**
+ * @brief Raccourci associé au nombre d'histogrammes dont chaque face compte de 0 à NOMBRE_DES dés,
+ * 46656 (6 puissance 6) pour 5 dés à 6 faces
+ * 
+ */
+#define NOMBRE_HISTOGRAMMES PUISSANCE(NOMBRE_DES + 1, NOMBRE_FACES)
+
+/**
+ * @brief Représente un lot de mains rangé par colonnes, pour le calcul des points par lots
+ * 
+ * des[i][k] est la face du dé i de la main k et points[c][k] reçoit les points de la combinaison c pour la main k.
+ * Cette disposition permet de charger d'un coup le même dé de 16 ou 32 mains dans un registre vectoriel.
+ * 
+ */
+typedef struct {
+    size_t nombre;
+    uint8_t *des[NOMBRE_DES];
+    uint8_t *points[13];
+} t_lot_mains;
+
+/**
+ * @brief Raccourci associé au nombre de faces tirées dans chaque moitié de 32 bits d'un tirage
+ * 
+ */
+#define FACES_PAR_TIRAGE 10
+
+/**
+ * @brief Représente un générateur de dés xoshiro256**, à utiliser par un seul thread à la fois
+ * 
+ * Les faces sont tirées par paquets de FACES_PAR_TIRAGE dans chaque moitié de 32 bits d'un tirage, et gardées
+ * en réserve jusqu'à leur utilisation
+ * 
+ */
+typedef struct {
+    uint64_t etat[4];
+    uint8_t reserve[2 * FACES_PAR_TIRAGE];
+    int nombre_reserve;
+} t_generateur;
+
+/**
+ * @brief Représente une partie en cours, avec tout son état
+ * 
+ * Toutes les fonctions de la bibliothèque travaillent sur le contexte qui leur est passé, sans état global
+ * modifiable : des milliers de parties peuvent se dérouler en même temps dans autant de threads, chacune avec
+ * son propre contexte et son propre générateur de dés.
+ * 
+ */
+typedef struct {
+    int nombre_joueurs;
+    int joueur;
+    int tour;
+    int relances_restantes;
+    t_des des;
+    t_feuilles feuilles;
+    t_generateur generateur;
+} t_partie;
+
+/**
+ * @brief Représente les 13 combinaisons possibles du jeu
+ * 
+ * Ce tableau permet de stocker les 13 combinaisons jouables associées à leur noms
+ * 
+ */
+extern const char NOMS_COMBINAISONS[13][13];
+
+/*********************************
+ *     TABLES PRÉCALCULÉES       *
+ *********************************/
+
+extern t_des MAINS[NOMBRE_MAINS];
+extern int LANCERS_PAR_MAIN[NOMBRE_MAINS];
+extern uint16_t INDICE_PAR_LANCER[NOMBRE_LANCERS];
+extern t_ligne_points TABLE_POINTS[NOMBRE_MAINS];
+extern uint8_t GARDES[NOMBRE_GARDES][NOMBRE_FACES];
+extern uint8_t TAILLE_GARDE[NOMBRE_GARDES];
+extern int16_t GARDE_PLUS_FACE[NOMBRE_GARDES][NOMBRE_FACES];
+extern int16_t MAIN_PAR_GARDE[NOMBRE_GARDES];
+extern int16_t GARDES_PAR_MAIN[NOMBRE_MAINS][NOMBRE_MASQUES];
+extern uint8_t NOMBRE_GARDES_PAR_MAIN[NOMBRE_MAINS];
+extern int16_t INDICE_PAR_HISTOGRAMME[NOMBRE_HISTOGRAMMES];
+extern int POIDS_FACE[NOMBRE_FACES + 1];
+extern int32_t DEBUT_TRANSITIONS[NOMBRE_GARDES + 1];
+extern t_transition TRANSITIONS[NOMBRE_TRANSITIONS];
+extern double PROBABILITES_MAIN[NOMBRE_RELANCES + 1][NOMBRE_MAINS][13];
+extern double PROBABILITES_GARDE[NOMBRE_RELANCES + 1][NOMBRE_GARDES][13];
+extern int16_t GARDE_VISEE[NOMBRE_RELANCES + 1][NOMBRE_MAINS][13];
+
+/*********************************
+ *    FONCTIONS ET PROcÉDURES    *
+ *********************************/
+
+void initialiser_generateur(t_generateur *generateur, uint64_t graine);
+uint64_t tirer_64(t_generateur *generateur);
+void sauter_generateur(t_generateur *generateur);
+void initialiser_flux(t_generateur *generateur, uint64_t graine, long flux);
+int tirer_face(t_generateur *generateur);
+void tirer_faces(t_generateur *generateur, uint8_t *faces, size_t nombre);
+
+void compter_des(t_des des, int occurences[NOMBRE_FACES]);
+void trier_des(t_des des, t_des resultat);
+bool full_house(t_des des);
+bool brelan(t_des des);
+bool carre(t_des des);
+bool petite_suite(t_des des);
+bool grande_suite(t_des des);
+bool yams(t_des des);
+int compter_points(int combinaison, t_des des);
+void initialiser_feuilles(t_feuilles *feuilles, int nombre_joueurs, int *cases, t_etat_joueur *etats);
+void lire_feuille(const t_feuilles *feuilles, int joueur, t_score feuille);
+void calculer_totaux(const t_feuilles *feuilles, int *totaux);
+int trouver_vainqueurs(const t_feuilles *feuilles, int *totaux);
+t_etat_joueur ajouter_points(t_etat_joueur etat, int combinaison, int points);
+t_etat_joueur resumer_feuille(t_score scores);
+uint64_t hacher_etat(t_etat_joueur etat);
+void entrer_points(t_score scores, t_etat_joueur *etat, int combinaison, int points);
+void combinaisons_possibles(t_des des, int combinaisons[13], int *nombre_combinaisons);
+void lancer_des(int nombre, t_des des, t_generateur *generateur);
+void relancer_des(int masque, t_des des, t_generateur *generateur);
+int calculer_total(t_score scores);
+
+int code_lancer(t_des des);
+int indice_main(t_des des);
+int code_histogramme(t_des des, int masque);
+void probabilites_combinaisons(t_des des, int masque, int relances, double probabilites[13]);
+void distribuer_mains(t_des des, int masque, int relances, int objectif, double distribution[NOMBRE_MAINS]);
+
+void points_lot_scalaire(t_lot_mains *lot, size_t debut);
+#if defined(__x86_64__) || defined(__i386__)
+void points_lot_sse2(t_lot_mains *lot, size_t debut);
+void points_lot_avx2(t_lot_mains *lot, size_t debut);
+#endif
+const char *choisir_points_lot(void);
+void compter_points_lot(t_lot_mains *lot);
+
+void initialiser_regles(void);
+void initialiser_partie(t_partie *partie, int nombre_joueurs, int *cases, t_etat_joueur *etats);
+void commencer_tour(t_partie *partie);
+bool relancer_tour(t_partie *partie, int masque);
+int valider_combinaison(t_partie *partie, int combinaison);
+bool partie_terminee(t_partie *partie);
+
+#endif
@@ -0,0 +1,91 @@
+/**
+ * @file yams_strategie.h
+ * @author LAMBERT Chloé
+ * @brief Interface binaire des stratégies chargées depuis une bibliothèque partagée
+ * @version 0.1
+ * @date 2021-11-28
+ * 
+ * @copyright Copyright (c) 2021
+ * 
+ * Une stratégie externe est une bibliothèque partagée qui exporte la fonction yams_strategie, de type
+ * t_point_entree_strategie, renvoyant la description de ses décisions. Le moteur la charge avec dlopen quand le
+ * nom d'une stratégie contient un « / » ou se termine par « .so », par exemple :
+ * YAMS simuler 1000000 42 ./mon_robot.so
+ * 
+ * Ce fichier ne dépend d'aucun autre fichier du programme et n'utilise que des types de taille fixe : une
+ * stratégie compilée pour une version de l'interface reste utilisable sans recompiler le moteur, tant que
+ * VERSION_MODULE_STRATEGIE ne change pas.
+ * 
+ * Compilation d'une stratégie :
+ * gcc -O2 -shared -fPIC mon_robot.c -o mon_robot.so
+ * 
+ */
+#ifndef YAMS_STRATEGIE_H
+#define YAMS_STRATEGIE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Raccourci associé à la version de l'interface, vérifiée au chargement de chaque stratégie
+ * 
+ */
+#define VERSION_MODULE_STRATEGIE 1
+
+/**
+ * @brief Raccourci associé au nom de la fonction exportée par chaque stratégie
+ * 
+ */
+#define SYMBOLE_MODULE_STRATEGIE "yams_strategie"
+
+/**
+ * @brief Représente la partie telle que la voit une stratégie au moment d'une décision, en lecture seule
+ * 
+ * des contient les 5 dés de 1 à 6, scores la feuille du joueur au début du tour (-1 pour une case vide) et
+ * relances_restantes le nombre de relances encore possibles, 0 au moment du choix de la combinaison.
+ * etat est la feuille résumée sur 64 bits décrite dans yams_regles.h (t_etat_joueur), pour les stratégies qui
+ * indexent leurs tables par état.
+ * 
+ */
+typedef struct {
+    int32_t des[5];
+    int32_t scores[13];
+    int32_t relances_restantes;
+    int32_t reserve;
+    uint64_t etat;
+} t_vue_partie;
+
+/**
+ * @brief Représente les décisions d'une stratégie externe
+ * 
+ * choisir_relance renvoie le masque des dés à relancer (le bit i désigne le dé i, 0 pour garder tous les dés et
+ * finir le tour) et choisir_combinaison l'indice de 0 à 12 de la combinaison à valider ou à barrer, dans l'ordre de
+ * la feuille. Une combinaison déjà remplie est remplacée par la première case libre.
+ * 
+ * Les versions par lots, facultatives (NULL si absentes), reçoivent nombre vues de parties indépendantes et
+ * écrivent une décision par vue : la stratégie peut ainsi partager ses accès à ses tables entre les parties ou
+ * vectoriser ses calculs. Le moteur ne les appelle qu'avec des vues dans le même tour et au même nombre de
+ * relances restantes.
+ * 
+ * creer, facultative, est appelée pour chaque instance de la stratégie et renvoie les données passées à toutes les
+ * décisions de cette instance, libérées par detruire, ou NULL si elle échoue. Une instance n'est utilisée que par
+ * un thread à la fois.
+ * 
+ */
+typedef struct {
+    uint32_t version;
+    void *(*creer)(void);
+    void (*detruire)(void *donnees);
+    int32_t (*choisir_relance)(void *donnees, const t_vue_partie *vue);
+    int32_t (*choisir_combinaison)(void *donnees, const t_vue_partie *vue);
+    void (*choisir_relances)(void *donnees, const t_vue_partie *vues, int32_t *masques, size_t nombre);
+    void (*choisir_combinaisons)(void *donnees, const t_vue_partie *vues, int32_t *combinaisons, size_t nombre);
+} t_module_strategie;
+
+/**
+ * @brief Représente la fonction exportée par une stratégie externe sous le nom SYMBOLE_MODULE_STRATEGIE
+ * 
+ */
+typedef const t_module_strategie *(*t_point_entree_strategie)(void);
+
+#endif